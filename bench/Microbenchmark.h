@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/**
+ * \brief Keeps the compiler from optimizing away a value computed inside a benchmark
+ */
+template <typename T>
+inline void DoNotOptimize(const T& Value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(Value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &Value;
+    _ReadWriteBarrier();
+#endif
+}
+
+/**
+ * \brief Timing statistics of one benchmark, all in nanoseconds per iteration
+ */
+struct MicrobenchmarkResult
+{
+    std::string Name;
+    std::string SkipReason;
+    uint64_t IterationsPerSample{0};
+    std::vector<double> Samples;
+
+    double Median{0.0};
+    double Mean{0.0};
+    double StdDev{0.0};
+    double Min{0.0};
+    double Max{0.0};
+    // median absolute deviation, scaled to estimate the standard deviation of normally distributed samples
+    double Mad{0.0};
+    // distribution-free 95% confidence interval of the median
+    double MedianLow{0.0};
+    double MedianHigh{0.0};
+    // samples more than 3 scaled MADs from the median
+    uint32_t Outliers{0};
+};
+
+/**
+ * \brief Minimal microbenchmark runner.
+ *
+ * Each benchmark body is called as Body(Iterations) and must run its operation Iterations times. The runner first
+ * doubles the iteration count until one call takes MinSampleSeconds (these calls double as warmup), then times Samples
+ * calls at that count. Statistics are computed on the per-iteration time of each sample; the median and its
+ * order-statistic confidence interval are robust to the occasional preempted sample.
+ */
+class MicrobenchmarkRunner
+{
+public:
+    struct Options
+    {
+        uint32_t Samples{30};
+        uint32_t MinSamples{5};
+        double MinSampleSeconds{0.01};
+        // a benchmark stops sampling early (after MinSamples) once it has run this long
+        double MaxSecondsPerBenchmark{5.0};
+        const char* Filter{nullptr};
+        bool bListOnly{false};
+    };
+
+    explicit MicrobenchmarkRunner(const Options& RunOptions) : m_Options(RunOptions) {}
+
+    template <typename Function>
+    void Run(const char* Name, Function&& Body)
+    {
+        if (!IsSelected(Name))
+            return;
+        if (m_Options.bListOnly)
+        {
+            printf("%s\n", Name);
+            return;
+        }
+
+        MicrobenchmarkResult result;
+        result.Name = Name;
+
+        uint64_t iterations = 1;
+        double seconds = TimeCall(Body, iterations);
+        double elapsed = seconds;
+        while (seconds < m_Options.MinSampleSeconds && iterations < (1ull << 40))
+        {
+            // jump close to the target once a measurable time is reached, instead of doubling all the way
+            const double scale = seconds > 1e-6 ? std::clamp(m_Options.MinSampleSeconds * 1.2 / seconds, 2.0, 100.0) : 100.0;
+            iterations = static_cast<uint64_t>(std::ceil(static_cast<double>(iterations) * scale));
+            seconds = TimeCall(Body, iterations);
+            elapsed += seconds;
+        }
+        result.IterationsPerSample = iterations;
+
+        const double budgetStart = elapsed;
+        for (uint32_t sample = 0; sample < m_Options.Samples; sample++)
+        {
+            seconds = TimeCall(Body, iterations);
+            elapsed += seconds;
+            result.Samples.push_back(seconds * 1e9 / static_cast<double>(iterations));
+            if (sample + 1 >= m_Options.MinSamples && elapsed - budgetStart > m_Options.MaxSecondsPerBenchmark)
+                break;
+        }
+
+        ComputeStatistics(result);
+        fprintf(stderr, "%-44s %14.1f ns  [%.1f, %.1f]  +-%.1f%%  (%zu x %llu)\n", Name, result.Median, result.MedianLow,
+                result.MedianHigh, result.Median > 0.0 ? 100.0 * result.Mad / result.Median : 0.0, result.Samples.size(),
+                static_cast<unsigned long long>(iterations));
+        m_Results.push_back(std::move(result));
+    }
+
+    /**
+     * \brief Records that a selected benchmark could not run, e.g. because there is no GL context
+     */
+    void Skip(const char* Name, const char* Reason)
+    {
+        if (!IsSelected(Name))
+            return;
+        if (m_Options.bListOnly)
+        {
+            printf("%s\n", Name);
+            return;
+        }
+        MicrobenchmarkResult result;
+        result.Name = Name;
+        result.SkipReason = Reason;
+        fprintf(stderr, "%-44s skipped: %s\n", Name, Reason);
+        m_Results.push_back(std::move(result));
+    }
+
+    [[nodiscard]] bool IsListOnly() const { return m_Options.bListOnly; }
+
+    [[nodiscard]] bool IsSelected(const char* Name) const { return !m_Options.Filter || strstr(Name, m_Options.Filter); }
+
+    /**
+     * \brief Writes every result as JSON; Context is emitted verbatim as the "context" object
+     */
+    void WriteJson(FILE* File, const char* Context) const
+    {
+        fprintf(File, "{\n  \"context\": %s,\n  \"benchmarks\": [", Context);
+        for (size_t i = 0; i < m_Results.size(); i++)
+        {
+            const MicrobenchmarkResult& result = m_Results[i];
+            fprintf(File, "%s\n    {\"name\": \"%s\", ", i ? "," : "", EscapeJson(result.Name.c_str()).c_str());
+            if (!result.SkipReason.empty())
+            {
+                fprintf(File, "\"skipped\": \"%s\"}", EscapeJson(result.SkipReason.c_str()).c_str());
+                continue;
+            }
+            fprintf(File,
+                    "\"unit\": \"ns\", \"iterations_per_sample\": %llu, \"samples\": %zu, \"median\": %.3f, "
+                    "\"median_ci95\": [%.3f, %.3f], \"mean\": %.3f, \"stddev\": %.3f, \"mad\": %.3f, \"min\": %.3f, "
+                    "\"max\": %.3f, \"outliers\": %u, \"sample_values\": [",
+                    static_cast<unsigned long long>(result.IterationsPerSample), result.Samples.size(), result.Median,
+                    result.MedianLow, result.MedianHigh, result.Mean, result.StdDev, result.Mad, result.Min, result.Max,
+                    result.Outliers);
+            for (size_t sample = 0; sample < result.Samples.size(); sample++)
+                fprintf(File, "%s%.3f", sample ? ", " : "", result.Samples[sample]);
+            fputs("]}", File);
+        }
+        fputs("\n  ]\n}\n", File);
+    }
+
+    /**
+     * \brief Value as the contents of a JSON string: quotes and backslashes escaped, control characters as \\u escapes
+     */
+    static std::string EscapeJson(const char* Value)
+    {
+        std::string result;
+        for (const char* c = Value; *c; c++)
+        {
+            if (*c == '"' || *c == '\\')
+                result += '\\';
+            if (static_cast<unsigned char>(*c) < 0x20)
+            {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(*c)));
+                result += escaped;
+            }
+            else
+            {
+                result += *c;
+            }
+        }
+        return result;
+    }
+
+private:
+    template <typename Function>
+    static double TimeCall(Function& Body, const uint64_t Iterations)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        Body(Iterations);
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    static void ComputeStatistics(MicrobenchmarkResult& Result)
+    {
+        std::vector<double> sorted = Result.Samples;
+        std::sort(sorted.begin(), sorted.end());
+        const size_t count = sorted.size();
+
+        const auto median = [](const std::vector<double>& Values)
+        {
+            const size_t half = Values.size() / 2;
+            return Values.size() % 2 ? Values[half] : 0.5 * (Values[half - 1] + Values[half]);
+        };
+
+        double sum = 0.0;
+        for (const double value : sorted)
+            sum += value;
+        Result.Mean = sum / static_cast<double>(count);
+        double squares = 0.0;
+        for (const double value : sorted)
+            squares += (value - Result.Mean) * (value - Result.Mean);
+        Result.StdDev = count > 1 ? std::sqrt(squares / static_cast<double>(count - 1)) : 0.0;
+        Result.Min = sorted.front();
+        Result.Max = sorted.back();
+        Result.Median = median(sorted);
+
+        std::vector<double> deviations(count);
+        for (size_t i = 0; i < count; i++)
+            deviations[i] = std::abs(sorted[i] - Result.Median);
+        std::sort(deviations.begin(), deviations.end());
+        Result.Mad = 1.4826 * median(deviations);
+
+        // ranks n/2 -+ 0.98 sqrt(n) bound the median with ~95% confidence for any distribution (normal approximation
+        // of the binomial); with few samples this widens to the extremes
+        const double spread = 0.98 * std::sqrt(static_cast<double>(count));
+        const double half = static_cast<double>(count) / 2.0;
+        const size_t low = static_cast<size_t>(std::max(0.0, std::floor(half - spread)));
+        const size_t high = static_cast<size_t>(std::min(static_cast<double>(count - 1), std::ceil(half + spread)));
+        Result.MedianLow = sorted[low];
+        Result.MedianHigh = sorted[high];
+
+        Result.Outliers = 0;
+        for (const double value : sorted)
+        {
+            if (Result.Mad > 0.0 && std::abs(value - Result.Median) > 3.0 * Result.Mad)
+                Result.Outliers++;
+        }
+    }
+
+    Options m_Options;
+    std::vector<MicrobenchmarkResult> m_Results;
+};
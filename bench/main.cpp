@@ -0,0 +1,1083 @@
+#include "Microbenchmark.h"
+
+#include "Benchmark.h"
+#include "Camera.h"
+#include "DataGrid.h"
+#include "LogViewer.h"
+#include "Mesh.h"
+#include "Shader.h"
+#include "TextMatcher.h"
+#include "TextSizeCache.h"
+
+#include "glad/glad.h"
+
+#include "GLFW/glfw3.h"
+#include "glm/glm.hpp"
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "implot/implot.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * \brief Command line of the microbenchmark executable:
+ * --filter <substring>, --samples <n>, --min-sample-ms <ms>, --max-seconds <s> (per benchmark), --out <json>, --list
+ */
+static MicrobenchmarkRunner::Options ParseOptions(const int argc, char** argv, const char*& OutPath)
+{
+    MicrobenchmarkRunner::Options options;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+            options.Filter = argv[++i];
+        else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc)
+            options.Samples = std::max(1u, static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10)));
+        else if (strcmp(argv[i], "--min-sample-ms") == 0 && i + 1 < argc)
+            options.MinSampleSeconds = atof(argv[++i]) / 1000.0;
+        else if (strcmp(argv[i], "--max-seconds") == 0 && i + 1 < argc)
+            options.MaxSecondsPerBenchmark = atof(argv[++i]);
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            OutPath = argv[++i];
+        else if (strcmp(argv[i], "--list") == 0)
+            options.bListOnly = true;
+    }
+    options.MinSamples = std::min(options.MinSamples, options.Samples);
+    return options;
+}
+
+/**
+ * \brief Creates a hidden window with a 3.3 core context, falling back to an offscreen context on GLFW's null platform.
+ * Returns nullptr when neither is available; the GL benchmarks are then reported as skipped.
+ */
+static GLFWwindow* CreateBenchmarkContext()
+{
+    const auto createWindow = []() -> GLFWwindow*
+    {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        return glfwCreateWindow(64, 64, "CrossPlatformGUI_bench", nullptr, nullptr);
+    };
+
+    GLFWwindow* window = nullptr;
+    if (glfwInit())
+    {
+        window = createWindow();
+        if (!window)
+            glfwTerminate();
+    }
+    if (!window)
+    {
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+        if (!glfwInit())
+            return nullptr;
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        if (SelectHeadlessContextApi())
+            window = createWindow();
+    }
+    if (!window)
+        return nullptr;
+
+    glfwMakeContextCurrent(window);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        glfwDestroyWindow(window);
+        return nullptr;
+    }
+    return window;
+}
+
+static void AppendBigEndian(std::vector<unsigned char>& Out, const uint32_t Value)
+{
+    for (int shift = 24; shift >= 0; shift -= 8)
+        Out.push_back(static_cast<unsigned char>(Value >> shift));
+}
+
+static uint32_t Crc32(const unsigned char* Data, const size_t Size)
+{
+    static uint32_t table[256];
+    if (!table[1])
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++)
+                crc = crc & 1 ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+            table[i] = crc;
+        }
+    }
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < Size; i++)
+        crc = table[(crc ^ Data[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/**
+ * \brief Synthetic RGB image: a gradient with enough per-pixel variation that no decoder takes a shortcut on it
+ */
+static std::vector<unsigned char> GenerateImage(const int Width, const int Height)
+{
+    std::vector<unsigned char> pixels(static_cast<size_t>(Width) * Height * 3);
+    uint32_t noise = 12345;
+    for (size_t i = 0; i < pixels.size(); i += 3)
+    {
+        noise = noise * 1664525u + 1013904223u;
+        const size_t pixel = i / 3;
+        pixels[i + 0] = static_cast<unsigned char>((pixel % Width) * 255 / Width + (noise >> 28));
+        pixels[i + 1] = static_cast<unsigned char>((pixel / Width) * 255 / Height + (noise >> 24 & 15));
+        pixels[i + 2] = static_cast<unsigned char>(noise >> 16);
+    }
+    return pixels;
+}
+
+/**
+ * \brief Encodes RGB pixels as a PNG with stored (uncompressed) deflate blocks, so no encoder dependency is needed
+ * while decoding still goes through stb_image's zlib and unfiltering paths
+ */
+static std::vector<unsigned char> EncodeStoredPng(const std::vector<unsigned char>& Pixels, const int Width, const int Height)
+{
+    std::vector<unsigned char> raw;
+    raw.reserve(static_cast<size_t>(Height) * (Width * 3 + 1));
+    for (int y = 0; y < Height; y++)
+    {
+        raw.push_back(0); // filter: none
+        raw.insert(raw.end(), Pixels.begin() + static_cast<size_t>(y) * Width * 3, Pixels.begin() + static_cast<size_t>(y + 1) * Width * 3);
+    }
+
+    std::vector<unsigned char> zlib = {0x78, 0x01};
+    uint32_t adlerA = 1, adlerB = 0;
+    for (size_t offset = 0; offset < raw.size(); offset += 65535)
+    {
+        const uint16_t length = static_cast<uint16_t>(std::min<size_t>(65535, raw.size() - offset));
+        zlib.push_back(offset + length == raw.size() ? 1 : 0);
+        zlib.push_back(static_cast<unsigned char>(length));
+        zlib.push_back(static_cast<unsigned char>(length >> 8));
+        zlib.push_back(static_cast<unsigned char>(~length));
+        zlib.push_back(static_cast<unsigned char>(~length >> 8));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+        for (size_t i = offset; i < offset + length; i++)
+        {
+            adlerA = (adlerA + raw[i]) % 65521;
+            adlerB = (adlerB + adlerA) % 65521;
+        }
+    }
+    AppendBigEndian(zlib, adlerB << 16 | adlerA);
+
+    std::vector<unsigned char> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    const auto appendChunk = [&png](const char* Type, const std::vector<unsigned char>& Data)
+    {
+        AppendBigEndian(png, static_cast<uint32_t>(Data.size()));
+        const size_t typeOffset = png.size();
+        png.insert(png.end(), Type, Type + 4);
+        png.insert(png.end(), Data.begin(), Data.end());
+        AppendBigEndian(png, Crc32(png.data() + typeOffset, png.size() - typeOffset));
+    };
+
+    std::vector<unsigned char> header;
+    AppendBigEndian(header, static_cast<uint32_t>(Width));
+    AppendBigEndian(header, static_cast<uint32_t>(Height));
+    header.insert(header.end(), {8, 2, 0, 0, 0}); // 8-bit RGB, no interlacing
+    appendChunk("IHDR", header);
+    appendChunk("IDAT", zlib);
+    appendChunk("IEND", {});
+    return png;
+}
+
+static std::vector<unsigned char> EncodePpm(const std::vector<unsigned char>& Pixels, const int Width, const int Height)
+{
+    const std::string header = "P6\n" + std::to_string(Width) + " " + std::to_string(Height) + "\n255\n";
+    std::vector<unsigned char> ppm(header.begin(), header.end());
+    ppm.insert(ppm.end(), Pixels.begin(), Pixels.end());
+    return ppm;
+}
+
+static bool WriteFile(const std::filesystem::path& Path, const std::vector<unsigned char>& Data)
+{
+    std::ofstream file(Path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(Data.data()), static_cast<std::streamsize>(Data.size()));
+    return static_cast<bool>(file);
+}
+
+static void RunImageBenchmarks(MicrobenchmarkRunner& Runner)
+{
+    const auto loadImage = [](const char* Path)
+    {
+        return [Path](const uint64_t Iterations)
+        {
+            for (uint64_t i = 0; i < Iterations; i++)
+            {
+                int width, height, channels;
+                unsigned char* pixels = stbi_load(Path, &width, &height, &channels, 0);
+                DoNotOptimize(pixels);
+                stbi_image_free(pixels);
+            }
+        };
+    };
+
+    const char* containerPath = "data/textures/container.jpg";
+    if (std::filesystem::exists(containerPath))
+        Runner.Run("stbi_load/container.jpg", loadImage(containerPath));
+    else
+        Runner.Skip("stbi_load/container.jpg", "data/textures/container.jpg not found (run from the build directory)");
+
+    if (!Runner.IsSelected("stbi_load/synthetic"))
+        return;
+
+    // written once, so the timed loads read from the page cache like the bundled asset does
+    const std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const int sizes[] = {2048, 4096};
+    for (const int size : sizes)
+    {
+        const std::vector<unsigned char> pixels = Runner.IsListOnly() ? std::vector<unsigned char>() : GenerateImage(size, size);
+        const std::string suffix = std::to_string(size) + "x" + std::to_string(size);
+        const std::filesystem::path pngPath = directory / ("cpgui_bench_" + suffix + ".png");
+        const std::filesystem::path ppmPath = directory / ("cpgui_bench_" + suffix + ".ppm");
+        const std::string pngName = "stbi_load/synthetic " + suffix + " png";
+        const std::string ppmName = "stbi_load/synthetic " + suffix + " ppm";
+
+        const std::string pngFile = pngPath.string();
+        const std::string ppmFile = ppmPath.string();
+        if (Runner.IsListOnly())
+        {
+            Runner.Skip(pngName.c_str(), "");
+            Runner.Skip(ppmName.c_str(), "");
+            continue;
+        }
+        if (WriteFile(pngPath, EncodeStoredPng(pixels, size, size)))
+            Runner.Run(pngName.c_str(), loadImage(pngFile.c_str()));
+        else
+            Runner.Skip(pngName.c_str(), "could not write the synthetic image");
+        if (WriteFile(ppmPath, EncodePpm(pixels, size, size)))
+            Runner.Run(ppmName.c_str(), loadImage(ppmFile.c_str()));
+        else
+            Runner.Skip(ppmName.c_str(), "could not write the synthetic image");
+
+        std::error_code error;
+        std::filesystem::remove(pngPath, error);
+        std::filesystem::remove(ppmPath, error);
+    }
+}
+
+static void RunCameraBenchmarks(MicrobenchmarkRunner& Runner)
+{
+    Camera camera;
+    Runner.Run("Camera/SetYawPitch+GetViewMatrix",
+               [&camera](const uint64_t Iterations)
+               {
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       camera.SetYawPitch(static_cast<float>(i % 360), static_cast<float>(i % 90) - 45.0f);
+                       DoNotOptimize(camera.GetViewMatrix());
+                   }
+               });
+    Runner.Run("Camera/UpdatePerspectiveProjectionMatrix",
+               [&camera](const uint64_t Iterations)
+               {
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       camera.UpdatePerspectiveProjectionMatrix(1920 + static_cast<uint32_t>(i & 1), 1080);
+                       DoNotOptimize(camera.GetPerspectiveProjectionMatrix());
+                   }
+               });
+    Runner.Run("Camera/GetFrustum after move",
+               [&camera](const uint64_t Iterations)
+               {
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       camera.SetPosition(glm::vec3(static_cast<float>(i & 7), 0.0f, 0.0f));
+                       DoNotOptimize(camera.GetFrustum());
+                   }
+               });
+}
+
+static void RunGLBenchmarks(MicrobenchmarkRunner& Runner, const bool bHasContext)
+{
+    const char* names[] = {"Mesh/construct+upload", "Shader/SetMat4", "Shader/SetInt"};
+    if (!bHasContext)
+    {
+        for (const char* name : names)
+            Runner.Skip(name, "no OpenGL context");
+        return;
+    }
+
+    // glFinish() makes the driver's deferred work part of the measurement instead of the next sample's
+    Runner.Run(names[0],
+               [](const uint64_t Iterations)
+               {
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       Mesh mesh;
+                       DoNotOptimize(mesh);
+                   }
+                   glFinish();
+               });
+
+    if (!std::filesystem::exists("data/shaders/default.vert"))
+    {
+        Runner.Skip(names[1], "data/shaders not found (run from the build directory)");
+        Runner.Skip(names[2], "data/shaders not found (run from the build directory)");
+        return;
+    }
+    Shader shader("data/shaders/default.vert", "data/shaders/default.frag");
+    shader.Bind();
+    Runner.Run(names[1],
+               [&shader](const uint64_t Iterations)
+               {
+                   glm::mat4 matrix(1.0f);
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       matrix[3][0] = static_cast<float>(i & 15);
+                       shader.SetMat4("model", matrix);
+                   }
+                   glFinish();
+               });
+    Runner.Run(names[2],
+               [&shader](const uint64_t Iterations)
+               {
+                   for (uint64_t i = 0; i < Iterations; i++)
+                       shader.SetInt("texture1", static_cast<int>(i & 1));
+                   glFinish();
+               });
+}
+
+/**
+ * \brief UI benchmarks run on the CPU side only: ImGui::Render() produces draw lists without a renderer backend
+ */
+static void RunUIBenchmarks(MicrobenchmarkRunner& Runner)
+{
+    ImGui::CreateContext();
+    ImPlot::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = ImVec2(1920.0f, 1080.0f);
+    io.DeltaTime = 1.0f / 60.0f;
+    if (std::filesystem::exists("data/fonts/Ruda/Ruda-Bold.ttf"))
+        io.Fonts->AddFontFromFileTTF("data/fonts/Ruda/Ruda-Bold.ttf", 16);
+    unsigned char* fontPixels;
+    int fontWidth, fontHeight;
+    io.Fonts->GetTexDataAsRGBA32(&fontPixels, &fontWidth, &fontHeight);
+
+    // one frame so the demo window lays itself out before it is timed
+    ImGui::NewFrame();
+    ImGui::ShowDemoWindow();
+    ImGui::Render();
+
+    Runner.Run("ImGui/NewFrame+Render demo window",
+               [](const uint64_t Iterations)
+               {
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       ImGui::NewFrame();
+                       ImGui::ShowDemoWindow();
+                       ImGui::Render();
+                       DoNotOptimize(ImGui::GetDrawData()->TotalVtxCount);
+                   }
+               });
+
+    std::vector<ImVec2> polyline(10000);
+    for (size_t i = 0; i < polyline.size(); i++)
+    {
+        const float t = static_cast<float>(i) / static_cast<float>(polyline.size());
+        polyline[i] = ImVec2(10.0f + t * 1900.0f, 540.0f + 400.0f * std::sin(t * 200.0f));
+    }
+    struct PolylineCase
+    {
+        const char* Name;
+        float Thickness;
+        ImDrawListFlags Flags;
+    };
+    const PolylineCase polylineCases[] = {
+        {"ImDrawList/AddPolyline 10k AA 1px", 1.0f, ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex},
+        {"ImDrawList/AddPolyline 10k AA 3px", 3.0f, ImDrawListFlags_AntiAliasedLines},
+        {"ImDrawList/AddPolyline 10k no AA 3px", 3.0f, ImDrawListFlags_None},
+    };
+    ImDrawList drawList(ImGui::GetDrawListSharedData());
+    for (const PolylineCase& polylineCase : polylineCases)
+    {
+        Runner.Run(polylineCase.Name,
+                   [&](const uint64_t Iterations)
+                   {
+                       for (uint64_t i = 0; i < Iterations; i++)
+                       {
+                           drawList._ResetForNewFrame();
+                           drawList.Flags = polylineCase.Flags;
+                           drawList.PushClipRectFullScreen();
+                           drawList.PushTextureID(io.Fonts->TexID);
+                           drawList.AddPolyline(polyline.data(), static_cast<int>(polyline.size()), IM_COL32_WHITE, ImDrawFlags_None,
+                                                polylineCase.Thickness);
+                           DoNotOptimize(drawList.VtxBuffer.Size);
+                       }
+                   });
+    }
+    drawList._ClearFreeMemory();
+
+    std::vector<float> plotValues(1000000);
+    for (size_t i = 0; i < plotValues.size(); i++)
+        plotValues[i] = std::sin(static_cast<float>(i) * 0.001f) + 0.1f * std::sin(static_cast<float>(i) * 0.37f);
+    const auto plotFrame = [&plotValues](const int Count)
+    {
+        return [&plotValues, Count](const uint64_t Iterations)
+        {
+            for (uint64_t i = 0; i < Iterations; i++)
+            {
+                ImGui::NewFrame();
+                ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+                ImGui::SetNextWindowSize(ImVec2(1200.0f, 800.0f));
+                ImGui::Begin("Plot");
+                if (ImPlot::BeginPlot("Signal", ImVec2(-1.0f, -1.0f)))
+                {
+                    if (Count > 0)
+                        ImPlot::PlotLine("signal", plotValues.data(), Count);
+                    ImPlot::EndPlot();
+                }
+                ImGui::End();
+                ImGui::Render();
+                DoNotOptimize(ImGui::GetDrawData()->TotalVtxCount);
+            }
+        };
+    };
+    // the empty plot is the frame overhead to subtract from the 1M-point case
+    Runner.Run("ImPlot/frame with empty plot", plotFrame(0));
+    Runner.Run("ImPlot/PlotLine 1M points", plotFrame(static_cast<int>(plotValues.size())));
+
+    // every row is submitted (no clipper), so each frame measures 30k labels: the text size cache case
+    std::vector<std::string> tableLabels;
+    tableLabels.reserve(30000);
+    for (int row = 0; row < 10000; row++)
+    {
+        tableLabels.push_back("Row " + std::to_string(row));
+        tableLabels.push_back("Entity_" + std::to_string(row * 7919 % 100000) + " transform");
+        tableLabels.push_back(std::to_string(row * 0.25) + " ms");
+    }
+    TextSizeCache textSizeCache;
+    const auto tableFrame = [&tableLabels, &textSizeCache](const uint64_t Iterations)
+    {
+        for (uint64_t i = 0; i < Iterations; i++)
+        {
+            textSizeCache.NewFrame();
+            ImGui::NewFrame();
+            ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+            ImGui::SetNextWindowSize(ImVec2(1200.0f, 800.0f));
+            ImGui::Begin("Table");
+            if (ImGui::BeginTable("Rows", 3, ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg))
+            {
+                for (size_t label = 0; label < tableLabels.size(); label++)
+                {
+                    if (label % 3 == 0)
+                        ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(tableLabels[label].c_str());
+                }
+                ImGui::EndTable();
+            }
+            ImGui::End();
+            ImGui::Render();
+            DoNotOptimize(ImGui::GetDrawData()->TotalVtxCount);
+        }
+    };
+    Runner.Run("ImGui/10k-row table, CalcTextSize uncached", tableFrame);
+    textSizeCache.Attach(io.Fonts);
+    Runner.Run("ImGui/10k-row table, CalcTextSize cached", tableFrame);
+    textSizeCache.Detach(io.Fonts);
+
+    // wrapped text is measured by the slow word-wrapping path on every frame, which is where caching pays
+    std::vector<std::string> paragraphs;
+    for (int paragraph = 0; paragraph < 400; paragraph++)
+    {
+        std::string text = "Paragraph " + std::to_string(paragraph) + ":";
+        for (int word = 0; word < 40; word++)
+            text += " word" + std::to_string((paragraph * 31 + word * 17) % 997);
+        paragraphs.push_back(std::move(text));
+    }
+    const auto wrappedFrame = [&paragraphs, &textSizeCache](const uint64_t Iterations)
+    {
+        for (uint64_t i = 0; i < Iterations; i++)
+        {
+            textSizeCache.NewFrame();
+            ImGui::NewFrame();
+            ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+            ImGui::SetNextWindowSize(ImVec2(600.0f, 800.0f));
+            ImGui::Begin("Wrapped");
+            for (const std::string& paragraph : paragraphs)
+                ImGui::TextWrapped("%s", paragraph.c_str());
+            ImGui::End();
+            ImGui::Render();
+            DoNotOptimize(ImGui::GetDrawData()->TotalVtxCount);
+        }
+    };
+    Runner.Run("ImGui/400 wrapped paragraphs, CalcTextSize uncached", wrappedFrame);
+    textSizeCache.Attach(io.Fonts);
+    Runner.Run("ImGui/400 wrapped paragraphs, CalcTextSize cached", wrappedFrame);
+    textSizeCache.Detach(io.Fonts);
+
+    // every node's open state lives in the window's ImGuiStorage: 20k keys looked up per frame
+    Runner.Run("ImGui/20k tree nodes",
+               [](const uint64_t Iterations)
+               {
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       ImGui::NewFrame();
+                       ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+                       ImGui::SetNextWindowSize(ImVec2(600.0f, 800.0f));
+                       ImGui::Begin("Tree");
+                       for (int node = 0; node < 20000; node++)
+                       {
+                           ImGui::SetNextItemOpen(node % 2 == 0, ImGuiCond_Once);
+                           if (ImGui::TreeNode(reinterpret_cast<void*>(static_cast<intptr_t>(node)), "Node %d", node))
+                               ImGui::TreePop();
+                       }
+                       ImGui::End();
+                       ImGui::Render();
+                       DoNotOptimize(ImGui::GetDrawData()->TotalVtxCount);
+                   }
+               });
+
+    // every label is hashed into an ID every frame, visible or not
+    std::vector<std::string> widgetLabels;
+    widgetLabels.reserve(50000);
+    for (int widget = 0; widget < 50000; widget++)
+        widgetLabels.push_back((widget % 2 ? "Enabled##entity_" : "Select entity ") + std::to_string(widget));
+    std::vector<char> widgetChecks(widgetLabels.size(), 0);
+    Runner.Run("ImGui/50k widgets",
+               [&widgetLabels, &widgetChecks](const uint64_t Iterations)
+               {
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       ImGui::NewFrame();
+                       ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+                       ImGui::SetNextWindowSize(ImVec2(600.0f, 800.0f));
+                       ImGui::Begin("Widgets");
+                       for (size_t widget = 0; widget < widgetLabels.size(); widget++)
+                       {
+                           if (widget % 2)
+                               ImGui::Checkbox(widgetLabels[widget].c_str(), reinterpret_cast<bool*>(&widgetChecks[widget]));
+                           else
+                               ImGui::Button(widgetLabels[widget].c_str());
+                       }
+                       ImGui::End();
+                       ImGui::Render();
+                       DoNotOptimize(ImGui::GetDrawData()->TotalVtxCount);
+                   }
+               });
+    Runner.Run("ImHashStr/50k widget labels",
+               [&widgetLabels](const uint64_t Iterations)
+               {
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       ImGuiID hash = 0;
+                       for (const std::string& label : widgetLabels)
+                           hash ^= ImHashStr(label.c_str(), 0, 0x12345678);
+                       DoNotOptimize(hash);
+                   }
+               });
+
+    // the measuring alone: 30k labels through ImGui's loop and through the ASCII run fast path
+    const ImFont* font = io.Fonts->Fonts[0];
+    Runner.Run("ImFont/CalcTextSizeA 30k labels",
+               [&](const uint64_t Iterations)
+               {
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       for (const std::string& label : tableLabels)
+                           DoNotOptimize(font->CalcTextSizeUncachedA(font->FontSize, FLT_MAX, 0.0f, label.data(), label.data() + label.size()).x);
+                   }
+               });
+    Runner.Run("ImFont/TextSizeCache::Measure 30k labels",
+               [&](const uint64_t Iterations)
+               {
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       for (const std::string& label : tableLabels)
+                           DoNotOptimize(TextSizeCache::Measure(*font, font->FontSize, label.data(), label.data() + label.size()).x);
+                   }
+               });
+
+    ImPlot::DestroyContext();
+    ImGui::DestroyContext();
+}
+
+/**
+ * \brief ImGuiStorage with the backend this build selected (IMGUI_STORAGE_OPEN_ADDRESSING); compare two builds for both backends
+ */
+static void RunStorageBenchmarks(MicrobenchmarkRunner& Runner)
+{
+    struct StorageCase
+    {
+        const char* InsertName;
+        const char* LookupName;
+        uint32_t Keys;
+    };
+    const StorageCase storageCases[] = {
+        {"ImGuiStorage/SetInt 1k new keys", "ImGuiStorage/GetInt 1k keys", 1000},
+        {"ImGuiStorage/SetInt 100k new keys", "ImGuiStorage/GetInt 100k keys", 100000},
+        {"ImGuiStorage/SetInt 1M new keys", "ImGuiStorage/GetInt 1M keys", 1000000},
+    };
+    for (const StorageCase& storageCase : storageCases)
+    {
+        if (!Runner.IsListOnly() && !Runner.IsSelected(storageCase.InsertName) && !Runner.IsSelected(storageCase.LookupName))
+            continue;
+
+        // IDs are hashes, so random keys are what ImGui inserts
+        std::mt19937 random(storageCase.Keys);
+        std::vector<ImGuiID> keys(Runner.IsListOnly() ? 0 : storageCase.Keys);
+        for (ImGuiID& key : keys)
+            key = static_cast<ImGuiID>(random());
+
+#ifndef IMGUI_STORAGE_OPEN_ADDRESSING
+        if (storageCase.Keys > 100000)
+            Runner.Skip(storageCase.InsertName, "the sorted ImGuiStorage needs O(N^2) memmoves for this, i.e. minutes per iteration");
+        else
+#endif
+            Runner.Run(storageCase.InsertName,
+                       [&keys](const uint64_t Iterations)
+                       {
+                           for (uint64_t i = 0; i < Iterations; i++)
+                           {
+                               ImGuiStorage storage;
+                               for (const ImGuiID key : keys)
+                                   storage.SetInt(key, 1);
+                               DoNotOptimize(storage.Data.Size);
+                           }
+                       });
+
+        // bulk-built as the API suggests, then looked up in an order unrelated to the insertion order
+        ImGuiStorage storage;
+        storage.Data.reserve(static_cast<int>(keys.size()));
+        for (size_t key = 0; key < keys.size(); key++)
+            storage.Data.push_back(ImGuiStorage::ImGuiStoragePair(keys[key], static_cast<int>(key)));
+        storage.BuildSortByKey();
+        std::shuffle(keys.begin(), keys.end(), random);
+        Runner.Run(storageCase.LookupName,
+                   [&keys, &storage](const uint64_t Iterations)
+                   {
+                       for (uint64_t i = 0; i < Iterations; i++)
+                       {
+                           int sum = 0;
+                           for (const ImGuiID key : keys)
+                               sum += storage.GetInt(key);
+                           DoNotOptimize(sum);
+                       }
+                   });
+    }
+}
+
+static void RunTextFilterBenchmarks(MicrobenchmarkRunner& Runner)
+{
+    static constexpr const char* NAMES[] = {
+        "ImGuiTextFilter/1M asset paths, ImStristr per term",
+        "ImGuiTextFilter/1M asset paths, PassFilter",
+        "TextMatcher/1M asset paths, substrings",
+        "TextMatcher/1M asset paths, glob",
+    };
+    if (!Runner.IsListOnly() && std::none_of(std::begin(NAMES), std::end(NAMES), [&Runner](const char* Name) { return Runner.IsSelected(Name); }))
+        return;
+
+    static constexpr const char* FOLDERS[] = {"characters", "environment", "props", "vehicles", "effects", "ui"};
+    static constexpr const char* WORDS[] = {"amber", "brisk", "cobalt", "dusty", "falcon", "harbor", "meadow", "beacon", "canyon", "quarry"};
+    static constexpr const char* MAPS[] = {"albedo.png", "normal.png", "roughness.png", "mesh.gltf", "lod1.gltf", "anim.json"};
+    std::mt19937 random(49);
+    std::vector<std::string> paths(Runner.IsListOnly() ? 0 : 1000000);
+    for (std::string& path : paths)
+    {
+        // one draw per statement: the operands of + are evaluated in an unspecified order
+        const char* folder = FOLDERS[random() % 6];
+        const char* firstWord = WORDS[random() % 10];
+        const char* secondWord = WORDS[random() % 10];
+        const std::string id = std::to_string(random() % 1000);
+        const char* map = MAPS[random() % 6];
+        path = std::string("assets/") + folder + "/" + firstWord + "_" + secondWord + "_" + id + "_" + map;
+    }
+
+    // two terms that rarely match, so most paths are scanned completely twice
+    static constexpr const char* FILTER = "quarry_70,Falcon_Amber";
+    ImGuiTextFilter filter(FILTER);
+    Runner.Run(NAMES[0],
+               [&paths, &filter](const uint64_t Iterations)
+               {
+                   // PassFilter() as it was before needles were prepared
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       size_t passed = 0;
+                       for (const std::string& path : paths)
+                       {
+                           for (const ImGuiTextFilter::ImGuiTextRange& range : filter.Filters)
+                           {
+                               if (ImStristr(path.data(), path.data() + path.size(), range.b, range.e))
+                               {
+                                   passed++;
+                                   break;
+                               }
+                           }
+                       }
+                       DoNotOptimize(passed);
+                   }
+               });
+    Runner.Run(NAMES[1],
+               [&paths, &filter](const uint64_t Iterations)
+               {
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       size_t passed = 0;
+                       for (const std::string& path : paths)
+                           passed += filter.PassFilter(path.data(), path.data() + path.size()) ? 1 : 0;
+                       DoNotOptimize(passed);
+                   }
+               });
+
+    const auto matchAll = [&paths](TextMatcher Matcher)
+    {
+        return [&paths, matcher = std::move(Matcher)](const uint64_t Iterations)
+        {
+            for (uint64_t i = 0; i < Iterations; i++)
+            {
+                size_t passed = 0;
+                for (const std::string& path : paths)
+                    passed += matcher.Pass(path) ? 1 : 0;
+                DoNotOptimize(passed);
+            }
+        };
+    };
+    Runner.Run(NAMES[2], matchAll(TextMatcher(FILTER)));
+    Runner.Run(NAMES[3], matchAll(TextMatcher("assets/props/*quarry*normal.png", TextMatcherSyntax::GLOB)));
+}
+
+static void RunDataGridBenchmarks(MicrobenchmarkRunner& Runner)
+{
+    static constexpr const char* NAMES[] = {
+        "DataGrid/sort 1M rows by Value",
+        "DataGrid/sort 1M rows by Category, Value descending",
+        "DataGrid/sort 1M rows by Name",
+        "DataGrid/filter 1M rows by Name",
+        "DataGrid/type \"amber_quarry\" into the filter of 1M rows, full",
+        "DataGrid/type \"amber_quarry\" into the filter of 1M rows, incremental",
+        "DataGrid/std::stable_sort 1M rows by Category, Value descending",
+        "DataGrid/frame with 1M rows",
+    };
+    if (!Runner.IsListOnly() && std::none_of(std::begin(NAMES), std::end(NAMES), [&Runner](const char* Name) { return Runner.IsSelected(Name); }))
+        return;
+
+    JobSystem jobs;
+    const std::shared_ptr<const DataGridTable> table = MakeDemoDataGridTable(jobs, Runner.IsListOnly() ? 0 : 1000000);
+    const auto evaluate = [&jobs, &table](const std::vector<DataGridSortKey>& SortKeys, const char* FilterText)
+    {
+        return [&jobs, query = DataGridQuery{table, SortKeys, FilterText, TextMatcherSyntax::SUBSTRING, 1, nullptr, false}](const uint64_t Iterations)
+        {
+            std::vector<uint32_t> rows;
+            for (uint64_t i = 0; i < Iterations; i++)
+            {
+                DataGrid::Evaluate(jobs, query, rows);
+                DoNotOptimize(rows.data());
+            }
+        };
+    };
+    Runner.Run(NAMES[0], evaluate({{3, false}}, ""));
+    Runner.Run(NAMES[1], evaluate({{2, false}, {3, true}}, ""));
+    Runner.Run(NAMES[2], evaluate({{1, false}}, ""));
+    Runner.Run(NAMES[3], evaluate({}, "falcon,-amber"));
+
+    // one query per keystroke; incrementally, each one only matches the rows the previous one passed
+    const auto typeFilter = [&jobs, &table](const bool bIncremental)
+    {
+        return [&jobs, &table, bIncremental](const uint64_t Iterations)
+        {
+            static constexpr const char* TYPED = "amber_quarry";
+            std::vector<uint32_t> rows;
+            for (uint64_t i = 0; i < Iterations; i++)
+            {
+                std::shared_ptr<const std::vector<uint64_t>> passed;
+                for (size_t length = 1; length <= strlen(TYPED); length++)
+                {
+                    const DataGridQuery query{table, {}, std::string(TYPED, length), TextMatcherSyntax::SUBSTRING, 1,
+                                              bIncremental ? passed : nullptr, false};
+                    std::vector<uint64_t> nextPassed;
+                    DataGrid::Evaluate(jobs, query, rows, &nextPassed);
+                    passed = std::make_shared<const std::vector<uint64_t>>(std::move(nextPassed));
+                }
+                DoNotOptimize(rows.data());
+            }
+        };
+    };
+    Runner.Run(NAMES[4], typeFilter(false));
+    Runner.Run(NAMES[5], typeFilter(true));
+
+    // what sorting on the UI thread would cost
+    Runner.Run(NAMES[6],
+               [&table](const uint64_t Iterations)
+               {
+                   const DataGridColumn& category = table->Columns[2];
+                   const DataGridColumn& value = table->Columns[3];
+                   std::vector<uint32_t> rows(table->RowCount);
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       for (uint32_t row = 0; row < table->RowCount; row++)
+                           rows[row] = row;
+                       std::stable_sort(rows.begin(), rows.end(),
+                                        [&category, &value](const uint32_t A, const uint32_t B)
+                                        {
+                                            const int compare = category.Compare(A, B);
+                                            return compare != 0 ? compare < 0 : value.Compare(A, B) > 0;
+                                        });
+                       DoNotOptimize(rows.data());
+                   }
+               });
+
+    if (Runner.IsListOnly() || Runner.IsSelected(NAMES[7]))
+    {
+        ImGui::CreateContext();
+        ImGuiIO& io = ImGui::GetIO();
+        io.IniFilename = nullptr;
+        io.DisplaySize = ImVec2(1920.0f, 1080.0f);
+        io.DeltaTime = 1.0f / 60.0f;
+        unsigned char* fontPixels;
+        int fontWidth, fontHeight;
+        io.Fonts->GetTexDataAsRGBA32(&fontPixels, &fontWidth, &fontHeight);
+
+        DataGrid grid(jobs);
+        const auto frame = [&grid]()
+        {
+            ImGui::NewFrame();
+            ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+            ImGui::SetNextWindowSize(ImVec2(1200.0f, 800.0f));
+            ImGui::Begin("Data Grid");
+            grid.Draw("Rows");
+            ImGui::End();
+            ImGui::Render();
+        };
+        grid.SetSource(table);
+        while (!Runner.IsListOnly() && (grid.GetStats().bBusy || grid.GetStats().ShownRows != table->RowCount))
+            frame();
+
+        Runner.Run(NAMES[7],
+                   [&frame](const uint64_t Iterations)
+                   {
+                       for (uint64_t i = 0; i < Iterations; i++)
+                       {
+                           frame();
+                           DoNotOptimize(ImGui::GetDrawData()->TotalVtxCount);
+                       }
+                   });
+        ImGui::DestroyContext();
+    }
+}
+
+static void RunLogViewerBenchmarks(MicrobenchmarkRunner& Runner)
+{
+    static constexpr const char* NAMES[] = {
+        "LogViewer/find newlines in 64 MiB, memchr",
+        "LogViewer/find newlines in 64 MiB",
+        "LogViewer/open 256 MiB and read the first screen",
+        "LogViewer/open and index 256 MiB",
+        "LogViewer/search 256 MiB",
+        "LogViewer/type \"timeout after 42\" into the search of 256 MiB",
+    };
+    if (!Runner.IsListOnly() && std::none_of(std::begin(NAMES), std::end(NAMES), [&Runner](const char* Name) { return Runner.IsSelected(Name); }))
+        return;
+
+    static constexpr const char* LEVELS[] = {"DEBUG", "INFO ", "INFO ", "INFO ", "WARN ", "ERROR"};
+    static constexpr const char* EVENTS[] = {"Loaded texture", "Compiled shader", "Request timeout after", "Flushed batch of", "Cache miss for"};
+    static constexpr const char* WORDS[] = {"amber", "brisk", "cobalt", "dusty", "falcon", "harbor", "meadow", "beacon", "canyon", "quarry"};
+    std::mt19937 random(50);
+    std::string text;
+    text.reserve(Runner.IsListOnly() ? 0 : 64u << 20);
+    char line[160];
+    while (!Runner.IsListOnly() && text.size() < (64u << 20))
+    {
+        // one draw per statement: the order arguments are evaluated in is unspecified, and the text must not depend on it
+        const unsigned minute = static_cast<unsigned>(random() % 60);
+        const unsigned second = static_cast<unsigned>(random() % 60);
+        const unsigned millisecond = static_cast<unsigned>(random() % 1000);
+        const unsigned worker = static_cast<unsigned>(random() % 16);
+        const char* level = LEVELS[random() % 6];
+        const char* event = EVENTS[random() % 5];
+        const char* firstWord = WORDS[random() % 10];
+        const char* secondWord = WORDS[random() % 10];
+        const unsigned id = static_cast<unsigned>(random() % 1000);
+        const unsigned whole = static_cast<unsigned>(random() % 100);
+        const unsigned tenths = static_cast<unsigned>(random() % 10);
+        const int length = snprintf(line, sizeof(line), "2024-05-01 12:%02u:%02u.%03u [worker-%u] %s %s %s_%s_%u in %u.%u ms\n", minute,
+                                    second, millisecond, worker, level, event, firstWord, secondWord, id, whole, tenths);
+        text.append(line, static_cast<size_t>(length));
+    }
+
+    Runner.Run(NAMES[0],
+               [&text](const uint64_t Iterations)
+               {
+                   std::vector<uint32_t> newlines;
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       newlines.clear();
+                       for (const char* found = text.data(); (found = static_cast<const char*>(memchr(found, '\n', text.data() + text.size() - found))) != nullptr; found++)
+                           newlines.push_back(static_cast<uint32_t>(found - text.data()));
+                       DoNotOptimize(newlines.data());
+                   }
+               });
+    Runner.Run(NAMES[1],
+               [&text](const uint64_t Iterations)
+               {
+                   std::vector<uint32_t> newlines;
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       newlines.clear();
+                       LogViewer::FindNewlines(text.data(), text.data() + text.size(), newlines);
+                       DoNotOptimize(newlines.data());
+                   }
+               });
+
+    // written once, so the timed runs read from the page cache
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "cpgui_bench.log";
+    const std::string file = path.string();
+    if (Runner.IsListOnly())
+    {
+        for (size_t name = 2; name < std::size(NAMES); name++)
+            Runner.Skip(NAMES[name], "");
+        return;
+    }
+    {
+        std::ofstream out(path, std::ios::binary);
+        for (int copy = 0; copy < 4 && out; copy++)
+            out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        if (!out)
+        {
+            for (size_t name = 2; name < std::size(NAMES); name++)
+                Runner.Skip(NAMES[name], "could not write the synthetic log");
+            return;
+        }
+    }
+
+    JobSystem jobs;
+    const auto settle = [](LogViewer& Viewer)
+    {
+        for (Viewer.Update(); Viewer.GetStats().bIndexing || Viewer.GetStats().bSearching; Viewer.Update())
+            std::this_thread::yield();
+    };
+    Runner.Run(NAMES[2],
+               [&jobs, &file](const uint64_t Iterations)
+               {
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       LogViewer viewer(jobs);
+                       viewer.Open(file);
+                       size_t bytes = 0;
+                       for (uint64_t line = 0; line < 60 && line < viewer.GetLineCount(); line++)
+                           bytes += viewer.GetLine(line).size();
+                       DoNotOptimize(bytes);
+                   }
+               });
+    Runner.Run(NAMES[3],
+               [&jobs, &file, &settle](const uint64_t Iterations)
+               {
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       LogViewer viewer(jobs);
+                       viewer.Open(file);
+                       settle(viewer);
+                       DoNotOptimize(viewer.GetLineCount());
+                   }
+               });
+
+    LogViewer viewer(jobs);
+    viewer.Open(file);
+    settle(viewer);
+    Runner.Run(NAMES[4],
+               [&viewer, &settle](const uint64_t Iterations)
+               {
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       viewer.SetSearch("");
+                       viewer.SetSearch("falcon_quarry_7");
+                       settle(viewer);
+                       DoNotOptimize(viewer.GetStats().HitCount);
+                   }
+               });
+    // a search per keystroke, each finished before the next; the later ones only recheck the lines that matched
+    Runner.Run(NAMES[5],
+               [&viewer, &settle](const uint64_t Iterations)
+               {
+                   static constexpr const char* TYPED = "timeout after 42";
+                   for (uint64_t i = 0; i < Iterations; i++)
+                   {
+                       viewer.SetSearch("");
+                       for (size_t length = 1; length <= strlen(TYPED); length++)
+                       {
+                           viewer.SetSearch(std::string_view(TYPED, length));
+                           settle(viewer);
+                       }
+                       DoNotOptimize(viewer.GetStats().HitCount);
+                   }
+               });
+    viewer.Close();
+
+    std::error_code error;
+    std::filesystem::remove(path, error);
+}
+
+int main(int argc, char** argv)
+{
+    const char* outPath = nullptr;
+    MicrobenchmarkRunner runner(ParseOptions(argc, argv, outPath));
+
+    GLFWwindow* context = runner.IsListOnly() ? nullptr : CreateBenchmarkContext();
+    const char* renderer = context ? reinterpret_cast<const char*>(glGetString(GL_RENDERER)) : "none";
+    const std::string rendererName = MicrobenchmarkRunner::EscapeJson(renderer ? renderer : "unknown");
+
+    RunCameraBenchmarks(runner);
+    RunGLBenchmarks(runner, context != nullptr);
+    RunImageBenchmarks(runner);
+    RunUIBenchmarks(runner);
+    RunStorageBenchmarks(runner);
+    RunTextFilterBenchmarks(runner);
+    RunDataGridBenchmarks(runner);
+    RunLogViewerBenchmarks(runner);
+
+    if (context)
+        glfwDestroyWindow(context);
+    glfwTerminate();
+    if (runner.IsListOnly())
+        return 0;
+
+#ifdef NDEBUG
+    const char* buildType = "release";
+#else
+    const char* buildType = "debug";
+#endif
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    const char* storageBackend = "open-addressing";
+#else
+    const char* storageBackend = "sorted";
+#endif
+    char jsonContext[512];
+    snprintf(jsonContext, sizeof(jsonContext),
+             "{\"executable\": \"CrossPlatformGUI_bench\", \"build\": \"%s\", \"hardware_threads\": %u, \"gl_renderer\": \"%s\", "
+             "\"imgui_version\": \"%s\", \"imgui_storage\": \"%s\", \"imgui_hash\": \"%s\"}",
+             buildType, std::thread::hardware_concurrency(), rendererName.c_str(), IMGUI_VERSION, storageBackend,
+             ImHashGetImplementationName());
+
+    FILE* out = outPath ? fopen(outPath, "wb") : stdout;
+    if (!out)
+    {
+        std::cout << "Failed to open " << outPath << std::endl;
+        return 1;
+    }
+    runner.WriteJson(out, jsonContext);
+    if (out != stdout)
+        fclose(out);
+    return 0;
+}
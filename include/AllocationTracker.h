@@ -0,0 +1,288 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+/**
+ * \brief Subsystem an allocation is attributed to. Each thread has a current tag, set with ScopedMemoryTag.
+ */
+enum class MemoryTag : uint8_t
+{
+    GENERAL,
+    UI,
+    RENDER,
+    JOBS,
+    ASSETS,
+    COUNT
+};
+
+inline const char* GetMemoryTagName(const MemoryTag Tag)
+{
+    static constexpr const char* NAMES[] = {"General", "UI", "Render", "Jobs", "Assets"};
+    return NAMES[static_cast<size_t>(Tag)];
+}
+
+/**
+ * \brief Global allocation statistics per MemoryTag. Fed by the replaced global operator new/delete (see
+ * ALLOCATION_TRACKER_IMPLEMENTATION below) and by the ImGui allocator hooks of PoolAllocator.
+ *
+ * Counters are lock-free and safe to update from any thread. BeginFrame()/EndFrame() and the frame history must only be
+ * used from the main thread.
+ */
+class AllocationTracker
+{
+public:
+    static constexpr size_t TAG_COUNT = static_cast<size_t>(MemoryTag::COUNT);
+    static constexpr size_t HISTORY_SIZE = 240;
+
+    struct TagTotals
+    {
+        uint64_t Allocations{0};
+        uint64_t Frees{0};
+        uint64_t AllocatedBytes{0};
+        int64_t LiveBytes{0};
+        int64_t PeakLiveBytes{0};
+    };
+
+    /**
+     * \brief Allocations made between a BeginFrame()/EndFrame() pair, on every thread
+     */
+    struct FrameSample
+    {
+        std::array<double, TAG_COUNT> Allocations{};
+        std::array<double, TAG_COUNT> Bytes{};
+        uint64_t TotalAllocations{0};
+        uint64_t TotalBytes{0};
+    };
+
+    static MemoryTag GetCurrentTag() { return s_CurrentTag; }
+
+    static void SetCurrentTag(const MemoryTag Tag) { s_CurrentTag = Tag; }
+
+    static void RecordAllocation(const MemoryTag Tag, const size_t Size)
+    {
+        Counters& counters = s_Counters[static_cast<size_t>(Tag)];
+        counters.Allocations.fetch_add(1, std::memory_order_relaxed);
+        counters.AllocatedBytes.fetch_add(Size, std::memory_order_relaxed);
+
+        const int64_t live = counters.LiveBytes.fetch_add(static_cast<int64_t>(Size), std::memory_order_relaxed) + static_cast<int64_t>(Size);
+        int64_t peak = counters.PeakLiveBytes.load(std::memory_order_relaxed);
+        while (live > peak && !counters.PeakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    static void RecordFree(const MemoryTag Tag, const size_t Size)
+    {
+        Counters& counters = s_Counters[static_cast<size_t>(Tag)];
+        counters.Frees.fetch_add(1, std::memory_order_relaxed);
+        counters.LiveBytes.fetch_sub(static_cast<int64_t>(Size), std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static TagTotals GetTotals(const MemoryTag Tag)
+    {
+        const Counters& counters = s_Counters[static_cast<size_t>(Tag)];
+        TagTotals totals;
+        totals.Allocations = counters.Allocations.load(std::memory_order_relaxed);
+        totals.Frees = counters.Frees.load(std::memory_order_relaxed);
+        totals.AllocatedBytes = counters.AllocatedBytes.load(std::memory_order_relaxed);
+        totals.LiveBytes = counters.LiveBytes.load(std::memory_order_relaxed);
+        totals.PeakLiveBytes = counters.PeakLiveBytes.load(std::memory_order_relaxed);
+        return totals;
+    }
+
+    static void BeginFrame()
+    {
+        for (size_t tag = 0; tag < TAG_COUNT; tag++)
+        {
+            s_FrameStartAllocations[tag] = s_Counters[tag].Allocations.load(std::memory_order_relaxed);
+            s_FrameStartBytes[tag] = s_Counters[tag].AllocatedBytes.load(std::memory_order_relaxed);
+        }
+    }
+
+    static const FrameSample& EndFrame()
+    {
+        FrameSample& sample = s_History[s_HistoryHead];
+        sample = FrameSample();
+        for (size_t tag = 0; tag < TAG_COUNT; tag++)
+        {
+            const uint64_t allocations = s_Counters[tag].Allocations.load(std::memory_order_relaxed) - s_FrameStartAllocations[tag];
+            const uint64_t bytes = s_Counters[tag].AllocatedBytes.load(std::memory_order_relaxed) - s_FrameStartBytes[tag];
+            sample.Allocations[tag] = static_cast<double>(allocations);
+            sample.Bytes[tag] = static_cast<double>(bytes);
+            sample.TotalAllocations += allocations;
+            sample.TotalBytes += bytes;
+        }
+
+        s_HistoryHead = (s_HistoryHead + 1) % HISTORY_SIZE;
+        s_HistoryCount = s_HistoryCount < HISTORY_SIZE ? s_HistoryCount + 1 : HISTORY_SIZE;
+        return sample;
+    }
+
+    /**
+     * \brief Ring of the last HISTORY_SIZE frames; the oldest entry is at GetHistoryOffset()
+     */
+    [[nodiscard]] static const std::array<FrameSample, HISTORY_SIZE>& GetHistory() { return s_History; }
+
+    [[nodiscard]] static size_t GetHistoryCount() { return s_HistoryCount; }
+
+    [[nodiscard]] static size_t GetHistoryOffset() { return s_HistoryCount < HISTORY_SIZE ? 0 : s_HistoryHead; }
+
+    [[nodiscard]] static const FrameSample& GetLastFrame() { return s_History[(s_HistoryHead + HISTORY_SIZE - 1) % HISTORY_SIZE]; }
+
+    /**
+     * \brief Allocation used by the replaced global operator new. The header records size and tag so that frees are
+     * attributed to the subsystem that allocated, whichever thread releases the memory.
+     */
+    static void* TrackedAllocate(const size_t Size, const size_t Alignment)
+    {
+        const size_t alignment = Alignment < alignof(Header) ? alignof(Header) : Alignment;
+        void* raw = std::malloc(Size + sizeof(Header) + alignment - alignof(Header));
+        if (!raw)
+            return nullptr;
+
+        const uintptr_t user = (reinterpret_cast<uintptr_t>(raw) + sizeof(Header) + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+        Header* header = reinterpret_cast<Header*>(user) - 1;
+        header->Size = Size;
+        header->Tag = static_cast<uint32_t>(s_CurrentTag);
+        header->Offset = static_cast<uint32_t>(user - reinterpret_cast<uintptr_t>(raw));
+        RecordAllocation(s_CurrentTag, Size);
+        return reinterpret_cast<void*>(user);
+    }
+
+    static void TrackedFree(void* Pointer)
+    {
+        if (!Pointer)
+            return;
+
+        const Header* header = static_cast<Header*>(Pointer) - 1;
+        RecordFree(static_cast<MemoryTag>(header->Tag), header->Size);
+        std::free(static_cast<std::byte*>(Pointer) - header->Offset);
+    }
+
+private:
+    struct alignas(16) Header
+    {
+        uint64_t Size;
+        uint32_t Tag;
+        uint32_t Offset;
+    };
+
+    struct Counters
+    {
+        std::atomic<uint64_t> Allocations{0};
+        std::atomic<uint64_t> Frees{0};
+        std::atomic<uint64_t> AllocatedBytes{0};
+        std::atomic<int64_t> LiveBytes{0};
+        std::atomic<int64_t> PeakLiveBytes{0};
+    };
+
+    static Counters s_Counters[TAG_COUNT];
+    static thread_local MemoryTag s_CurrentTag;
+
+    static uint64_t s_FrameStartAllocations[TAG_COUNT];
+    static uint64_t s_FrameStartBytes[TAG_COUNT];
+    static std::array<FrameSample, HISTORY_SIZE> s_History;
+    static size_t s_HistoryHead;
+    static size_t s_HistoryCount;
+};
+
+// constant-initialized, so operator new may use them before any dynamic initialization has run
+inline AllocationTracker::Counters AllocationTracker::s_Counters[TAG_COUNT];
+inline thread_local MemoryTag AllocationTracker::s_CurrentTag{MemoryTag::GENERAL};
+inline uint64_t AllocationTracker::s_FrameStartAllocations[TAG_COUNT]{};
+inline uint64_t AllocationTracker::s_FrameStartBytes[TAG_COUNT]{};
+inline std::array<AllocationTracker::FrameSample, AllocationTracker::HISTORY_SIZE> AllocationTracker::s_History{};
+inline size_t AllocationTracker::s_HistoryHead{0};
+inline size_t AllocationTracker::s_HistoryCount{0};
+
+/**
+ * \brief Attributes allocations made on this thread to Tag until the end of the scope.
+ * Must not span a co_await, as the coroutine may resume on another thread.
+ */
+class ScopedMemoryTag
+{
+public:
+    explicit ScopedMemoryTag(const MemoryTag Tag) : m_Previous(AllocationTracker::GetCurrentTag())
+    {
+        AllocationTracker::SetCurrentTag(Tag);
+    }
+
+    ~ScopedMemoryTag()
+    {
+        AllocationTracker::SetCurrentTag(m_Previous);
+    }
+
+    ScopedMemoryTag(const ScopedMemoryTag&) = delete;
+    ScopedMemoryTag& operator=(const ScopedMemoryTag&) = delete;
+
+private:
+    MemoryTag m_Previous;
+};
+
+// Define in exactly one translation unit, like STB_IMAGE_IMPLEMENTATION, to route every operator new/delete of the
+// program through AllocationTracker. Memory obtained with malloc directly (GLFW, stb_image, the engine pools) is not seen.
+#ifdef ALLOCATION_TRACKER_IMPLEMENTATION
+
+void* operator new(const size_t Size)
+{
+    if (void* pointer = AllocationTracker::TrackedAllocate(Size, alignof(std::max_align_t)))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](const size_t Size)
+{
+    return operator new(Size);
+}
+
+void* operator new(const size_t Size, const std::align_val_t Alignment)
+{
+    if (void* pointer = AllocationTracker::TrackedAllocate(Size, static_cast<size_t>(Alignment)))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new[](const size_t Size, const std::align_val_t Alignment)
+{
+    return operator new(Size, Alignment);
+}
+
+void* operator new(const size_t Size, const std::nothrow_t&) noexcept
+{
+    return AllocationTracker::TrackedAllocate(Size, alignof(std::max_align_t));
+}
+
+void* operator new[](const size_t Size, const std::nothrow_t&) noexcept
+{
+    return AllocationTracker::TrackedAllocate(Size, alignof(std::max_align_t));
+}
+
+void* operator new(const size_t Size, const std::align_val_t Alignment, const std::nothrow_t&) noexcept
+{
+    return AllocationTracker::TrackedAllocate(Size, static_cast<size_t>(Alignment));
+}
+
+void* operator new[](const size_t Size, const std::align_val_t Alignment, const std::nothrow_t&) noexcept
+{
+    return AllocationTracker::TrackedAllocate(Size, static_cast<size_t>(Alignment));
+}
+
+void operator delete(void* Pointer) noexcept { AllocationTracker::TrackedFree(Pointer); }
+void operator delete[](void* Pointer) noexcept { AllocationTracker::TrackedFree(Pointer); }
+void operator delete(void* Pointer, size_t) noexcept { AllocationTracker::TrackedFree(Pointer); }
+void operator delete[](void* Pointer, size_t) noexcept { AllocationTracker::TrackedFree(Pointer); }
+void operator delete(void* Pointer, std::align_val_t) noexcept { AllocationTracker::TrackedFree(Pointer); }
+void operator delete[](void* Pointer, std::align_val_t) noexcept { AllocationTracker::TrackedFree(Pointer); }
+void operator delete(void* Pointer, size_t, std::align_val_t) noexcept { AllocationTracker::TrackedFree(Pointer); }
+void operator delete[](void* Pointer, size_t, std::align_val_t) noexcept { AllocationTracker::TrackedFree(Pointer); }
+void operator delete(void* Pointer, const std::nothrow_t&) noexcept { AllocationTracker::TrackedFree(Pointer); }
+void operator delete[](void* Pointer, const std::nothrow_t&) noexcept { AllocationTracker::TrackedFree(Pointer); }
+void operator delete(void* Pointer, std::align_val_t, const std::nothrow_t&) noexcept { AllocationTracker::TrackedFree(Pointer); }
+void operator delete[](void* Pointer, std::align_val_t, const std::nothrow_t&) noexcept { AllocationTracker::TrackedFree(Pointer); }
+
+#endif
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "AllocationTracker.h"
+#include "Allocators.h"
+
+#include "imgui.h"
+#include "implot/implot.h"
+
+#include <cstdio>
+
+/**
+ * \brief ImGui window showing per-subsystem heap usage from AllocationTracker and the state of the UI pool allocator
+ */
+class AllocationTrackerPanel
+{
+public:
+    explicit AllocationTrackerPanel(const PoolAllocator* UIAllocator = nullptr) : m_UIAllocator(UIAllocator) {}
+
+    void Render()
+    {
+        ImGui::Begin("Memory");
+
+        const AllocationTracker::FrameSample& lastFrame = AllocationTracker::GetLastFrame();
+        ImGui::Text("Last frame: %llu allocations, %s", static_cast<unsigned long long>(lastFrame.TotalAllocations),
+                    FormatBytes(static_cast<double>(lastFrame.TotalBytes)));
+
+        if (ImGui::BeginTable("Tags", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+        {
+            ImGui::TableSetupColumn("Tag");
+            ImGui::TableSetupColumn("Live");
+            ImGui::TableSetupColumn("Peak");
+            ImGui::TableSetupColumn("Allocs/frame");
+            ImGui::TableSetupColumn("Bytes/frame");
+            ImGui::TableSetupColumn("Total allocs");
+            ImGui::TableHeadersRow();
+
+            for (size_t tag = 0; tag < AllocationTracker::TAG_COUNT; tag++)
+            {
+                const AllocationTracker::TagTotals totals = AllocationTracker::GetTotals(static_cast<MemoryTag>(tag));
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(GetMemoryTagName(static_cast<MemoryTag>(tag)));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(FormatBytes(static_cast<double>(totals.LiveBytes)));
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(FormatBytes(static_cast<double>(totals.PeakLiveBytes)));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.0f", lastFrame.Allocations[tag]);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(FormatBytes(lastFrame.Bytes[tag]));
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(totals.Allocations));
+            }
+            ImGui::EndTable();
+        }
+
+        const auto& history = AllocationTracker::GetHistory();
+        const int count = static_cast<int>(AllocationTracker::GetHistoryCount());
+        const int offset = static_cast<int>(AllocationTracker::GetHistoryOffset());
+        if (count > 0 && ImPlot::BeginPlot("Allocations per frame", ImVec2(-1, 200)))
+        {
+            ImPlot::SetupAxes("frame", "allocations", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+            for (size_t tag = 0; tag < AllocationTracker::TAG_COUNT; tag++)
+            {
+                ImPlot::PlotLine(GetMemoryTagName(static_cast<MemoryTag>(tag)), &history[0].Allocations[tag], count, 1.0, 0.0, 0,
+                                 offset, sizeof(AllocationTracker::FrameSample));
+            }
+            ImPlot::EndPlot();
+        }
+
+        if (m_UIAllocator && ImGui::CollapsingHeader("UI pool allocator"))
+        {
+            ImGui::Text("%zu slabs of %zu KiB, %zu large allocations", m_UIAllocator->GetSlabCount(),
+                        PoolAllocator::SLAB_SIZE / 1024, m_UIAllocator->GetLargeAllocationCount());
+            for (size_t sizeClass = 0; sizeClass < PoolAllocator::CLASS_COUNT; sizeClass++)
+            {
+                const PoolAllocator::ClassStats stats = m_UIAllocator->GetClassStats(sizeClass);
+                ImGui::Text("%5zu B: %6zu live, %6zu free", stats.BlockSize, stats.LiveBlocks, stats.FreeBlocks);
+            }
+        }
+
+        ImGui::End();
+    }
+
+private:
+    const char* FormatBytes(const double Bytes)
+    {
+        // shared buffer: each result is consumed by ImGui before the next call
+        if (Bytes >= 1024.0 * 1024.0)
+            snprintf(m_FormatBuffer, sizeof(m_FormatBuffer), "%.2f MiB", Bytes / (1024.0 * 1024.0));
+        else if (Bytes >= 1024.0)
+            snprintf(m_FormatBuffer, sizeof(m_FormatBuffer), "%.1f KiB", Bytes / 1024.0);
+        else
+            snprintf(m_FormatBuffer, sizeof(m_FormatBuffer), "%.0f B", Bytes);
+        return m_FormatBuffer;
+    }
+
+    const PoolAllocator* m_UIAllocator;
+    char m_FormatBuffer[32]{};
+};
@@ -0,0 +1,384 @@
+#pragma once
+
+#include "AllocationTracker.h"
+
+#include "imgui.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <utility>
+
+/**
+ * \brief Counts every request the engine allocators make to the system heap. In steady state the allocators serve all
+ * frame work from memory they already own, so the per-frame delta of these counters is expected to be zero.
+ */
+class HeapCounter
+{
+public:
+    static void* Allocate(const size_t Size)
+    {
+        s_Allocations.fetch_add(1, std::memory_order_relaxed);
+        s_Bytes.fetch_add(Size, std::memory_order_relaxed);
+        void* pointer = std::malloc(Size);
+        if (!pointer)
+            throw std::bad_alloc();
+        return pointer;
+    }
+
+    static void Free(void* Pointer)
+    {
+        std::free(Pointer);
+    }
+
+    [[nodiscard]] static uint64_t GetAllocationCount() { return s_Allocations.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] static uint64_t GetAllocatedBytes() { return s_Bytes.load(std::memory_order_relaxed); }
+
+private:
+    static inline std::atomic<uint64_t> s_Allocations{0};
+    static inline std::atomic<uint64_t> s_Bytes{0};
+};
+
+/**
+ * \brief Bump allocator for memory that lives for at most one frame. Individual frees are no-ops; Reset() rewinds it.
+ * When a frame needs more than the current capacity, overflow chunks are chained and merged into a single chunk of the
+ * combined size on the next Reset(), so the arena settles at the frame's high-water mark. Not thread-safe.
+ */
+class LinearArena final : public std::pmr::memory_resource
+{
+public:
+    explicit LinearArena(const size_t InitialCapacity = 64 * 1024)
+    {
+        m_Head = CreateChunk(InitialCapacity, nullptr);
+    }
+
+    ~LinearArena() override
+    {
+        FreeChunks(m_Head);
+    }
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+    LinearArena(LinearArena&&) = delete;
+    LinearArena& operator=(LinearArena&&) = delete;
+
+    void* Allocate(const size_t Size, const size_t Alignment = alignof(std::max_align_t))
+    {
+        size_t offset = GetAlignedOffset(m_Head, Alignment);
+        if (offset + Size > m_Head->Capacity)
+        {
+            m_Head = CreateChunk(std::max(m_Head->Capacity * 2, Size + Alignment), m_Head);
+            offset = GetAlignedOffset(m_Head, Alignment);
+        }
+
+        m_Head->Used = offset + Size;
+        return m_Head->GetData() + offset;
+    }
+
+    template <typename T, typename... Args>
+    T* New(Args&&... Arguments)
+    {
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(Arguments)...);
+    }
+
+    /**
+     * \brief Invalidates everything allocated since the last reset
+     */
+    void Reset()
+    {
+        m_HighWater = std::max(m_HighWater, GetUsed());
+        if (m_Head->Next)
+        {
+            const size_t capacity = GetCapacity();
+            FreeChunks(m_Head);
+            m_Head = CreateChunk(capacity, nullptr);
+        }
+        m_Head->Used = 0;
+    }
+
+    [[nodiscard]] size_t GetUsed() const
+    {
+        size_t used = 0;
+        for (const Chunk* chunk = m_Head; chunk; chunk = chunk->Next)
+            used += chunk->Used;
+        return used;
+    }
+
+    [[nodiscard]] size_t GetCapacity() const
+    {
+        size_t capacity = 0;
+        for (const Chunk* chunk = m_Head; chunk; chunk = chunk->Next)
+            capacity += chunk->Capacity;
+        return capacity;
+    }
+
+    [[nodiscard]] size_t GetHighWater() const { return std::max(m_HighWater, GetUsed()); }
+
+private:
+    struct alignas(std::max_align_t) Chunk
+    {
+        Chunk* Next;
+        size_t Capacity;
+        size_t Used;
+
+        std::byte* GetData() { return reinterpret_cast<std::byte*>(this + 1); }
+    };
+
+    static Chunk* CreateChunk(const size_t Capacity, Chunk* Next)
+    {
+        Chunk* chunk = static_cast<Chunk*>(HeapCounter::Allocate(sizeof(Chunk) + Capacity));
+        chunk->Next = Next;
+        chunk->Capacity = Capacity;
+        chunk->Used = 0;
+        return chunk;
+    }
+
+    static void FreeChunks(Chunk* Head)
+    {
+        while (Head)
+        {
+            Chunk* next = Head->Next;
+            HeapCounter::Free(Head);
+            Head = next;
+        }
+    }
+
+    static size_t GetAlignedOffset(Chunk* Target, const size_t Alignment)
+    {
+        const uintptr_t base = reinterpret_cast<uintptr_t>(Target->GetData());
+        const uintptr_t aligned = (base + Target->Used + Alignment - 1) & ~(static_cast<uintptr_t>(Alignment) - 1);
+        return static_cast<size_t>(aligned - base);
+    }
+
+    void* do_allocate(const size_t Bytes, const size_t Alignment) override { return Allocate(Bytes, Alignment); }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const std::pmr::memory_resource& Other) const noexcept override { return this == &Other; }
+
+    Chunk* m_Head{nullptr};
+    size_t m_HighWater{0};
+};
+
+/**
+ * \brief Thread-safe allocator for long-lived small objects. Requests that fit a MAX_POOLED_SIZE block (header included)
+ * are rounded up to a power-of-two size class and served from free lists refilled one 64 KiB slab at a time; larger requests go to the heap.
+ * Each block carries a small header so that it can be freed without its size, as ImGui's allocator interface requires.
+ */
+class PoolAllocator final : public std::pmr::memory_resource
+{
+public:
+    static constexpr size_t MIN_CLASS_SIZE = 16;
+    static constexpr size_t CLASS_COUNT = 8; // 16 B .. 2 KiB
+    static constexpr size_t MAX_POOLED_SIZE = MIN_CLASS_SIZE << (CLASS_COUNT - 1);
+    static constexpr size_t SLAB_SIZE = 64 * 1024;
+
+    struct ClassStats
+    {
+        size_t BlockSize{0};
+        size_t LiveBlocks{0};
+        size_t FreeBlocks{0};
+    };
+
+    PoolAllocator() = default;
+
+    ~PoolAllocator() override
+    {
+        while (m_Slabs)
+        {
+            Slab* next = m_Slabs->Next;
+            HeapCounter::Free(m_Slabs);
+            m_Slabs = next;
+        }
+    }
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+    PoolAllocator(PoolAllocator&&) = delete;
+    PoolAllocator& operator=(PoolAllocator&&) = delete;
+
+    void* Allocate(const size_t Size)
+    {
+        const size_t sizeClass = GetSizeClass(Size);
+        if (sizeClass == CLASS_COUNT)
+        {
+            Header* header = static_cast<Header*>(HeapCounter::Allocate(sizeof(Header) + Size));
+            header->SizeClass = CLASS_COUNT;
+            header->Size = Size;
+            std::lock_guard lock(m_Mutex);
+            m_LargeLive++;
+            return header + 1;
+        }
+
+        std::lock_guard lock(m_Mutex);
+        SizeClassState& state = m_Classes[sizeClass];
+        if (!state.FreeList)
+            Refill(sizeClass);
+
+        FreeBlock* block = state.FreeList;
+        state.FreeList = block->Next;
+        state.FreeCount--;
+        state.LiveCount++;
+
+        Header* header = reinterpret_cast<Header*>(block);
+        header->SizeClass = sizeClass;
+        header->Size = Size;
+        return header + 1;
+    }
+
+    void Deallocate(void* Pointer)
+    {
+        if (!Pointer)
+            return;
+
+        Header* header = static_cast<Header*>(Pointer) - 1;
+        const size_t sizeClass = header->SizeClass;
+        if (sizeClass == CLASS_COUNT)
+        {
+            HeapCounter::Free(header);
+            std::lock_guard lock(m_Mutex);
+            m_LargeLive--;
+            return;
+        }
+
+        std::lock_guard lock(m_Mutex);
+        SizeClassState& state = m_Classes[sizeClass];
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(header);
+        block->Next = state.FreeList;
+        state.FreeList = block;
+        state.FreeCount++;
+        state.LiveCount--;
+    }
+
+    /**
+     * \brief Routes every ImGui (and ImPlot) allocation through this pool. Must be called before ImGui::CreateContext()
+     * and the pool must outlive ImGui::DestroyContext().
+     */
+    void InstallImGuiAllocator()
+    {
+        ImGui::SetAllocatorFunctions(
+            [](const size_t Size, void* UserData)
+            {
+                AllocationTracker::RecordAllocation(MemoryTag::UI, Size);
+                return static_cast<PoolAllocator*>(UserData)->Allocate(Size);
+            },
+            [](void* Pointer, void* UserData)
+            {
+                if (Pointer)
+                    AllocationTracker::RecordFree(MemoryTag::UI, GetAllocationSize(Pointer));
+                static_cast<PoolAllocator*>(UserData)->Deallocate(Pointer);
+            },
+            this);
+    }
+
+    /**
+     * \brief Size originally requested for a block returned by Allocate()
+     */
+    [[nodiscard]] static size_t GetAllocationSize(const void* Pointer)
+    {
+        return (static_cast<const Header*>(Pointer) - 1)->Size;
+    }
+
+    [[nodiscard]] ClassStats GetClassStats(const size_t SizeClass) const
+    {
+        std::lock_guard lock(m_Mutex);
+        const SizeClassState& state = m_Classes[SizeClass];
+        return ClassStats{MIN_CLASS_SIZE << SizeClass, state.LiveCount, state.FreeCount};
+    }
+
+    [[nodiscard]] size_t GetLargeAllocationCount() const
+    {
+        std::lock_guard lock(m_Mutex);
+        return m_LargeLive;
+    }
+
+    [[nodiscard]] size_t GetSlabCount() const
+    {
+        std::lock_guard lock(m_Mutex);
+        return m_SlabCount;
+    }
+
+private:
+    struct alignas(std::max_align_t) Header
+    {
+        size_t SizeClass;
+        size_t Size;
+    };
+
+    struct FreeBlock
+    {
+        FreeBlock* Next;
+    };
+
+    struct alignas(std::max_align_t) Slab
+    {
+        Slab* Next;
+    };
+
+    struct SizeClassState
+    {
+        FreeBlock* FreeList{nullptr};
+        size_t FreeCount{0};
+        size_t LiveCount{0};
+    };
+
+    static size_t GetSizeClass(const size_t Size)
+    {
+        size_t sizeClass = 0;
+        while (sizeClass < CLASS_COUNT && (MIN_CLASS_SIZE << sizeClass) < Size + sizeof(Header))
+            sizeClass++;
+        return sizeClass;
+    }
+
+    void Refill(const size_t SizeClass)
+    {
+        Slab* slab = static_cast<Slab*>(HeapCounter::Allocate(SLAB_SIZE));
+        slab->Next = m_Slabs;
+        m_Slabs = slab;
+        m_SlabCount++;
+
+        const size_t blockSize = MIN_CLASS_SIZE << SizeClass;
+        std::byte* begin = reinterpret_cast<std::byte*>(slab + 1);
+        std::byte* end = reinterpret_cast<std::byte*>(slab) + SLAB_SIZE;
+
+        SizeClassState& state = m_Classes[SizeClass];
+        for (std::byte* block = begin; block + blockSize <= end; block += blockSize)
+        {
+            FreeBlock* freeBlock = reinterpret_cast<FreeBlock*>(block);
+            freeBlock->Next = state.FreeList;
+            state.FreeList = freeBlock;
+            state.FreeCount++;
+        }
+    }
+
+    void* do_allocate(const size_t Bytes, const size_t Alignment) override
+    {
+        if (Alignment > alignof(std::max_align_t))
+            return ::operator new(Bytes, std::align_val_t(Alignment));
+        return Allocate(Bytes);
+    }
+
+    void do_deallocate(void* Pointer, size_t, const size_t Alignment) override
+    {
+        if (Alignment > alignof(std::max_align_t))
+        {
+            ::operator delete(Pointer, std::align_val_t(Alignment));
+            return;
+        }
+        Deallocate(Pointer);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& Other) const noexcept override { return this == &Other; }
+
+    mutable std::mutex m_Mutex;
+    SizeClassState m_Classes[CLASS_COUNT];
+    Slab* m_Slabs{nullptr};
+    size_t m_SlabCount{0};
+    size_t m_LargeLive{0};
+};
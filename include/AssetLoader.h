@@ -0,0 +1,121 @@
+#pragma once
+
+#include "AllocationTracker.h"
+#include "AsyncTask.h"
+#include "JobSystem.h"
+#include "Shader.h"
+#include "Texture.h"
+
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Image decoded by stb_image on a worker thread, ready to be uploaded on the render thread
+ */
+struct DecodedImage
+{
+    struct PixelDeleter
+    {
+        void operator()(unsigned char* Pixels) const { stbi_image_free(Pixels); }
+    };
+
+    std::unique_ptr<unsigned char, PixelDeleter> Pixels;
+    int Width{0};
+    int Height{0};
+    int Channels{0};
+};
+
+/**
+ * \brief Reads a whole file on a worker thread. Yields an empty buffer if the file could not be read.
+ */
+inline Task<std::vector<char>> ReadFileAsync(JobSystem& System, std::string Path, const CancellationToken* Token = nullptr)
+{
+    co_await ResumeOnWorker(System, Token);
+    ScopedMemoryTag memoryTag(MemoryTag::ASSETS);
+
+    std::vector<char> data;
+    FILE* file = fopen(Path.c_str(), "rb");
+    if (!file)
+    {
+        std::cout << "Failed to open file " << Path << std::endl;
+        co_return data;
+    }
+
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size > 0)
+    {
+        data.resize(static_cast<size_t>(size));
+        if (fread(data.data(), 1, data.size(), file) != data.size())
+        {
+            std::cout << "Failed to read file " << Path << std::endl;
+            data.clear();
+        }
+    }
+    fclose(file);
+    co_return data;
+}
+
+/**
+ * \brief Reads both shader stages concurrently. Compilation is left to the render thread (see Shader(const ShaderSource&)).
+ */
+inline Task<ShaderSource> LoadShaderSourceAsync(JobSystem& System, std::string VertexPath, std::string FragmentPath,
+                                                const CancellationToken* Token = nullptr)
+{
+    Task<std::vector<char>> vertex = ReadFileAsync(System, std::move(VertexPath), Token);
+    Task<std::vector<char>> fragment = ReadFileAsync(System, std::move(FragmentPath), Token);
+    co_await WhenAll(vertex, fragment);
+
+    const std::vector<char> vertexCode = vertex.GetResult();
+    const std::vector<char> fragmentCode = fragment.GetResult();
+    co_return ShaderSource{std::string(vertexCode.begin(), vertexCode.end()),
+                           std::string(fragmentCode.begin(), fragmentCode.end())};
+}
+
+/**
+ * \brief Reads and decodes an image on worker threads, flipped vertically for OpenGL
+ */
+inline Task<DecodedImage> LoadImageAsync(JobSystem& System, std::string Path, const CancellationToken* Token = nullptr)
+{
+    const std::vector<char> encoded = co_await ReadFileAsync(System, Path, Token);
+    if (Token)
+        Token->ThrowIfCancelled();
+
+    ScopedMemoryTag memoryTag(MemoryTag::ASSETS);
+    DecodedImage image;
+    if (encoded.empty())
+        co_return image;
+
+    // the flip flag is global state in stb_image; the thread-local variant keeps concurrent decodes independent
+    stbi_set_flip_vertically_on_load_thread(true);
+    image.Pixels.reset(stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(encoded.data()), static_cast<int>(encoded.size()),
+                                             &image.Width, &image.Height, &image.Channels, 0));
+    if (!image.Pixels)
+        std::cout << "Failed to load texture " << Path << std::endl;
+    co_return image;
+}
+
+/**
+ * \brief Loads and compiles a shader program without blocking the main or render thread
+ */
+inline Task<std::unique_ptr<Shader>> LoadShaderAsync(JobSystem& System, std::string VertexPath, std::string FragmentPath,
+                                                     const CancellationToken* Token = nullptr)
+{
+    const ShaderSource source = co_await LoadShaderSourceAsync(System, std::move(VertexPath), std::move(FragmentPath), Token);
+    co_await ResumeOnRenderThread(System, Token);
+    co_return std::make_unique<Shader>(source);
+}
+
+/**
+ * \brief Loads and decodes a texture on worker threads, then uploads it on the render thread
+ */
+inline Task<std::unique_ptr<Texture>> LoadTextureAsync(JobSystem& System, std::string Path, const CancellationToken* Token = nullptr)
+{
+    const DecodedImage image = co_await LoadImageAsync(System, std::move(Path), Token);
+    co_await ResumeOnRenderThread(System, Token);
+    co_return std::make_unique<Texture>(image.Pixels.get(), image.Width, image.Height, image.Channels);
+}
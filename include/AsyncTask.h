@@ -0,0 +1,454 @@
+#pragma once
+
+#include "JobSystem.h"
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iostream>
+#include <new>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * \brief Pooled storage for coroutine frames. Frames are rounded up to a power-of-two size class and recycled through
+ * thread-local free lists, so steady-state loading does not hit the global heap.
+ */
+class CoroutineFrameAllocator
+{
+public:
+    static constexpr size_t MIN_CLASS_SIZE = 128;
+    static constexpr size_t CLASS_COUNT = 6; // 128 B .. 4 KiB; larger frames go to the heap
+
+    static void* Allocate(const size_t Size)
+    {
+        const size_t sizeClass = GetSizeClass(Size + sizeof(Header));
+        Header* header = nullptr;
+
+        if (sizeClass < CLASS_COUNT)
+        {
+            FreeBlock*& freeList = s_FreeLists.Heads[sizeClass];
+            if (freeList)
+            {
+                header = reinterpret_cast<Header*>(freeList);
+                freeList = freeList->Next;
+            }
+            else
+            {
+                header = static_cast<Header*>(::operator new(MIN_CLASS_SIZE << sizeClass));
+            }
+        }
+        else
+        {
+            header = static_cast<Header*>(::operator new(Size + sizeof(Header)));
+        }
+
+        header->SizeClass = sizeClass;
+        return header + 1;
+    }
+
+    static void Deallocate(void* Pointer)
+    {
+        Header* header = static_cast<Header*>(Pointer) - 1;
+        const size_t sizeClass = header->SizeClass;
+        if (sizeClass >= CLASS_COUNT)
+        {
+            ::operator delete(header);
+            return;
+        }
+
+        // blocks freed on another thread than the one that allocated them simply move to this thread's list;
+        // the link overwrites the header, which is rewritten on the next Allocate()
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(header);
+        block->Next = s_FreeLists.Heads[sizeClass];
+        s_FreeLists.Heads[sizeClass] = block;
+    }
+
+private:
+    struct alignas(std::max_align_t) Header
+    {
+        size_t SizeClass;
+    };
+
+    struct FreeBlock
+    {
+        FreeBlock* Next;
+    };
+
+    struct FreeLists
+    {
+        FreeBlock* Heads[CLASS_COUNT]{};
+
+        ~FreeLists()
+        {
+            for (FreeBlock* head : Heads)
+            {
+                while (head)
+                {
+                    FreeBlock* next = head->Next;
+                    ::operator delete(head);
+                    head = next;
+                }
+            }
+        }
+    };
+
+    static size_t GetSizeClass(const size_t Size)
+    {
+        size_t sizeClass = 0;
+        while ((MIN_CLASS_SIZE << sizeClass) < Size && sizeClass < CLASS_COUNT)
+            sizeClass++;
+        return sizeClass;
+    }
+
+    static thread_local FreeLists s_FreeLists;
+};
+
+inline thread_local CoroutineFrameAllocator::FreeLists CoroutineFrameAllocator::s_FreeLists;
+
+/**
+ * \brief Thrown from an awaiter when the operation it belongs to was cancelled. Caught by AsyncScope.
+ */
+struct TaskCancelled
+{
+};
+
+/**
+ * \brief Shared cancellation flag checked at every suspension point of an async operation
+ */
+class CancellationToken
+{
+public:
+    void Cancel() { m_bCancelled.store(true, std::memory_order_release); }
+
+    [[nodiscard]] bool IsCancelled() const { return m_bCancelled.load(std::memory_order_acquire); }
+
+    void ThrowIfCancelled() const
+    {
+        if (IsCancelled())
+            throw TaskCancelled();
+    }
+
+private:
+    std::atomic<bool> m_bCancelled{false};
+};
+
+namespace Detail
+{
+struct PromiseBase
+{
+    std::coroutine_handle<> Continuation;
+    std::exception_ptr Exception;
+
+    static void* operator new(const size_t Size) { return CoroutineFrameAllocator::Allocate(Size); }
+    static void operator delete(void* Pointer) { CoroutineFrameAllocator::Deallocate(Pointer); }
+
+    struct FinalAwaiter
+    {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> Handle) noexcept
+        {
+            // symmetric transfer back to whoever awaited us, without growing the stack
+            std::coroutine_handle<> continuation = Handle.promise().Continuation;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() { Exception = std::current_exception(); }
+};
+
+template <typename T>
+struct Promise : PromiseBase
+{
+    std::optional<T> Value;
+
+    template <typename U>
+    void return_value(U&& Result) { Value.emplace(std::forward<U>(Result)); }
+
+    T TakeResult()
+    {
+        if (Exception)
+            std::rethrow_exception(Exception);
+        return std::move(*Value);
+    }
+};
+
+template <>
+struct Promise<void> : PromiseBase
+{
+    void return_void() const noexcept {}
+
+    void TakeResult() const
+    {
+        if (Exception)
+            std::rethrow_exception(Exception);
+    }
+};
+} // namespace Detail
+
+/**
+ * \brief Lazily started coroutine producing a T. Starts when awaited; the awaiting coroutine resumes when it completes.
+ */
+template <typename T = void>
+class [[nodiscard]] Task
+{
+public:
+    struct promise_type : Detail::Promise<T>
+    {
+        Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+    };
+
+    Task() = default;
+
+    explicit Task(std::coroutine_handle<promise_type> Handle) : m_Handle(Handle) {}
+
+    ~Task()
+    {
+        if (m_Handle)
+            m_Handle.destroy();
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& Other) noexcept : m_Handle(std::exchange(Other.m_Handle, nullptr)) {}
+
+    Task& operator=(Task&& Other) noexcept
+    {
+        if (this != &Other)
+        {
+            if (m_Handle)
+                m_Handle.destroy();
+            m_Handle = std::exchange(Other.m_Handle, nullptr);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] bool IsDone() const { return !m_Handle || m_Handle.done(); }
+
+    /**
+     * \brief Result of a completed task; rethrows the exception it finished with, if any
+     */
+    T GetResult() { return m_Handle.promise().TakeResult(); }
+
+    auto operator co_await() noexcept
+    {
+        struct Awaiter
+        {
+            std::coroutine_handle<promise_type> Handle;
+
+            bool await_ready() const noexcept { return !Handle || Handle.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> Awaiting) noexcept
+            {
+                Handle.promise().Continuation = Awaiting;
+                return Handle;
+            }
+
+            T await_resume() { return Handle.promise().TakeResult(); }
+        };
+        return Awaiter{m_Handle};
+    }
+
+private:
+    std::coroutine_handle<promise_type> m_Handle;
+};
+
+namespace Detail
+{
+/**
+ * \brief Eagerly started, self-destroying coroutine used to drive tasks from non-coroutine code
+ */
+struct DetachedTask
+{
+    struct promise_type
+    {
+        static void* operator new(const size_t Size) { return CoroutineFrameAllocator::Allocate(Size); }
+        static void operator delete(void* Pointer) { CoroutineFrameAllocator::Deallocate(Pointer); }
+
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+struct WhenAllState
+{
+    std::atomic<uint32_t> Remaining{0};
+    std::coroutine_handle<> Continuation;
+
+    void Arrive()
+    {
+        if (Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Continuation.resume();
+    }
+};
+
+template <typename T>
+DetachedTask RunAndArrive(Task<T>& Operation, WhenAllState& State)
+{
+    // the result (or exception) stays in the task; the caller retrieves it with GetResult()
+    try
+    {
+        co_await Operation;
+    }
+    catch (...)
+    {
+    }
+    State.Arrive();
+}
+} // namespace Detail
+
+/**
+ * \brief Runs several tasks concurrently and resumes once all of them have completed.
+ * Results are read afterwards with Task::GetResult(), which also rethrows per-task failures.
+ */
+template <typename... Ts>
+auto WhenAll(Task<Ts>&... Tasks)
+{
+    struct Awaiter
+    {
+        std::tuple<Task<Ts>&...> Tasks;
+        Detail::WhenAllState State;
+
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> Awaiting)
+        {
+            // one extra count so that tasks completing synchronously cannot resume us before every task was started
+            State.Continuation = Awaiting;
+            State.Remaining.store(sizeof...(Ts) + 1, std::memory_order_relaxed);
+            std::apply([this](auto&... Each) { (Detail::RunAndArrive(Each, State), ...); }, Tasks);
+            State.Arrive();
+        }
+
+        void await_resume() const noexcept {}
+    };
+    return Awaiter{std::tuple<Task<Ts>&...>(Tasks...), {}};
+}
+
+/**
+ * \brief co_await to continue the coroutine in a job with the given affinity (ANY = worker thread, RENDER_THREAD = GL thread).
+ * Throws TaskCancelled on resumption if the token was cancelled meanwhile.
+ */
+inline auto ResumeOn(JobSystem& System, const JobAffinity Affinity, const CancellationToken* Token = nullptr)
+{
+    struct Awaiter
+    {
+        JobSystem& System;
+        JobAffinity Affinity;
+        const CancellationToken* Token;
+
+        // already cancelled: skip the thread hop and fail right away
+        bool await_ready() const noexcept { return Token && Token->IsCancelled(); }
+
+        void await_suspend(std::coroutine_handle<> Handle) const
+        {
+            System.Run([Handle]() { Handle.resume(); }, nullptr, Affinity);
+        }
+
+        void await_resume() const
+        {
+            if (Token)
+                Token->ThrowIfCancelled();
+        }
+    };
+    return Awaiter{System, Affinity, Token};
+}
+
+inline auto ResumeOnWorker(JobSystem& System, const CancellationToken* Token = nullptr)
+{
+    return ResumeOn(System, JobAffinity::ANY, Token);
+}
+
+inline auto ResumeOnRenderThread(JobSystem& System, const CancellationToken* Token = nullptr)
+{
+    return ResumeOn(System, JobAffinity::RENDER_THREAD, Token);
+}
+
+/**
+ * \brief Owns a set of fire-and-forget async operations (e.g. everything loading for one scene) and cancels them together.
+ * Destroying the scope cancels and waits for them, so it must happen on the main thread while the threads the operations
+ * resume on (e.g. the render thread) still run jobs.
+ */
+class AsyncScope
+{
+public:
+    explicit AsyncScope(JobSystem& System) : m_System(System) {}
+
+    ~AsyncScope()
+    {
+        // the operations hold a reference to the scope until they finish
+        Cancel();
+        Wait();
+    }
+
+    AsyncScope(const AsyncScope&) = delete;
+    AsyncScope& operator=(const AsyncScope&) = delete;
+
+    [[nodiscard]] const CancellationToken& GetToken() const { return m_Token; }
+
+    /**
+     * \brief Starts Operation immediately; it runs until its first suspension point on the calling thread
+     */
+    void Spawn(Task<void> Operation)
+    {
+        m_Outstanding.fetch_add(1, std::memory_order_relaxed);
+        Drive(std::move(Operation), *this);
+    }
+
+    void Cancel() { m_Token.Cancel(); }
+
+    [[nodiscard]] bool IsIdle() const { return m_Outstanding.load(std::memory_order_acquire) == 0; }
+
+    /**
+     * \brief Waits for every spawned operation to finish, running main-thread jobs meanwhile
+     */
+    void Wait()
+    {
+        while (!IsIdle())
+        {
+            if (m_System.RunAffineJobs(JobAffinity::MAIN_THREAD) == 0)
+                std::this_thread::yield();
+        }
+    }
+
+private:
+    static Detail::DetachedTask Drive(Task<void> Operation, AsyncScope& Scope)
+    {
+        try
+        {
+            co_await Operation;
+        }
+        catch (const TaskCancelled&)
+        {
+        }
+        catch (const std::exception& e)
+        {
+            std::cout << "Async operation failed: " << e.what() << std::endl;
+        }
+        catch (...)
+        {
+            // anything escaping a detached coroutine would terminate the program
+            std::cout << "Async operation failed with an unknown exception" << std::endl;
+        }
+        Scope.m_Outstanding.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    JobSystem& m_System;
+    CancellationToken m_Token;
+    std::atomic<uint32_t> m_Outstanding{0};
+};
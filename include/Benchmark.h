@@ -0,0 +1,302 @@
+#pragma once
+
+#include "Camera.h"
+#include "CpuProfiler.h"
+#include "GLCallCounter.h"
+
+#include "LegitProfiler/ProfilerTask.h"
+
+#include "GLFW/glfw3.h"
+#include "glm/glm.hpp"
+
+#include "imgui.h"
+#include "implot/implot.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * \brief A cube of a generated benchmark scene; TextureIndex 0 is the scene texture, 1..N the generated ones
+ */
+struct BenchmarkCube
+{
+    glm::vec3 Position;
+    uint32_t TextureIndex;
+};
+
+/**
+ * \brief Lays Count cubes out on a centered grid. Deterministic. Textures are assigned in contiguous blocks, so draws
+ * with the same texture are adjacent and the renderer binds each texture once per frame.
+ */
+inline std::vector<BenchmarkCube> GenerateBenchmarkCubes(const uint32_t Count, const uint32_t TextureCount)
+{
+    std::vector<BenchmarkCube> cubes;
+    cubes.reserve(Count);
+
+    const uint32_t side = std::max(1u, static_cast<uint32_t>(std::ceil(std::cbrt(static_cast<double>(Count)))));
+    const float spacing = 2.0f;
+    const float offset = (static_cast<float>(side) - 1.0f) * spacing * 0.5f;
+    for (uint32_t i = 0; i < Count; i++)
+    {
+        const uint32_t x = i % side;
+        const uint32_t y = (i / side) % side;
+        const uint32_t z = i / (side * side);
+        const glm::vec3 position(x * spacing - offset, y * spacing - offset, z * spacing - offset);
+        cubes.push_back({position, TextureCount > 0 ? 1 + static_cast<uint32_t>(static_cast<uint64_t>(i) * TextureCount / Count) : 0});
+    }
+    return cubes;
+}
+
+/**
+ * \brief Radius of the sphere around the origin that contains every cube of GenerateBenchmarkCubes(Count, ...)
+ */
+inline float GetBenchmarkSceneRadius(const uint32_t Count)
+{
+    const float side = std::max(1.0f, std::ceil(std::cbrt(static_cast<float>(Count))));
+    return (side - 1.0f) * 2.0f * 0.5f * std::sqrt(3.0f) + 0.87f;
+}
+
+/**
+ * \brief Scripted camera flythrough: one orbit around the scene with a vertical sweep, always looking at the centre.
+ * Driven by the frame number rather than by time, so every run renders the same sequence of views.
+ */
+inline void ApplyBenchmarkCameraPath(Camera& Target, const uint32_t Frame, const uint32_t FrameCount, const float SceneRadius)
+{
+    const float t = FrameCount > 1 ? static_cast<float>(Frame) / static_cast<float>(FrameCount - 1) : 0.0f;
+    const float angle = t * 2.0f * 3.14159265f;
+    // close enough that part of larger scenes falls outside the frustum, so culling is exercised too
+    const float distance = std::max(3.0f, SceneRadius * 1.4f);
+    const glm::vec3 position(std::cos(angle) * distance, std::sin(angle * 2.0f) * distance * 0.3f, std::sin(angle) * distance);
+
+    const glm::vec3 forward = glm::normalize(-position);
+    Target.SetPosition(position);
+    Target.SetYawPitch(glm::degrees(std::atan2(forward.z, forward.x)), glm::degrees(std::asin(forward.y)));
+}
+
+/**
+ * \brief Builds Count ImGui windows with deterministic content (text, a table and a plot) for the UI side of the load
+ */
+inline void RenderBenchmarkWindows(const uint32_t Count, const uint32_t Frame)
+{
+    static float plotValues[512];
+    for (int i = 0; i < 512; i++)
+        plotValues[i] = std::sin((static_cast<float>(i) + static_cast<float>(Frame)) * 0.05f);
+
+    for (uint32_t window = 0; window < Count; window++)
+    {
+        char title[32];
+        snprintf(title, sizeof(title), "Benchmark %u", window);
+        ImGui::SetNextWindowPos(ImVec2(40.0f + 30.0f * (window % 16), 40.0f + 30.0f * (window % 16)), ImGuiCond_Always);
+        ImGui::SetNextWindowSize(ImVec2(420.0f, 360.0f), ImGuiCond_Always);
+        ImGui::Begin(title);
+        ImGui::Text("Frame %u, window %u", Frame, window);
+        if (ImGui::BeginTable("Rows", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg, ImVec2(0.0f, 150.0f)))
+        {
+            for (int row = 0; row < 40; row++)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("Row %d", row);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", plotValues[(row * 7 + Frame) % 512]);
+                ImGui::TableNextColumn();
+                ImGui::ProgressBar(0.5f + 0.5f * plotValues[(row * 13) % 512], ImVec2(-1.0f, 0.0f));
+            }
+            ImGui::EndTable();
+        }
+        if (ImPlot::BeginPlot("Signal", ImVec2(-1.0f, 150.0f)))
+        {
+            ImPlot::PlotLine("sin", plotValues, 512);
+            ImPlot::EndPlot();
+        }
+        ImGui::End();
+    }
+}
+
+/**
+ * \brief Makes the next glfwCreateWindow() produce an offscreen context on GLFW's null platform, trying OSMesa first and
+ * then EGL (with Mesa, llvmpipe either way). Call after glfwInit() with GLFW_PLATFORM_NULL. Returns false if neither works.
+ */
+inline bool SelectHeadlessContextApi()
+{
+    const int apis[] = {GLFW_OSMESA_CONTEXT_API, GLFW_EGL_CONTEXT_API};
+    for (const int api : apis)
+    {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, api);
+        GLFWwindow* probe = glfwCreateWindow(16, 16, "probe", nullptr, nullptr);
+        if (probe)
+        {
+            glfwDestroyWindow(probe);
+            std::cerr << "Headless context: " << (api == GLFW_OSMESA_CONTEXT_API ? "OSMesa" : "EGL") << std::endl;
+            return true;
+        }
+    }
+    std::cerr << "Headless run: no offscreen OpenGL context (needs OSMesa or EGL)" << std::endl;
+    return false;
+}
+
+/**
+ * \brief Collects per-frame measurements of a benchmark run and writes them as a JSON report.
+ *
+ * Percentiles are exact (computed from every measured frame). CPU phases are the CpuProfiler scopes of all threads,
+ * summed per frame by name. GL calls are counted by GLCallCounter between BeginMeasurement() and EndMeasurement().
+ */
+class BenchmarkReport
+{
+public:
+    void BeginMeasurement(const uint32_t Frames)
+    {
+        m_FrameMilliseconds.reserve(Frames);
+        for (uint32_t i = 0; i < GLCallCounter::CALL_COUNT; i++)
+            m_GLCallsAtBegin[i] = GLCallCounter::GetCount(i);
+        m_bMeasuring = true;
+    }
+
+    /**
+     * \brief Records the frame CpuProfiler just drained (call after CpuProfiler::EndFrame())
+     */
+    void AddFrame(const double Milliseconds, const uint32_t ImGuiDrawCommands)
+    {
+        if (!m_bMeasuring)
+            return;
+
+        const size_t frame = m_FrameMilliseconds.size();
+        m_FrameMilliseconds.push_back(static_cast<float>(Milliseconds));
+        m_ImGuiDrawCommands += ImGuiDrawCommands;
+
+        for (Phase& phase : m_Phases)
+            phase.Milliseconds.push_back(0.0f);
+        for (const ProfilerEvent& event : CpuProfiler::GetFrameEvents())
+        {
+            Phase& phase = GetPhase(event.NameId, frame);
+            phase.Milliseconds[frame] += static_cast<float>(CpuProfiler::TicksToSeconds(static_cast<int64_t>(event.End - event.Begin)) * 1000.0);
+        }
+    }
+
+    void EndMeasurement()
+    {
+        for (uint32_t i = 0; i < GLCallCounter::CALL_COUNT; i++)
+            m_GLCalls[i] = GLCallCounter::GetCount(i) - m_GLCallsAtBegin[i];
+        m_bMeasuring = false;
+    }
+
+    [[nodiscard]] size_t GetFrameCount() const { return m_FrameMilliseconds.size(); }
+
+    /**
+     * \brief Writes the report. Config is emitted verbatim as the "config" object and should be a JSON object.
+     */
+    bool WriteJson(const char* Path, const char* Config) const
+    {
+        FILE* file = fopen(Path, "wb");
+        if (!file)
+        {
+            std::cout << "Failed to open benchmark report " << Path << std::endl;
+            return false;
+        }
+
+        const double frames = std::max<double>(1.0, static_cast<double>(m_FrameMilliseconds.size()));
+        fprintf(file, "{\n  \"config\": %s,\n", Config);
+        fputs("  \"environment\": {\"gl_renderer\": ", file);
+        WriteJsonString(file, m_Renderer.c_str());
+        fputs(", \"gl_version\": ", file);
+        WriteJsonString(file, m_Version.c_str());
+        fprintf(file, ", \"hardware_threads\": %u},\n", std::thread::hardware_concurrency());
+        fprintf(file, "  \"frames\": %zu,\n", m_FrameMilliseconds.size());
+        fputs("  \"frame_ms\": ", file);
+        WriteStats(file, m_FrameMilliseconds);
+        fputs(",\n  \"cpu_phases_ms\": {", file);
+        for (size_t i = 0; i < m_Phases.size(); i++)
+        {
+            fputs(i ? ",\n    " : "\n    ", file);
+            WriteJsonString(file, legit::TaskNames::Get(m_Phases[i].NameId));
+            fputs(": ", file);
+            WriteStats(file, m_Phases[i].Milliseconds);
+        }
+        fputs("\n  },\n  \"gl_calls_per_frame\": {", file);
+        uint64_t totalGLCalls = 0;
+        for (uint32_t i = 0; i < GLCallCounter::CALL_COUNT; i++)
+        {
+            fprintf(file, "%s\n    \"%s\": %.2f", i ? "," : "", GLCallCounter::GetName(i), m_GLCalls[i] / frames);
+            totalGLCalls += m_GLCalls[i];
+        }
+        fprintf(file, ",\n    \"total\": %.2f\n  },\n", totalGLCalls / frames);
+        fprintf(file, "  \"imgui_draw_commands_per_frame\": %.2f\n}\n", m_ImGuiDrawCommands / frames);
+
+        const bool bWritten = ferror(file) == 0;
+        fclose(file);
+        if (!bWritten)
+            std::cout << "Failed to write benchmark report " << Path << std::endl;
+        return bWritten;
+    }
+
+    void SetEnvironment(const char* Renderer, const char* Version)
+    {
+        m_Renderer = Renderer ? Renderer : "unknown";
+        m_Version = Version ? Version : "unknown";
+    }
+
+private:
+    struct Phase
+    {
+        uint32_t NameId;
+        std::vector<float> Milliseconds;
+    };
+
+    Phase& GetPhase(const uint32_t NameId, const size_t Frame)
+    {
+        for (Phase& phase : m_Phases)
+        {
+            if (phase.NameId == NameId)
+                return phase;
+        }
+        // first seen this frame: the earlier frames did not run this scope
+        m_Phases.push_back({NameId, std::vector<float>(Frame + 1, 0.0f)});
+        return m_Phases.back();
+    }
+
+    static void WriteStats(FILE* File, std::vector<float> Values)
+    {
+        if (Values.empty())
+        {
+            fputs("null", File);
+            return;
+        }
+        std::sort(Values.begin(), Values.end());
+        double sum = 0.0;
+        for (const float value : Values)
+            sum += value;
+        const auto percentile = [&Values](const double Q) { return Values[static_cast<size_t>(Q * (Values.size() - 1) + 0.5)]; };
+        fprintf(File, "{\"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"min\": %.4f, \"max\": %.4f}",
+                sum / Values.size(), percentile(0.5), percentile(0.95), percentile(0.99), Values.front(), Values.back());
+    }
+
+    static void WriteJsonString(FILE* Out, const char* Value)
+    {
+        fputc('"', Out);
+        for (const char* c = Value; *c; c++)
+        {
+            if (*c == '"' || *c == '\\')
+                fputc('\\', Out);
+            if (static_cast<unsigned char>(*c) < 0x20)
+                fprintf(Out, "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(*c)));
+            else
+                fputc(*c, Out);
+        }
+        fputc('"', Out);
+    }
+
+    bool m_bMeasuring{false};
+    std::vector<float> m_FrameMilliseconds;
+    std::vector<Phase> m_Phases;
+    uint64_t m_GLCallsAtBegin[GLCallCounter::CALL_COUNT]{};
+    uint64_t m_GLCalls[GLCallCounter::CALL_COUNT]{};
+    uint64_t m_ImGuiDrawCommands{0};
+    std::string m_Renderer{"unknown"};
+    std::string m_Version{"unknown"};
+};
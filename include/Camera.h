@@ -4,6 +4,8 @@
 #include "glm/gtc/matrix_transform.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
 
 enum class CameraMovement
@@ -16,37 +18,130 @@ enum class CameraMovement
     DOWN,
 };
 
+/**
+ * \brief View frustum as six inward facing planes (xyz = normal, w = distance), extracted from a view-projection matrix
+ */
+struct Frustum
+{
+    glm::vec4 Planes[6];
+
+    void Extract(const glm::mat4& ViewProj)
+    {
+        const glm::vec4 row0(ViewProj[0][0], ViewProj[1][0], ViewProj[2][0], ViewProj[3][0]);
+        const glm::vec4 row1(ViewProj[0][1], ViewProj[1][1], ViewProj[2][1], ViewProj[3][1]);
+        const glm::vec4 row2(ViewProj[0][2], ViewProj[1][2], ViewProj[2][2], ViewProj[3][2]);
+        const glm::vec4 row3(ViewProj[0][3], ViewProj[1][3], ViewProj[2][3], ViewProj[3][3]);
+
+        Planes[0] = row3 + row0; // left
+        Planes[1] = row3 - row0; // right
+        Planes[2] = row3 + row1; // bottom
+        Planes[3] = row3 - row1; // top
+        Planes[4] = row3 + row2; // near
+        Planes[5] = row3 - row2; // far
+
+        for (glm::vec4& plane : Planes)
+        {
+            plane /= glm::length(glm::vec3(plane));
+        }
+    }
+
+    [[nodiscard]] bool IsSphereVisible(const glm::vec3& Center, const float Radius) const
+    {
+        for (const glm::vec4& plane : Planes)
+        {
+            if (glm::dot(glm::vec3(plane), Center) + plane.w < -Radius)
+                return false;
+        }
+        return true;
+    }
+};
+
 class Camera
 {
 public:
+    using Clock = std::chrono::steady_clock;
+
     Camera(glm::vec3 Position = glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3 Forward = glm::vec3(0.0f, 0.0f, 1.0f))
         : m_Position(Position), m_Forward(Forward)
     {
         m_Pitch = glm::degrees(asin(m_Forward.y));
         m_Yaw = glm::degrees(atan2(m_Forward.z, m_Forward.x));
-        std::cout << m_Pitch << " " << m_Yaw << std::endl;
-        UpdateCameraVectors();
         UpdatePerspectiveProjectionMatrix(1920, 1080);
     }
 
+    // Matrices are recomputed lazily: input only marks them dirty, so any number of input events per frame
+    // costs a single basis/lookAt/viewProj rebuild the first time a matrix is requested for rendering.
     [[nodiscard]] const glm::mat4& GetViewMatrix() const
     {
+        ResolveDirty();
         return m_ViewMat;
     }
 
     [[nodiscard]] const glm::mat4& GetPerspectiveProjectionMatrix() const
     {
+        ResolveDirty();
         return m_PerspectiveProjMat;
     }
 
+    [[nodiscard]] const glm::mat4& GetViewProjectionMatrix() const
+    {
+        ResolveDirty();
+        return m_ViewProjMat;
+    }
+
+    [[nodiscard]] const Frustum& GetFrustum() const
+    {
+        ResolveDirty();
+        return m_Frustum;
+    }
+
+    /**
+     * \brief Incremented every time the matrices are rebuilt; lets consumers skip re-uploading unchanged matrices
+     */
+    [[nodiscard]] uint64_t GetMatrixRevision() const
+    {
+        ResolveDirty();
+        return m_MatrixRevision;
+    }
+
+    /**
+     * \brief Time in seconds from the oldest input event applied to the camera to the matrices reflecting it
+     */
+    [[nodiscard]] double GetInputLatency() const { return m_InputLatency; }
+
+    [[nodiscard]] const glm::vec3& GetPosition() const { return m_Position; }
+
+    void SetPosition(const glm::vec3& Position)
+    {
+        m_Position = Position;
+        m_DirtyFlags |= DIRTY_VIEW;
+    }
+
+    void SetYawPitch(const float Yaw, const float Pitch)
+    {
+        m_Yaw = Yaw;
+        m_Pitch = std::clamp(Pitch, -89.0f, 89.0f);
+        m_DirtyFlags |= DIRTY_BASIS | DIRTY_VIEW;
+    }
+
     void UpdatePerspectiveProjectionMatrix(const uint32_t Width, const uint32_t Height)
     {
-        m_PerspectiveProjMat = glm::perspective(glm::radians(m_FOV), static_cast<float>(Width) / Height,
-                                                m_NearClipPlane, m_FarClipPlane);
+        if (Width == 0 || Height == 0)
+            return;
+
+        const float aspect = static_cast<float>(Width) / Height;
+        if (aspect != m_AspectRatio)
+        {
+            m_AspectRatio = aspect;
+            m_DirtyFlags |= DIRTY_PROJECTION;
+        }
     }
 
-    void ProcessKeyboard(const CameraMovement Direction, const float DeltaTime)
+    void ProcessKeyboard(const CameraMovement Direction, const float DeltaTime, const Clock::time_point InputTime = Clock::now())
     {
+        // movement is relative to the current basis, so apply any pending rotation first
+        UpdateCameraVectors();
+
         const float velocity = m_MovementSpeed * DeltaTime;
         if (Direction == CameraMovement::FORWARD)
             m_Position += m_Forward * velocity;
@@ -60,23 +155,49 @@ public:
             m_Position += m_Up * velocity;
         if (Direction == CameraMovement::DOWN)
             m_Position -= m_Up * velocity;
+
+        m_DirtyFlags |= DIRTY_VIEW;
+        RecordInputTime(InputTime);
     }
 
-    void ProcessMouseMovement(const float OffsetX, const float OffsetY)
+    void ProcessMouseMovement(const float OffsetX, const float OffsetY, const Clock::time_point InputTime = Clock::now())
     {
+        if (OffsetX == 0.0f && OffsetY == 0.0f)
+            return;
+
         m_Yaw += OffsetX * m_MouseSensitivity;
         m_Pitch += OffsetY * m_MouseSensitivity;
 
         // make sure that when pitch is out of bounds, screen doesn't get flipped
         m_Pitch = std::clamp(m_Pitch, -89.0f, 89.0f);
 
-        // update Front, Right and Up Vectors using the updated Euler angles
-        UpdateCameraVectors();
+        m_DirtyFlags |= DIRTY_BASIS | DIRTY_VIEW;
+        RecordInputTime(InputTime);
     }
 
 private:
-    void UpdateCameraVectors()
+    enum DirtyFlag : uint32_t
+    {
+        DIRTY_BASIS = 1 << 0,
+        DIRTY_VIEW = 1 << 1,
+        DIRTY_PROJECTION = 1 << 2,
+        DIRTY_ALL = DIRTY_BASIS | DIRTY_VIEW | DIRTY_PROJECTION,
+    };
+
+    void RecordInputTime(const Clock::time_point InputTime)
+    {
+        if (!m_bHasPendingInput || InputTime < m_PendingInputTime)
+        {
+            m_PendingInputTime = InputTime;
+            m_bHasPendingInput = true;
+        }
+    }
+
+    void UpdateCameraVectors() const
     {
+        if (!(m_DirtyFlags & DIRTY_BASIS))
+            return;
+
         const float pitchRadians = glm::radians(m_Pitch);
         const float yawRadians = glm::radians(m_Yaw);
         const float cosPitch = cos(pitchRadians);
@@ -85,14 +206,43 @@ private:
         m_Forward = glm::normalize(forward);
         m_Right = glm::normalize(glm::cross(m_Forward, m_WorldUp));
         m_Up = glm::normalize(glm::cross(m_Right, m_Forward));
-        m_ViewMat = glm::lookAt(m_Position, m_Position + m_Forward, m_Up);
+        m_DirtyFlags &= ~DIRTY_BASIS;
+    }
+
+    void ResolveDirty() const
+    {
+        if (!m_DirtyFlags)
+            return;
+
+        UpdateCameraVectors();
+
+        if (m_DirtyFlags & DIRTY_VIEW)
+        {
+            m_ViewMat = glm::lookAt(m_Position, m_Position + m_Forward, m_Up);
+        }
+
+        if (m_DirtyFlags & DIRTY_PROJECTION)
+        {
+            m_PerspectiveProjMat = glm::perspective(glm::radians(m_FOV), m_AspectRatio, m_NearClipPlane, m_FarClipPlane);
+        }
+
+        m_ViewProjMat = m_PerspectiveProjMat * m_ViewMat;
+        m_Frustum.Extract(m_ViewProjMat);
+        m_DirtyFlags = 0;
+        m_MatrixRevision++;
+
+        if (m_bHasPendingInput)
+        {
+            m_InputLatency = std::chrono::duration<double>(Clock::now() - m_PendingInputTime).count();
+            m_bHasPendingInput = false;
+        }
     }
 
 private:
     glm::vec3 m_Position;
-    glm::vec3 m_Forward;
-    glm::vec3 m_Up;
-    glm::vec3 m_Right;
+    mutable glm::vec3 m_Forward;
+    mutable glm::vec3 m_Up;
+    mutable glm::vec3 m_Right;
     glm::vec3 m_WorldUp{glm::vec3(0.0f, 1.0f, 0.0f)};
 
     float m_Yaw;
@@ -102,7 +252,16 @@ private:
     float m_FOV{60.0f};
     float m_NearClipPlane{0.1f};
     float m_FarClipPlane{100.0f};
+    float m_AspectRatio{0.0f};
+
+    mutable uint32_t m_DirtyFlags{DIRTY_ALL};
+    mutable uint64_t m_MatrixRevision{0};
+    mutable glm::mat4 m_ViewMat;
+    mutable glm::mat4 m_PerspectiveProjMat;
+    mutable glm::mat4 m_ViewProjMat;
+    mutable Frustum m_Frustum;
 
-    glm::mat4 m_ViewMat;
-    glm::mat4 m_PerspectiveProjMat;
+    mutable Clock::time_point m_PendingInputTime;
+    mutable bool m_bHasPendingInput{false};
+    mutable double m_InputLatency{0.0};
 };
@@ -0,0 +1,293 @@
+#pragma once
+
+#include "LegitProfiler/ProfilerTask.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Set to 0 (e.g. -DPROFILER_ENABLED=0) to compile every PROFILE_SCOPE out
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+/**
+ * \brief A completed scope: interned name, nesting depth on its thread and begin/end in CpuProfiler ticks
+ */
+struct ProfilerEvent
+{
+    uint64_t Begin;
+    uint64_t End;
+    uint32_t NameId;
+    uint16_t Depth;
+    uint16_t ThreadIndex;
+};
+
+/**
+ * \brief Scope profiler with one lock-free single-producer ring per thread.
+ *
+ * Recording a scope costs two timestamp reads (rdtsc where available) and one ring write; names are interned once per
+ * call site. Once per frame the main thread calls EndFrame(), which drains every ring into GetFrameEvents(). A ring
+ * that wraps before it is drained loses its oldest events, which are counted in GetDroppedEventCount().
+ */
+class CpuProfiler
+{
+public:
+    static constexpr size_t RING_CAPACITY = 1 << 14;
+    static constexpr size_t MAX_THREADS = 64;
+
+    static uint64_t Now()
+    {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    [[nodiscard]] static double TicksToSeconds(const int64_t Ticks) { return static_cast<double>(Ticks) * s_SecondsPerTick.load(std::memory_order_relaxed); }
+
+    /**
+     * \brief Returns a stable ID for Name, shared with the profiler graphs (see legit::TaskNames)
+     */
+    static uint32_t InternName(const char* Name) { return legit::TaskNames::Intern(Name); }
+
+    static const char* GetName(const uint32_t NameId) { return legit::TaskNames::Get(NameId); }
+
+    static void SetThreadName(const char* Name)
+    {
+        ThreadBuffer* buffer = GetThreadBuffer();
+        if (buffer)
+            snprintf(buffer->Name, sizeof(buffer->Name), "%s", Name);
+    }
+
+    [[nodiscard]] static uint32_t GetThreadCount() { return s_ThreadCount.load(std::memory_order_acquire); }
+
+    /**
+     * \brief Profiler index of the calling thread (registering it if needed); MAX_THREADS if all slots are taken
+     */
+    static uint32_t GetCurrentThreadIndex()
+    {
+        const ThreadBuffer* buffer = GetThreadBuffer();
+        return buffer ? buffer->ThreadIndex : static_cast<uint32_t>(MAX_THREADS);
+    }
+
+    static const char* GetThreadName(const uint32_t ThreadIndex) { return s_Threads[ThreadIndex]->Name; }
+
+    static uint16_t EnterScope() { return s_Depth++; }
+
+    static void LeaveScope(const uint32_t NameId, const uint64_t Begin, const uint16_t Depth)
+    {
+        const uint64_t end = Now();
+        s_Depth = Depth;
+
+        ThreadBuffer* buffer = s_CurrentBuffer ? s_CurrentBuffer : GetThreadBuffer();
+        if (!buffer)
+            return;
+
+        const uint64_t index = buffer->WriteIndex.load(std::memory_order_relaxed);
+        ProfilerEvent& event = buffer->Events[index & (RING_CAPACITY - 1)];
+        event.Begin = Begin;
+        event.End = end;
+        event.NameId = NameId;
+        event.Depth = Depth;
+        event.ThreadIndex = buffer->ThreadIndex;
+        buffer->WriteIndex.store(index + 1, std::memory_order_release);
+    }
+
+    static void BeginFrame()
+    {
+        s_FrameBegin = Now();
+    }
+
+    /**
+     * \brief Drains all thread rings into the frame event list. Main thread only.
+     */
+    static void EndFrame()
+    {
+        s_FrameEnd = Now();
+        Calibrate();
+
+        s_FrameEvents.clear();
+        const uint32_t threadCount = GetThreadCount();
+        for (uint32_t i = 0; i < threadCount; i++)
+        {
+            ThreadBuffer& buffer = *s_Threads[i];
+            const uint64_t write = buffer.WriteIndex.load(std::memory_order_acquire);
+            uint64_t read = buffer.ReadIndex;
+            if (write - read > RING_CAPACITY)
+            {
+                s_DroppedEvents += write - read - RING_CAPACITY;
+                read = write - RING_CAPACITY;
+            }
+
+            const size_t firstCopied = s_FrameEvents.size();
+            for (uint64_t index = read; index < write; index++)
+                s_FrameEvents.push_back(buffer.Events[index & (RING_CAPACITY - 1)]);
+
+            // entries the writer lapped while they were being copied may be torn, including the slot it is filling now
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t writeAfter = buffer.WriteIndex.load(std::memory_order_relaxed);
+            if (writeAfter + 1 - read > RING_CAPACITY)
+            {
+                const uint64_t torn = std::min<uint64_t>(writeAfter + 1 - read - RING_CAPACITY, write - read);
+                s_FrameEvents.erase(s_FrameEvents.begin() + firstCopied, s_FrameEvents.begin() + firstCopied + torn);
+                s_DroppedEvents += torn;
+            }
+            buffer.ReadIndex = write;
+        }
+    }
+
+    /**
+     * \brief Events completed since the previous EndFrame(), on every thread, grouped by thread
+     */
+    [[nodiscard]] static const std::vector<ProfilerEvent>& GetFrameEvents() { return s_FrameEvents; }
+
+    [[nodiscard]] static uint64_t GetFrameBegin() { return s_FrameBegin; }
+
+    [[nodiscard]] static uint64_t GetFrameEnd() { return s_FrameEnd; }
+
+    [[nodiscard]] static uint64_t GetDroppedEventCount() { return s_DroppedEvents; }
+
+    /**
+     * \brief Converts the top-level scopes of one thread into ProfilerGraph tasks, relative to the frame begin
+     */
+    static void BuildProfilerTasks(std::vector<legit::ProfilerTask>& Tasks, const uint32_t ThreadIndex)
+    {
+        static constexpr uint32_t COLORS[] = {legit::Colors::turqoise, legit::Colors::peterRiver, legit::Colors::amethyst,
+                                              legit::Colors::sunFlower, legit::Colors::carrot, legit::Colors::alizarin,
+                                              legit::Colors::emerald, legit::Colors::silver};
+
+        size_t count = 0;
+        for (const ProfilerEvent& event : s_FrameEvents)
+        {
+            if (event.ThreadIndex != ThreadIndex || event.Depth != 0 || event.End < s_FrameBegin)
+                continue;
+
+            if (count == Tasks.size())
+                Tasks.emplace_back();
+            legit::ProfilerTask& task = Tasks[count++];
+            task.startTime = event.Begin > s_FrameBegin ? TicksToSeconds(static_cast<int64_t>(event.Begin - s_FrameBegin)) : 0.0;
+            task.endTime = TicksToSeconds(static_cast<int64_t>(event.End - s_FrameBegin));
+            task.nameId = event.NameId;
+            task.color = COLORS[event.NameId % (sizeof(COLORS) / sizeof(COLORS[0]))];
+        }
+        Tasks.resize(count);
+    }
+
+private:
+    struct ThreadBuffer
+    {
+        alignas(64) std::atomic<uint64_t> WriteIndex{0};
+        alignas(64) uint64_t ReadIndex{0};
+        uint16_t ThreadIndex{0};
+        char Name[32]{};
+        ProfilerEvent Events[RING_CAPACITY];
+    };
+
+    static ThreadBuffer* GetThreadBuffer()
+    {
+        if (s_CurrentBuffer)
+            return s_CurrentBuffer;
+
+        std::lock_guard lock(s_ThreadMutex);
+        const uint32_t index = s_ThreadCount.load(std::memory_order_relaxed);
+        if (index == MAX_THREADS)
+            return nullptr;
+
+        // buffers outlive their threads so that events recorded just before a thread exits can still be drained
+        s_Threads[index] = std::make_unique<ThreadBuffer>();
+        s_Threads[index]->ThreadIndex = static_cast<uint16_t>(index);
+        snprintf(s_Threads[index]->Name, sizeof(s_Threads[index]->Name), "Thread %u", index);
+        s_CurrentBuffer = s_Threads[index].get();
+        s_ThreadCount.store(index + 1, std::memory_order_release);
+        return s_CurrentBuffer;
+    }
+
+    static void Calibrate()
+    {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        // the TSC rate is derived from the steady clock over the whole run, so it converges within the first frames
+        const uint64_t ticks = Now();
+        const auto time = std::chrono::steady_clock::now();
+        if (!s_bCalibrationStarted)
+        {
+            s_CalibrationTicks = ticks;
+            s_CalibrationTime = time;
+            s_bCalibrationStarted = true;
+            return;
+        }
+
+        const double seconds = std::chrono::duration<double>(time - s_CalibrationTime).count();
+        if (seconds > 0.01 && ticks > s_CalibrationTicks)
+            s_SecondsPerTick.store(seconds / static_cast<double>(ticks - s_CalibrationTicks), std::memory_order_relaxed);
+#endif
+    }
+
+    static inline std::mutex s_ThreadMutex;
+    static inline std::unique_ptr<ThreadBuffer> s_Threads[MAX_THREADS];
+    static inline std::atomic<uint32_t> s_ThreadCount{0};
+    static inline thread_local ThreadBuffer* s_CurrentBuffer{nullptr};
+    static inline thread_local uint16_t s_Depth{0};
+
+    static inline std::atomic<double> s_SecondsPerTick{1e-9};
+    static inline bool s_bCalibrationStarted{false};
+    static inline uint64_t s_CalibrationTicks{0};
+    static inline std::chrono::steady_clock::time_point s_CalibrationTime;
+
+    static inline uint64_t s_FrameBegin{0};
+    static inline uint64_t s_FrameEnd{0};
+    static inline uint64_t s_DroppedEvents{0};
+    static inline std::vector<ProfilerEvent> s_FrameEvents;
+};
+
+/**
+ * \brief Records one ProfilerEvent for its lifetime. Use through PROFILE_SCOPE.
+ */
+class CpuProfileScope
+{
+public:
+    explicit CpuProfileScope(const uint32_t NameId)
+        : m_NameId(NameId), m_Depth(CpuProfiler::EnterScope()), m_Begin(CpuProfiler::Now())
+    {
+    }
+
+    ~CpuProfileScope()
+    {
+        CpuProfiler::LeaveScope(m_NameId, m_Begin, m_Depth);
+    }
+
+    CpuProfileScope(const CpuProfileScope&) = delete;
+    CpuProfileScope& operator=(const CpuProfileScope&) = delete;
+
+private:
+    uint32_t m_NameId;
+    uint16_t m_Depth;
+    uint64_t m_Begin;
+};
+
+#define PROFILE_CONCAT_INNER(A, B) A##B
+#define PROFILE_CONCAT(A, B) PROFILE_CONCAT_INNER(A, B)
+
+#if PROFILER_ENABLED
+/**
+ * \brief Profiles the enclosing scope under Name (a string literal)
+ */
+#define PROFILE_SCOPE(Name)                                                                                            \
+    static const uint32_t PROFILE_CONCAT(profileNameId, __LINE__) = CpuProfiler::InternName(Name);                     \
+    CpuProfileScope PROFILE_CONCAT(profileScope, __LINE__)(PROFILE_CONCAT(profileNameId, __LINE__))
+#else
+#define PROFILE_SCOPE(Name) ((void)0)
+#endif
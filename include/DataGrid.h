@@ -0,0 +1,819 @@
+#pragma once
+
+#include "AsyncTask.h"
+#include "JobSystem.h"
+#include "TextMatcher.h"
+
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+enum class DataGridColumnType : uint8_t
+{
+    INT64,
+    DOUBLE,
+    STRING,
+};
+
+/**
+ * \brief One column of a DataGridTable. Only the vectors of its Type are used; strings are stored back to back, row r
+ * spanning StringData[StringOffsets[r], StringOffsets[r + 1]).
+ */
+struct DataGridColumn
+{
+    static constexpr size_t STRING_PREFIX_BYTES = 11;
+
+    std::string Name;
+    DataGridColumnType Type{DataGridColumnType::INT64};
+    std::vector<int64_t> Ints;
+    std::vector<double> Doubles;
+    std::vector<uint32_t> StringOffsets;
+    std::vector<char> StringData;
+
+    [[nodiscard]] std::string_view GetString(const uint32_t Row) const
+    {
+        return std::string_view(StringData.data() + StringOffsets[Row], StringOffsets[Row + 1] - StringOffsets[Row]);
+    }
+
+    /**
+     * \brief Three-way comparison of two rows: numbers by value, strings bytewise
+     */
+    [[nodiscard]] int Compare(const uint32_t A, const uint32_t B) const
+    {
+        switch (Type)
+        {
+        case DataGridColumnType::INT64:
+            return (Ints[A] > Ints[B]) - (Ints[A] < Ints[B]);
+        case DataGridColumnType::DOUBLE:
+        {
+            const uint64_t a = OrderedBits(Doubles[A]);
+            const uint64_t b = OrderedBits(Doubles[B]);
+            return (a > b) - (a < b);
+        }
+        case DataGridColumnType::STRING:
+            return GetString(A).compare(GetString(B));
+        }
+        return 0;
+    }
+
+    /**
+     * \brief 96-bit key ordered like Compare(), compared as (High, Low). Exact for numbers; for strings the first
+     * STRING_PREFIX_BYTES bytes (zero-padded) followed by the length capped at STRING_PREFIX_BYTES, so equal keys below that
+     * length mean equal strings (see IsSortPrefixExact).
+     */
+    struct SortPrefix
+    {
+        uint64_t High;
+        uint32_t Low;
+    };
+
+    [[nodiscard]] SortPrefix GetSortPrefix(const uint32_t Row) const
+    {
+        switch (Type)
+        {
+        case DataGridColumnType::INT64:
+            return {static_cast<uint64_t>(Ints[Row]) ^ (1ull << 63), 0};
+        case DataGridColumnType::DOUBLE:
+            return {OrderedBits(Doubles[Row]), 0};
+        case DataGridColumnType::STRING:
+        {
+            const std::string_view text = GetString(Row);
+            const auto byteAt = [&text](const size_t Index) { return Index < text.size() ? static_cast<unsigned char>(text[Index]) : 0u; };
+            uint64_t high = 0;
+            for (size_t i = 0; i < 8; i++)
+                high = (high << 8) | byteAt(i);
+            uint32_t low = 0;
+            for (size_t i = 8; i < STRING_PREFIX_BYTES; i++)
+                low = (low << 8) | byteAt(i);
+            return {high, (low << 8) | static_cast<uint32_t>(std::min<size_t>(text.size(), STRING_PREFIX_BYTES))};
+        }
+        }
+        return {0, 0};
+    }
+
+    /**
+     * \brief Whether two rows with this (ascending) sort prefix are equal in this column
+     */
+    [[nodiscard]] bool IsSortPrefixExact(const uint32_t Low) const
+    {
+        return Type != DataGridColumnType::STRING || (Low & 0xFF) < STRING_PREFIX_BYTES;
+    }
+
+private:
+    // IEEE 754 bits flipped so that unsigned comparison orders them like the values (-0 before +0, NaNs at the ends)
+    static uint64_t OrderedBits(const double Value)
+    {
+        uint64_t bits;
+        memcpy(&bits, &Value, sizeof(bits));
+        return (bits >> 63) ? ~bits : bits | (1ull << 63);
+    }
+};
+
+/**
+ * \brief Columnar data source of a DataGrid. Immutable once handed to the grid: sorting and filtering read it concurrently.
+ */
+struct DataGridTable
+{
+    std::vector<DataGridColumn> Columns;
+    uint32_t RowCount{0};
+};
+
+struct DataGridSortKey
+{
+    uint32_t Column{0};
+    bool bDescending{false};
+};
+
+/**
+ * \brief Which rows of Source to show and in which order
+ */
+struct DataGridQuery
+{
+    std::shared_ptr<const DataGridTable> Source;
+    std::vector<DataGridSortKey> SortKeys;
+    std::string FilterText;
+    TextMatcherSyntax FilterSyntax{TextMatcherSyntax::SUBSTRING};
+    // STRING column the filter matches against; -1 or any other column disables filtering
+    int32_t FilterColumn{-1};
+    // one bit per row that passed a filter this one narrows (TextMatcher::IsNarrowingOf): no other row can pass, so only
+    // these are matched. With bCandidatesPass they are the result of this very filter and nothing is matched at all.
+    std::shared_ptr<const std::vector<uint64_t>> Candidates;
+    bool bCandidatesPass{false};
+};
+
+/**
+ * \brief Virtualized table over a columnar DataGridTable with millions of rows.
+ *
+ * Sorting (multi-key, from the table headers) and filtering never run on the UI thread: every change issues a query that
+ * the job system evaluates in parallel into a new row permutation, which is handed back through an atomic pointer and
+ * swapped in at the start of the next Draw(). Until then the previous permutation stays on screen, so the UI keeps its
+ * frame rate however long the query takes; a newer query makes older ones stop at their next chunk. Only the rows in the
+ * visible scroll window are formatted (ImGuiListClipper).
+ *
+ * The owning JobSystem needs at least one thread besides the one calling Draw().
+ */
+class DataGrid
+{
+public:
+    // below this many rows per chunk, splitting costs more than it saves
+    static constexpr size_t MIN_CHUNK_ROWS = 16384;
+    // above it a chunk runs long enough to delay a thread that picks it up while waiting on its own jobs
+    static constexpr size_t MAX_CHUNK_ROWS = 262144;
+
+    struct Stats
+    {
+        uint32_t SourceRows{0};
+        uint32_t ShownRows{0};
+        bool bBusy{false};
+        double LastQueryMilliseconds{0.0};
+    };
+
+    explicit DataGrid(JobSystem& Jobs) : m_Jobs(Jobs) {}
+
+    ~DataGrid()
+    {
+        // stale queries stop at their next chunk
+        m_LatestGeneration.fetch_add(1, std::memory_order_relaxed);
+        while (m_InFlight.load(std::memory_order_acquire) > 0)
+            std::this_thread::yield();
+        delete m_Published.exchange(nullptr, std::memory_order_acquire);
+    }
+
+    DataGrid(const DataGrid&) = delete;
+    DataGrid& operator=(const DataGrid&) = delete;
+
+    void SetSource(std::shared_ptr<const DataGridTable> Source)
+    {
+        m_Source = std::move(Source);
+        m_FilterColumn = -1;
+        for (size_t column = 0; m_Source && column < m_Source->Columns.size(); column++)
+        {
+            if (m_Source->Columns[column].Type == DataGridColumnType::STRING)
+            {
+                m_FilterColumn = static_cast<int32_t>(column);
+                break;
+            }
+        }
+        m_SortKeys.clear();
+        m_bSortSpecsPending = true;
+        IssueQuery();
+    }
+
+    [[nodiscard]] Stats GetStats() const
+    {
+        Stats stats;
+        stats.SourceRows = m_Source ? m_Source->RowCount : 0;
+        stats.ShownRows = m_View ? static_cast<uint32_t>(m_View->Rows.size()) : 0;
+        stats.bBusy = m_InFlight.load(std::memory_order_relaxed) > 0;
+        stats.LastQueryMilliseconds = m_View ? m_View->Milliseconds : 0.0;
+        return stats;
+    }
+
+    /**
+     * \brief Filter controls and the table, filling Size (0 = remaining space)
+     */
+    void Draw(const char* StrId, const ImVec2& Size = ImVec2(0.0f, 0.0f))
+    {
+        ConsumePublishedView();
+        ImGui::PushID(StrId);
+
+        if (m_Source)
+        {
+            ImGui::SetNextItemWidth(ImGui::GetFontSize() * 16.0f);
+            if (ImGui::InputTextWithHint("##Filter", "Filter (incl,-excl)", m_FilterBuffer, sizeof(m_FilterBuffer)))
+                IssueQuery();
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(ImGui::GetFontSize() * 10.0f);
+            const char* filterColumnName = m_FilterColumn >= 0 ? m_Source->Columns[m_FilterColumn].Name.c_str() : "(none)";
+            if (ImGui::BeginCombo("##FilterColumn", filterColumnName))
+            {
+                for (size_t column = 0; column < m_Source->Columns.size(); column++)
+                {
+                    if (m_Source->Columns[column].Type != DataGridColumnType::STRING)
+                        continue;
+                    if (ImGui::Selectable(m_Source->Columns[column].Name.c_str(), m_FilterColumn == static_cast<int32_t>(column)))
+                    {
+                        m_FilterColumn = static_cast<int32_t>(column);
+                        IssueQuery();
+                    }
+                }
+                ImGui::EndCombo();
+            }
+            ImGui::SameLine();
+            if (ImGui::Checkbox("Glob", &m_bGlobFilter))
+                IssueQuery();
+            if (ImGui::IsItemHovered())
+                ImGui::SetTooltip("Terms with * or ? match whole values");
+        }
+
+        const Stats stats = GetStats();
+        ImGui::SameLine();
+        ImGui::Text("%u of %u rows%s", stats.ShownRows, stats.SourceRows, stats.bBusy ? ", updating..." : "");
+        if (m_View && !stats.bBusy)
+        {
+            ImGui::SameLine();
+            ImGui::TextDisabled("(%.1f ms)", stats.LastQueryMilliseconds);
+        }
+
+        // rows on screen and the headers come from the same table as the permutation, even while a new source is queried
+        const DataGridTable* table = m_View ? m_View->Source.get() : nullptr;
+        const int columnCount = table ? static_cast<int>(table->Columns.size()) : 0;
+        constexpr ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_SortMulti | ImGuiTableFlags_SortTristate |
+                                          ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter |
+                                          ImGuiTableFlags_BordersV | ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable |
+                                          ImGuiTableFlags_Hideable;
+        if (columnCount > 0 && ImGui::BeginTable("Rows", columnCount, flags, Size))
+        {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            for (const DataGridColumn& column : table->Columns)
+                ImGui::TableSetupColumn(column.Name.c_str());
+            ImGui::TableHeadersRow();
+
+            // the headers of a table that is being replaced keep their sort specs until the new source is on screen
+            ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs();
+            if (sortSpecs && table == m_Source.get())
+            {
+                if (sortSpecs->SpecsDirty || m_bSortSpecsPending)
+                {
+                    ReadSortSpecs(*sortSpecs);
+                    sortSpecs->SpecsDirty = false;
+                }
+            }
+
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(m_View->Rows.size()));
+            while (clipper.Step())
+            {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+                {
+                    const uint32_t sourceRow = m_View->Rows[static_cast<size_t>(row)];
+                    ImGui::TableNextRow();
+                    for (int column = 0; column < columnCount; column++)
+                    {
+                        ImGui::TableSetColumnIndex(column);
+                        DrawCell(table->Columns[column], sourceRow);
+                    }
+                }
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::PopID();
+    }
+
+    /**
+     * \brief Evaluates Query on the job system and writes the resulting permutation of source rows to OutRows, and when the
+     * filter was matched, the rows that passed it (one bit each) to OutPassed. Blocks the caller (which helps with the work);
+     * returns false, leaving the outputs unspecified, once *LatestGeneration moves past Generation.
+     */
+    static bool Evaluate(JobSystem& Jobs, const DataGridQuery& Query, std::vector<uint32_t>& OutRows, std::vector<uint64_t>* OutPassed = nullptr,
+                         const std::atomic<uint64_t>* LatestGeneration = nullptr, const uint64_t Generation = 0)
+    {
+        const auto isStale = [LatestGeneration, Generation]()
+        {
+            return LatestGeneration && LatestGeneration->load(std::memory_order_relaxed) != Generation;
+        };
+
+        const DataGridTable& table = *Query.Source;
+        const uint32_t rowCount = table.RowCount;
+        const TextMatcher matcher(Query.FilterText, Query.FilterSyntax);
+        const bool bFilterColumnValid = Query.FilterColumn >= 0 && static_cast<size_t>(Query.FilterColumn) < table.Columns.size() &&
+                                        table.Columns[Query.FilterColumn].Type == DataGridColumnType::STRING;
+        const DataGridColumn* filterColumn = matcher.IsActive() && bFilterColumnValid ? &table.Columns[Query.FilterColumn] : nullptr;
+        const std::vector<uint64_t>* candidates = filterColumn ? Query.Candidates.get() : nullptr;
+        const bool bMatch = filterColumn && !(candidates && Query.bCandidatesPass);
+        std::vector<uint64_t>* passed = bMatch ? OutPassed : nullptr;
+        if (passed)
+            passed->assign((static_cast<size_t>(rowCount) + 63) / 64, 0);
+
+        std::vector<DataGridSortKey> sortKeys;
+        for (const DataGridSortKey& key : Query.SortKeys)
+        {
+            if (key.Column < table.Columns.size())
+                sortKeys.push_back(key);
+        }
+
+        // whole 64-row words per chunk, so that chunks never share a word of the pass masks
+        const size_t chunkCount = GetChunkCount(Jobs, rowCount);
+        const size_t chunkRows = (static_cast<size_t>(rowCount) + chunkCount * 64 - 1) / (chunkCount * 64) * 64;
+
+        // nothing to do but count
+        if (!filterColumn && sortKeys.empty())
+        {
+            OutRows.resize(rowCount);
+            Jobs.ParallelFor(0, rowCount, [&OutRows](const size_t First, const size_t Last)
+            {
+                for (size_t row = First; row < Last; row++)
+                    OutRows[row] = static_cast<uint32_t>(row);
+            }, chunkRows);
+            return !isStale();
+        }
+
+        // 1. filter each chunk and compute the sort prefix of the surviving rows
+        const DataGridColumn* primary = sortKeys.empty() ? nullptr : &table.Columns[sortKeys[0].Column];
+        const uint64_t prefixFlip = !sortKeys.empty() && sortKeys[0].bDescending ? ~0ull : 0ull;
+        std::vector<std::vector<SortEntry>> chunkEntries(chunkCount);
+        Jobs.ParallelFor(0, chunkCount, [&](const size_t First, const size_t Last)
+        {
+            for (size_t chunk = First; chunk < Last && !isStale(); chunk++)
+            {
+                const uint32_t begin = static_cast<uint32_t>(std::min<size_t>(rowCount, chunk * chunkRows));
+                const uint32_t end = static_cast<uint32_t>(std::min<size_t>(rowCount, begin + chunkRows));
+                std::vector<SortEntry>& entries = chunkEntries[chunk];
+                if (!filterColumn)
+                    entries.reserve(end - begin);
+                const auto addRow = [&](const uint32_t Row)
+                {
+                    if (bMatch && !matcher.Pass(filterColumn->GetString(Row)))
+                        return;
+                    if (passed)
+                        (*passed)[Row / 64] |= 1ull << (Row % 64);
+                    const DataGridColumn::SortPrefix prefix = primary ? primary->GetSortPrefix(Row) : DataGridColumn::SortPrefix{0, 0};
+                    entries.push_back({prefix.High ^ prefixFlip, prefix.Low ^ static_cast<uint32_t>(prefixFlip), Row});
+                };
+                if (candidates)
+                {
+                    for (size_t word = begin / 64; word < (static_cast<size_t>(end) + 63) / 64; word++)
+                    {
+                        for (uint64_t bits = (*candidates)[word]; bits != 0; bits &= bits - 1)
+                            addRow(static_cast<uint32_t>(word * 64 + std::countr_zero(bits)));
+                    }
+                }
+                else
+                {
+                    for (uint32_t row = begin; row < end; row++)
+                        addRow(row);
+                }
+            }
+        }, 1);
+        if (isStale())
+            return false;
+
+        // 2. concatenate; each chunk becomes one sorted run
+        std::vector<size_t> runBounds(chunkCount + 1, 0);
+        for (size_t chunk = 0; chunk < chunkCount; chunk++)
+            runBounds[chunk + 1] = runBounds[chunk] + chunkEntries[chunk].size();
+        const size_t entryCount = runBounds.back();
+        std::vector<SortEntry> entries(entryCount);
+        const RowOrder order{&table, sortKeys.data(), sortKeys.size(), prefixFlip};
+        Jobs.ParallelFor(0, chunkCount, [&](const size_t First, const size_t Last)
+        {
+            for (size_t chunk = First; chunk < Last && !isStale(); chunk++)
+            {
+                std::copy(chunkEntries[chunk].begin(), chunkEntries[chunk].end(), entries.begin() + static_cast<ptrdiff_t>(runBounds[chunk]));
+                std::vector<SortEntry>().swap(chunkEntries[chunk]);
+                if (!sortKeys.empty())
+                    std::sort(entries.begin() + static_cast<ptrdiff_t>(runBounds[chunk]), entries.begin() + static_cast<ptrdiff_t>(runBounds[chunk + 1]), order);
+            }
+        }, 1);
+        if (isStale())
+            return false;
+
+        // 3. merge runs pairwise until one is left; each merge is cut into independent parts along its merge path
+        const SortEntry* sorted = entries.data();
+        std::vector<SortEntry> scratch;
+        if (!sortKeys.empty() && chunkCount > 1)
+        {
+            scratch.resize(entryCount);
+            SortEntry* source = entries.data();
+            SortEntry* target = scratch.data();
+            while (runBounds.size() > 2)
+            {
+                std::vector<MergePart> parts;
+                std::vector<size_t> mergedBounds;
+                for (size_t run = 0; run + 1 < runBounds.size(); run += 2)
+                {
+                    const size_t aBegin = runBounds[run];
+                    const size_t bBegin = runBounds[run + 1];
+                    const size_t bEnd = run + 2 < runBounds.size() ? runBounds[run + 2] : bBegin;
+                    const size_t length = bEnd - aBegin;
+                    const size_t partCount = std::max<size_t>(1, (length * chunkCount + entryCount - 1) / std::max<size_t>(1, entryCount));
+                    for (size_t part = 0; part < partCount; part++)
+                        parts.push_back({aBegin, bBegin, bEnd, length * part / partCount, length * (part + 1) / partCount});
+                    mergedBounds.push_back(aBegin);
+                }
+                mergedBounds.push_back(entryCount);
+
+                Jobs.ParallelFor(0, parts.size(), [&](const size_t First, const size_t Last)
+                {
+                    for (size_t part = First; part < Last && !isStale(); part++)
+                        Merge(source, target, parts[part], order);
+                }, 1);
+                if (isStale())
+                    return false;
+
+                runBounds = std::move(mergedBounds);
+                std::swap(source, target);
+            }
+            sorted = source;
+        }
+
+        OutRows.resize(entryCount);
+        Jobs.ParallelFor(0, entryCount, [&OutRows, sorted](const size_t First, const size_t Last)
+        {
+            for (size_t entry = First; entry < Last; entry++)
+                OutRows[entry] = sorted[entry].Row;
+        }, chunkRows);
+        return !isStale();
+    }
+
+private:
+    struct SortEntry
+    {
+        uint64_t PrefixHigh;
+        uint32_t PrefixLow;
+        uint32_t Row;
+    };
+
+    /**
+     * \brief Strict total order: sort prefix, then the sort keys, then the source row (so the result does not depend on
+     * how rows were split into chunks). The primary key is skipped when equal prefixes already decide it.
+     */
+    struct RowOrder
+    {
+        const DataGridTable* Table;
+        const DataGridSortKey* Keys;
+        size_t KeyCount;
+        // ~0 when the primary key is descending, undoes the flip of the stored prefixes
+        uint64_t PrefixFlip;
+
+        bool operator()(const SortEntry& A, const SortEntry& B) const
+        {
+            if (A.PrefixHigh != B.PrefixHigh)
+                return A.PrefixHigh < B.PrefixHigh;
+            if (A.PrefixLow != B.PrefixLow)
+                return A.PrefixLow < B.PrefixLow;
+            size_t key = 0;
+            if (KeyCount > 0 && Table->Columns[Keys[0].Column].IsSortPrefixExact(A.PrefixLow ^ static_cast<uint32_t>(PrefixFlip)))
+                key = 1;
+            for (; key < KeyCount; key++)
+            {
+                const int compare = Table->Columns[Keys[key].Column].Compare(A.Row, B.Row);
+                if (compare != 0)
+                    return Keys[key].bDescending ? compare > 0 : compare < 0;
+            }
+            return A.Row < B.Row;
+        }
+    };
+
+    /**
+     * \brief Output positions [First, Last) of merging runs [ABegin, BBegin) and [BBegin, BEnd), relative to ABegin
+     */
+    struct MergePart
+    {
+        size_t ABegin;
+        size_t BBegin;
+        size_t BEnd;
+        size_t First;
+        size_t Last;
+    };
+
+    struct View
+    {
+        std::vector<uint32_t> Rows;
+        std::shared_ptr<const DataGridTable> Source;
+        uint64_t Generation{0};
+        double Milliseconds{0.0};
+        // the filter this view passed, for narrowing the next one
+        std::string FilterText;
+        TextMatcherSyntax FilterSyntax{TextMatcherSyntax::SUBSTRING};
+        int32_t FilterColumn{-1};
+        std::shared_ptr<const std::vector<uint64_t>> Passed;
+    };
+
+    struct PendingQuery
+    {
+        DataGridQuery Query;
+        uint64_t Generation{0};
+    };
+
+    static size_t GetChunkCount(const JobSystem& Jobs, const size_t RowCount)
+    {
+        const size_t count = std::max<size_t>(Jobs.GetThreadCount() * 4, (RowCount + MAX_CHUNK_ROWS - 1) / MAX_CHUNK_ROWS);
+        return std::clamp<size_t>(count, 1, std::max<size_t>(1, RowCount / MIN_CHUNK_ROWS));
+    }
+
+    /**
+     * \brief Number of elements of A among the first Diagonal outputs of merging A and B
+     */
+    static size_t FindMergePath(const SortEntry* A, const size_t ACount, const SortEntry* B, const size_t BCount, const size_t Diagonal,
+                                const RowOrder& Order)
+    {
+        size_t low = Diagonal > BCount ? Diagonal - BCount : 0;
+        size_t high = std::min(Diagonal, ACount);
+        while (low < high)
+        {
+            const size_t middle = low + (high - low) / 2;
+            if (Order(A[middle], B[Diagonal - middle - 1]))
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        return low;
+    }
+
+    static void Merge(const SortEntry* Source, SortEntry* Target, const MergePart& Part, const RowOrder& Order)
+    {
+        const SortEntry* a = Source + Part.ABegin;
+        const SortEntry* b = Source + Part.BBegin;
+        const size_t aCount = Part.BBegin - Part.ABegin;
+        const size_t bCount = Part.BEnd - Part.BBegin;
+        const size_t aFirst = FindMergePath(a, aCount, b, bCount, Part.First, Order);
+        const size_t aLast = FindMergePath(a, aCount, b, bCount, Part.Last, Order);
+        std::merge(a + aFirst, a + aLast, b + (Part.First - aFirst), b + (Part.Last - aLast), Target + Part.ABegin + Part.First, Order);
+    }
+
+    static void DrawCell(const DataGridColumn& Column, const uint32_t Row)
+    {
+        switch (Column.Type)
+        {
+        case DataGridColumnType::INT64:
+            ImGui::Text("%lld", static_cast<long long>(Column.Ints[Row]));
+            break;
+        case DataGridColumnType::DOUBLE:
+            ImGui::Text("%.3f", Column.Doubles[Row]);
+            break;
+        case DataGridColumnType::STRING:
+        {
+            const std::string_view text = Column.GetString(Row);
+            ImGui::TextUnformatted(text.data(), text.data() + text.size());
+            break;
+        }
+        }
+    }
+
+    void ReadSortSpecs(const ImGuiTableSortSpecs& SortSpecs)
+    {
+        m_bSortSpecsPending = false;
+        std::vector<DataGridSortKey> sortKeys;
+        for (int spec = 0; spec < SortSpecs.SpecsCount; spec++)
+        {
+            const ImGuiTableColumnSortSpecs& columnSpec = SortSpecs.Specs[spec];
+            sortKeys.push_back({static_cast<uint32_t>(columnSpec.ColumnIndex), columnSpec.SortDirection == ImGuiSortDirection_Descending});
+        }
+
+        const bool bChanged = sortKeys.size() != m_SortKeys.size() ||
+                              !std::equal(sortKeys.begin(), sortKeys.end(), m_SortKeys.begin(), [](const DataGridSortKey& A, const DataGridSortKey& B)
+                                          { return A.Column == B.Column && A.bDescending == B.bDescending; });
+        if (bChanged)
+        {
+            m_SortKeys = std::move(sortKeys);
+            IssueQuery();
+        }
+    }
+
+    void IssueQuery()
+    {
+        if (!m_Source)
+            return;
+
+        // the job owns the query; capturing only pointers keeps the job payload trivially destructible, so nothing (the
+        // source table in particular) stays referenced by a recycled job slot
+        const TextMatcherSyntax syntax = m_bGlobFilter ? TextMatcherSyntax::GLOB : TextMatcherSyntax::SUBSTRING;
+
+        // typing onto the filter only rematches the rows that passed the one on screen; a sort change matches nothing
+        std::shared_ptr<const std::vector<uint64_t>> candidates;
+        bool bCandidatesPass = false;
+        if (m_View && m_View->Passed && m_View->Source == m_Source && m_View->FilterColumn == m_FilterColumn)
+        {
+            const TextMatcher matcher(m_FilterBuffer, syntax);
+            const TextMatcher previous(m_View->FilterText, m_View->FilterSyntax);
+            if (matcher.IsNarrowingOf(previous))
+            {
+                candidates = m_View->Passed;
+                bCandidatesPass = matcher.GetText() == previous.GetText() && syntax == m_View->FilterSyntax;
+            }
+        }
+
+        PendingQuery* pending = new PendingQuery{{m_Source, m_SortKeys, m_FilterBuffer, syntax, m_FilterColumn, std::move(candidates), bCandidatesPass},
+                                                 m_LatestGeneration.fetch_add(1, std::memory_order_relaxed) + 1};
+
+        m_InFlight.fetch_add(1, std::memory_order_relaxed);
+        m_Jobs.Run([this, pending]()
+        {
+            const std::unique_ptr<PendingQuery> query(pending);
+            const auto begin = std::chrono::steady_clock::now();
+            std::vector<uint32_t> rows;
+            std::vector<uint64_t> passed;
+            if (Evaluate(m_Jobs, query->Query, rows, &passed, &m_LatestGeneration, query->Generation))
+            {
+                View* view = new View{std::move(rows), query->Query.Source, query->Generation,
+                                      std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count(),
+                                      query->Query.FilterText, query->Query.FilterSyntax, query->Query.FilterColumn, nullptr};
+                if (!passed.empty())
+                    view->Passed = std::make_shared<const std::vector<uint64_t>>(std::move(passed));
+                else if (query->Query.bCandidatesPass)
+                    view->Passed = query->Query.Candidates;
+                // a view that was never picked up is superseded by this one
+                delete m_Published.exchange(view, std::memory_order_acq_rel);
+            }
+            m_InFlight.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    void ConsumePublishedView()
+    {
+        View* view = m_Published.exchange(nullptr, std::memory_order_acquire);
+        if (!view)
+            return;
+        if (view->Generation != m_LatestGeneration.load(std::memory_order_relaxed))
+        {
+            Retire(view);
+            return;
+        }
+
+        // the previous view may hold the last reference to a replaced source table: free that on a worker
+        Retire(m_View.release());
+        m_View.reset(view);
+    }
+
+    void Retire(View* Old)
+    {
+        if (Old)
+            m_Jobs.Run([Old]() { delete Old; });
+    }
+
+    JobSystem& m_Jobs;
+    std::shared_ptr<const DataGridTable> m_Source;
+    std::vector<DataGridSortKey> m_SortKeys;
+    char m_FilterBuffer[256]{};
+    int32_t m_FilterColumn{-1};
+    bool m_bGlobFilter{false};
+    bool m_bSortSpecsPending{false};
+
+    std::unique_ptr<View> m_View;
+    std::atomic<View*> m_Published{nullptr};
+    std::atomic<uint64_t> m_LatestGeneration{0};
+    std::atomic<uint32_t> m_InFlight{0};
+};
+
+/**
+ * \brief Synthetic table for the data grid window: ID, Name, Category, Value, Timestamp. Rows are a function of their index
+ * only, so the content does not depend on the thread count.
+ */
+inline std::shared_ptr<DataGridTable> MakeDemoDataGridTable(JobSystem& Jobs, const uint32_t RowCount)
+{
+    static constexpr const char* ADJECTIVES[] = {"amber", "brisk", "cobalt", "dusty", "eager", "frosty", "gilded", "hollow",
+                                                 "ivory", "jade", "keen", "lunar", "misty", "noble", "opal", "quiet"};
+    static constexpr const char* NOUNS[] = {"falcon", "harbor", "meadow", "beacon", "canyon", "ember", "glacier", "lantern",
+                                            "orchid", "pylon", "quarry", "relay", "summit", "turbine", "vessel", "willow"};
+    static constexpr const char* CATEGORIES[] = {"Sensor", "Actuator", "Controller", "Gateway", "Camera", "Battery", "Pump", "Valve"};
+
+    const auto hashRow = [](uint64_t Row)
+    {
+        // splitmix64
+        Row += 0x9E3779B97F4A7C15ull;
+        Row = (Row ^ (Row >> 30)) * 0xBF58476D1CE4E5B9ull;
+        Row = (Row ^ (Row >> 27)) * 0x94D049BB133111EBull;
+        return Row ^ (Row >> 31);
+    };
+
+    auto table = std::make_shared<DataGridTable>();
+    table->RowCount = RowCount;
+    table->Columns.resize(5);
+    DataGridColumn& id = table->Columns[0];
+    DataGridColumn& name = table->Columns[1];
+    DataGridColumn& category = table->Columns[2];
+    DataGridColumn& value = table->Columns[3];
+    DataGridColumn& timestamp = table->Columns[4];
+    id.Name = "ID";
+    name.Name = "Name";
+    name.Type = DataGridColumnType::STRING;
+    category.Name = "Category";
+    category.Type = DataGridColumnType::STRING;
+    value.Name = "Value";
+    value.Type = DataGridColumnType::DOUBLE;
+    timestamp.Name = "Timestamp";
+    id.Ints.resize(RowCount);
+    value.Doubles.resize(RowCount);
+    timestamp.Ints.resize(RowCount);
+    name.StringOffsets.resize(static_cast<size_t>(RowCount) + 1);
+    category.StringOffsets.resize(static_cast<size_t>(RowCount) + 1);
+
+    // strings are written per chunk, then the chunks are concatenated
+    const size_t chunkRows = DataGrid::MAX_CHUNK_ROWS;
+    const size_t chunkCount = (static_cast<size_t>(RowCount) + chunkRows - 1) / chunkRows;
+    std::vector<std::vector<char>> nameChunks(chunkCount);
+    std::vector<std::vector<char>> categoryChunks(chunkCount);
+    Jobs.ParallelFor(0, chunkCount, [&](const size_t First, const size_t Last)
+    {
+        char buffer[64];
+        for (size_t chunk = First; chunk < Last; chunk++)
+        {
+            const uint32_t begin = static_cast<uint32_t>(chunk * chunkRows);
+            const uint32_t end = static_cast<uint32_t>(std::min<size_t>(RowCount, begin + chunkRows));
+            for (uint32_t row = begin; row < end; row++)
+            {
+                const uint64_t hash = hashRow(row);
+                id.Ints[row] = row;
+                value.Doubles[row] = static_cast<double>(hash >> 11) * (1000.0 / 9007199254740992.0);
+                timestamp.Ints[row] = 1700000000000ll + static_cast<int64_t>((hash >> 20) % 86400000ull);
+
+                const int length = snprintf(buffer, sizeof(buffer), "%s_%s_%u", ADJECTIVES[hash & 15], NOUNS[(hash >> 4) & 15],
+                                            static_cast<unsigned>((hash >> 8) % 10000));
+                name.StringOffsets[row + 1] = static_cast<uint32_t>(length);
+                nameChunks[chunk].insert(nameChunks[chunk].end(), buffer, buffer + length);
+
+                const char* categoryName = CATEGORIES[(hash >> 40) & 7];
+                const size_t categoryLength = strlen(categoryName);
+                category.StringOffsets[row + 1] = static_cast<uint32_t>(categoryLength);
+                categoryChunks[chunk].insert(categoryChunks[chunk].end(), categoryName, categoryName + categoryLength);
+            }
+        }
+    }, 1);
+
+    const auto concatenate = [&Jobs, chunkCount, chunkRows, RowCount](DataGridColumn& Column, std::vector<std::vector<char>>& Chunks)
+    {
+        std::vector<size_t> chunkOffsets(chunkCount + 1, 0);
+        for (size_t chunk = 0; chunk < chunkCount; chunk++)
+            chunkOffsets[chunk + 1] = chunkOffsets[chunk] + Chunks[chunk].size();
+        Column.StringData.resize(chunkOffsets.back());
+        Jobs.ParallelFor(0, chunkCount, [&](const size_t First, const size_t Last)
+        {
+            for (size_t chunk = First; chunk < Last; chunk++)
+            {
+                std::copy(Chunks[chunk].begin(), Chunks[chunk].end(), Column.StringData.begin() + static_cast<ptrdiff_t>(chunkOffsets[chunk]));
+                std::vector<char>().swap(Chunks[chunk]);
+                // lengths -> offsets. The last row's length slot is the next chunk's first offset, written by that chunk;
+                // it is not needed, as the last row ends where the next chunk's data begins
+                const size_t begin = chunk * chunkRows;
+                const size_t end = std::min<size_t>(RowCount, begin + chunkRows);
+                uint32_t offset = static_cast<uint32_t>(chunkOffsets[chunk]);
+                for (size_t row = begin; row < end; row++)
+                {
+                    Column.StringOffsets[row] = offset;
+                    if (row + 1 < end)
+                        offset += Column.StringOffsets[row + 1];
+                }
+            }
+        }, 1);
+        Column.StringOffsets[RowCount] = static_cast<uint32_t>(chunkOffsets.back());
+    };
+    concatenate(name, nameChunks);
+    concatenate(category, categoryChunks);
+    return table;
+}
+
+/**
+ * \brief Generates the demo table on a worker and hands it to Grid on the main thread
+ */
+inline Task<void> LoadDemoDataGridTable(JobSystem& Jobs, DataGrid& Grid, const uint32_t RowCount, const CancellationToken* Token)
+{
+    co_await ResumeOnWorker(Jobs, Token);
+    std::shared_ptr<const DataGridTable> table = MakeDemoDataGridTable(Jobs, RowCount);
+    co_await ResumeOn(Jobs, JobAffinity::MAIN_THREAD, Token);
+    Grid.SetSource(std::move(table));
+}
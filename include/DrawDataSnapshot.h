@@ -0,0 +1,74 @@
+#pragma once
+
+#include "imgui.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+/**
+ * \brief Deep copy of an ImDrawData that stays valid after the next ImGui::NewFrame().
+ * Draw lists are kept between captures so that steady-state frames reuse their vertex/index storage.
+ */
+class DrawDataSnapshot
+{
+public:
+    DrawDataSnapshot() = default;
+
+    DrawDataSnapshot(const DrawDataSnapshot&) = delete;
+    DrawDataSnapshot& operator=(const DrawDataSnapshot&) = delete;
+    DrawDataSnapshot(DrawDataSnapshot&&) = default;
+    DrawDataSnapshot& operator=(DrawDataSnapshot&&) = default;
+
+    void Capture(const ImDrawData* Source)
+    {
+        m_DrawData.Clear();
+        if (!Source || !Source->Valid)
+            return;
+
+        while (m_Lists.size() < static_cast<size_t>(Source->CmdListsCount))
+        {
+            m_Lists.push_back(std::make_unique<ImDrawList>(nullptr));
+        }
+
+        m_ListPtrs.resize(Source->CmdListsCount);
+        for (int i = 0; i < Source->CmdListsCount; i++)
+        {
+            const ImDrawList* src = Source->CmdLists[i];
+            ImDrawList* dst = m_Lists[i].get();
+            CopyVector(dst->CmdBuffer, src->CmdBuffer);
+            CopyVector(dst->IdxBuffer, src->IdxBuffer);
+            CopyVector(dst->VtxBuffer, src->VtxBuffer);
+            dst->Flags = src->Flags;
+            m_ListPtrs[i] = dst;
+        }
+
+        m_DrawData.Valid = true;
+        m_DrawData.CmdListsCount = Source->CmdListsCount;
+        m_DrawData.TotalIdxCount = Source->TotalIdxCount;
+        m_DrawData.TotalVtxCount = Source->TotalVtxCount;
+        m_DrawData.CmdLists = m_ListPtrs.data();
+        m_DrawData.DisplayPos = Source->DisplayPos;
+        m_DrawData.DisplaySize = Source->DisplaySize;
+        m_DrawData.FramebufferScale = Source->FramebufferScale;
+        m_DrawData.OwnerViewport = nullptr; // the viewport may be gone by the time the snapshot is rendered
+    }
+
+    [[nodiscard]] bool IsValid() const { return m_DrawData.Valid; }
+
+    [[nodiscard]] ImDrawData* Get() { return &m_DrawData; }
+
+private:
+    template <typename T>
+    static void CopyVector(ImVector<T>& Dst, const ImVector<T>& Src)
+    {
+        // ImVector::operator= frees the destination first; resize() keeps the existing capacity
+        Dst.resize(Src.Size);
+        if (Src.Size > 0)
+            memcpy(Dst.Data, Src.Data, static_cast<size_t>(Src.Size) * sizeof(T));
+    }
+
+    ImDrawData m_DrawData;
+    std::vector<std::unique_ptr<ImDrawList>> m_Lists;
+    std::vector<ImDrawList*> m_ListPtrs;
+};
@@ -0,0 +1,611 @@
+#pragma once
+
+#include "FontAtlasBuilder.h"
+#include "JobSystem.h"
+
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+struct DynamicGlyphCacheDesc
+{
+    // atlas texels set aside for on-demand glyphs, in Alpha8 bytes (the GL texture stores them as RGBA32, 4x this)
+    size_t BudgetBytes{512 * 1024};
+    // side of one reserved page; must not exceed the atlas width, which is at least 512
+    int PageSize{256};
+    // rasterizations in flight at once; further misses wait for a later frame
+    uint32_t MaxPendingRequests{128};
+};
+
+/**
+ * \brief Rasterizes glyphs on first use into reserved regions of the font atlas, evicting the least recently used ones.
+ *
+ * The budget is reserved as square custom rects ("pages") before the atlas is built, so the atlas stays one texture
+ * with stable UVs. Pages are cut into cells sized for the largest glyph of any attached font. ImFont::FindGlyph()
+ * reports code-points without a glyph; the next Update() rasterizes them on the job system, and the frame after the
+ * rasterization completes the glyph replaces the fallback. A cell is only reused once its glyph was not looked up in
+ * the previous frame, whose draw data may still reference it, so eviction never needs to wait for the GPU.
+ *
+ *     DynamicGlyphCache glyphCache(jobSystem);
+ *     glyphCache.ReservePages(io.Fonts);     // before Build() / FontAtlasCache::Load()
+ *     io.Fonts->Build();
+ *     glyphCache.Attach(io.Fonts);
+ *     // every frame, before ImGui::NewFrame(): Update(), then upload GetDirtyRegions()
+ *     glyphCache.Detach();                   // before ImGui::DestroyContext()
+ */
+class DynamicGlyphCache
+{
+public:
+    /**
+     * \brief Atlas texels modified by Update() that the renderer has to re-upload
+     */
+    struct Region
+    {
+        int X{0};
+        int Y{0};
+        int Width{0};
+        int Height{0};
+    };
+
+    struct Stats
+    {
+        uint32_t CellCount{0};
+        uint32_t ResidentCount{0};
+        uint32_t PendingCount{0};
+        uint32_t MissingCount{0};
+        uint64_t RasterizedCount{0};
+        uint64_t EvictedCount{0};
+    };
+
+    explicit DynamicGlyphCache(JobSystem& Jobs, const DynamicGlyphCacheDesc& Desc = DynamicGlyphCacheDesc())
+        : m_Jobs(Jobs), m_Desc(Desc)
+    {
+    }
+
+    DynamicGlyphCache(const DynamicGlyphCache&) = delete;
+    DynamicGlyphCache& operator=(const DynamicGlyphCache&) = delete;
+
+    ~DynamicGlyphCache()
+    {
+        Detach();
+    }
+
+    /**
+     * \brief Adds the pages to the atlas as custom rects. Call before the atlas is built or loaded from a cache.
+     */
+    void ReservePages(ImFontAtlas* Atlas)
+    {
+        const size_t pageBytes = static_cast<size_t>(m_Desc.PageSize) * static_cast<size_t>(m_Desc.PageSize);
+        const size_t pageCount = std::max<size_t>(1, m_Desc.BudgetBytes / pageBytes);
+        m_PageRectIds.clear();
+        for (size_t page = 0; page < pageCount; page++)
+            m_PageRectIds.push_back(Atlas->AddCustomRectRegular(m_Desc.PageSize, m_Desc.PageSize));
+    }
+
+    /**
+     * \brief Lays out the cells in the built atlas and starts serving misses of every font in it
+     */
+    void Attach(ImFontAtlas* Atlas)
+    {
+        IM_ASSERT(Atlas->IsBuilt() && Atlas->TexPixelsAlpha8 != nullptr && !m_PageRectIds.empty());
+        m_Atlas = Atlas;
+
+        for (int fontIndex = 0; fontIndex < Atlas->Fonts.Size; fontIndex++)
+        {
+            ImFont* font = Atlas->Fonts[fontIndex];
+            auto state = std::make_unique<FontState>();
+            state->Owner = this;
+            state->Index = fontIndex;
+            state->Font = font;
+            for (int sourceIndex = 0; sourceIndex < font->ConfigDataCount; sourceIndex++)
+            {
+                const ImFontConfig& config = font->ConfigData[sourceIndex];
+                FontSource& source = state->Sources.emplace_back();
+                source.Config = &config;
+                const unsigned char* data = static_cast<const unsigned char*>(config.FontData);
+                if (!data || !stbtt_InitFont(&source.FontInfo, data, stbtt_GetFontOffsetForIndex(data, config.FontNo)))
+                {
+                    state->Sources.pop_back();
+                    continue;
+                }
+                GrowCellSize(source);
+            }
+
+            font->GlyphMissHandler = &OnGlyphMiss;
+            font->GlyphMissUserData = state.get();
+            font->GlyphTrackedBegin = font->Glyphs.Size;
+            font->GlyphTrackedFrame = m_Frame;
+            font->GlyphTrackedLastUse.clear();
+            m_Fonts.push_back(std::move(state));
+        }
+
+        // cells are filled top-down so the first dirty regions of a page stay small
+        for (size_t page = 0; page < m_PageRectIds.size(); page++)
+        {
+            const ImFontAtlasCustomRect* rect = Atlas->GetCustomRectByIndex(m_PageRectIds[page]);
+            IM_ASSERT(rect->IsPacked());
+            for (int y = 0; y + m_CellHeight <= rect->Height; y += m_CellHeight)
+            {
+                for (int x = 0; x + m_CellWidth <= rect->Width; x += m_CellWidth)
+                {
+                    Cell& cell = m_Cells.emplace_back();
+                    cell.X = rect->X + x;
+                    cell.Y = rect->Y + y;
+                    cell.Page = static_cast<int>(page);
+                }
+            }
+        }
+        m_FreeCells.reserve(m_Cells.size());
+        for (size_t cell = m_Cells.size(); cell-- > 0;)
+            m_FreeCells.push_back(static_cast<int>(cell));
+        m_PageDirty.assign(m_PageRectIds.size(), Region());
+    }
+
+    /**
+     * \brief Waits for the rasterizations in flight and removes the hooks from the attached fonts, which keep the glyphs
+     * installed so far. Call before the atlas is destroyed; the destructor calls it too.
+     */
+    void Detach()
+    {
+        // a request that is not done still has a live job writing into it
+        for (const std::unique_ptr<Request>& request : m_InFlight)
+        {
+            if (!request->bDone.load(std::memory_order_acquire))
+                m_Jobs.Wait(request->Task);
+        }
+        m_InFlight.clear();
+        m_Misses.clear();
+
+        for (const std::unique_ptr<FontState>& state : m_Fonts)
+        {
+            ImFont* font = state->Font;
+            if (font->GlyphMissUserData == state.get())
+            {
+                font->GlyphMissHandler = nullptr;
+                font->GlyphMissUserData = nullptr;
+                font->GlyphTrackedBegin = INT_MAX;
+                font->GlyphTrackedLastUse.clear();
+            }
+        }
+        m_Fonts.clear();
+        m_Cells.clear();
+        m_FreeCells.clear();
+        m_Victims.clear();
+        m_VictimsBuilt = false;
+        m_Atlas = nullptr;
+    }
+
+    /**
+     * \brief Installs the glyphs rasterized since the last call and starts rasterizing new misses.
+     * Call on the ImGui thread outside of a frame, i.e. before ImGui::NewFrame().
+     * \return Whether glyph advances changed, which invalidates cached text sizes
+     */
+    bool Update()
+    {
+        if (!m_Atlas)
+            return false;
+
+        m_Frame++;
+        m_bAdvancesChanged = false;
+        m_VictimsBuilt = false;
+        m_DirtyRegions.clear();
+
+        // completed rasterizations, in request order
+        size_t keep = 0;
+        for (size_t i = 0; i < m_InFlight.size(); i++)
+        {
+            std::unique_ptr<Request>& request = m_InFlight[i];
+            if (!request->bDone.load(std::memory_order_acquire))
+            {
+                m_InFlight[keep++] = std::move(request);
+                continue;
+            }
+            Complete(*request);
+            m_SpareRequests.push_back(std::move(request));
+        }
+        m_InFlight.resize(keep);
+
+        // new misses; the ones over the limit stay queued
+        size_t started = 0;
+        while (started < m_Misses.size() && m_InFlight.size() < m_Desc.MaxPendingRequests)
+            Start(m_Misses[started++]);
+        m_Misses.erase(m_Misses.begin(), m_Misses.begin() + static_cast<std::ptrdiff_t>(started));
+
+        for (Region& dirty : m_PageDirty)
+        {
+            if (dirty.Width > 0)
+                m_DirtyRegions.push_back(dirty);
+            dirty = Region();
+        }
+
+        for (const std::unique_ptr<FontState>& state : m_Fonts)
+            state->Font->GlyphTrackedFrame = m_Frame;
+        return m_bAdvancesChanged;
+    }
+
+    [[nodiscard]] const std::vector<Region>& GetDirtyRegions() const { return m_DirtyRegions; }
+
+    /**
+     * \brief Writes a region of the atlas as the RGBA32 texels GetTexDataAsRGBA32() would produce
+     */
+    void CopyRegionRGBA32(const Region& Area, void* Out) const
+    {
+        ImU32* out = static_cast<ImU32*>(Out);
+        for (int y = 0; y < Area.Height; y++)
+        {
+            const unsigned char* src = m_Atlas->TexPixelsAlpha8 + static_cast<size_t>(Area.Y + y) * m_Atlas->TexWidth + Area.X;
+            for (int x = 0; x < Area.Width; x++)
+                *out++ = IM_COL32(255, 255, 255, src[x]);
+        }
+    }
+
+    [[nodiscard]] Stats GetStats() const
+    {
+        Stats stats = m_Stats;
+        stats.CellCount = static_cast<uint32_t>(m_Cells.size());
+        stats.ResidentCount = static_cast<uint32_t>(m_Cells.size() - m_FreeCells.size());
+        stats.PendingCount = static_cast<uint32_t>(m_InFlight.size() + m_Misses.size());
+        return stats;
+    }
+
+private:
+    struct FontSource
+    {
+        stbtt_fontinfo FontInfo{};
+        const ImFontConfig* Config{nullptr};
+    };
+
+    struct FontState
+    {
+        DynamicGlyphCache* Owner{nullptr};
+        int Index{0};
+        ImFont* Font{nullptr};
+        std::vector<FontSource> Sources;
+        // Glyphs[] entries of evicted glyphs, reused before the array grows
+        std::vector<int> FreeSlots;
+        // code-points requested and not evicted since, or known to be missing from every source
+        std::unordered_set<ImWchar> Known;
+    };
+
+    struct Cell
+    {
+        int X{0};
+        int Y{0};
+        int Page{0};
+        int FontIndex{-1};
+        int Slot{-1};
+        ImWchar Codepoint{0};
+    };
+
+    struct Miss
+    {
+        int FontIndex;
+        ImWchar Codepoint;
+    };
+
+    struct Request
+    {
+        int FontIndex{0};
+        int SourceIndex{-1};
+        ImWchar Codepoint{0};
+        // written by the job
+        bool bFits{false};
+        stbtt_packedchar PackedChar{};
+        std::vector<unsigned char> Pixels;
+        Job* Task{nullptr};
+        std::atomic<bool> bDone{false};
+    };
+
+    static void OnGlyphMiss(void* UserData, const ImFont* Font, const ImWchar Codepoint)
+    {
+        (void)Font;
+        FontState& state = *static_cast<FontState*>(UserData);
+        if (state.Known.insert(Codepoint).second)
+            state.Owner->m_Misses.push_back({state.Index, Codepoint});
+    }
+
+    void GrowCellSize(const FontSource& Source)
+    {
+        // the font's bounding box holds every glyph; clamp it to 1.25 em so that one oversized glyph does not inflate
+        // every cell (glyphs that do not fit keep showing the fallback)
+        const ImFontConfig& config = *Source.Config;
+        const float scale = GetScale(Source);
+        int x0, y0, x1, y1;
+        stbtt_GetFontBoundingBox(&Source.FontInfo, &x0, &y0, &x1, &y1);
+        const float em = ImFabs(config.SizePixels) * 1.25f;
+        const float width = ImMin((x1 - x0) * scale, em) * config.OversampleH;
+        const float height = ImMin((y1 - y0) * scale, em) * config.OversampleV;
+        const int padding = m_Atlas->TexGlyphPadding;
+        m_CellWidth = ImMax(m_CellWidth, static_cast<int>(ImCeil(width)) + 2 + padding + config.OversampleH - 1);
+        m_CellHeight = ImMax(m_CellHeight, static_cast<int>(ImCeil(height)) + 2 + padding + config.OversampleV - 1);
+        m_CellWidth = ImMin(m_CellWidth, m_Desc.PageSize);
+        m_CellHeight = ImMin(m_CellHeight, m_Desc.PageSize);
+    }
+
+    static float GetScale(const FontSource& Source)
+    {
+        const float size = Source.Config->SizePixels;
+        return size > 0 ? stbtt_ScaleForPixelHeight(&Source.FontInfo, size) : stbtt_ScaleForMappingEmToPixels(&Source.FontInfo, -size);
+    }
+
+    void Start(const Miss& Pending)
+    {
+        FontState& state = *m_Fonts[static_cast<size_t>(Pending.FontIndex)];
+
+        // like a merged build, the first source providing the code-point wins
+        int sourceIndex = -1;
+        for (size_t i = 0; i < state.Sources.size() && sourceIndex < 0; i++)
+        {
+            if (stbtt_FindGlyphIndex(&state.Sources[i].FontInfo, Pending.Codepoint))
+                sourceIndex = static_cast<int>(i);
+        }
+        if (sourceIndex < 0)
+        {
+            MapToFallback(state, Pending.Codepoint);
+            return;
+        }
+
+        std::unique_ptr<Request> request;
+        if (!m_SpareRequests.empty())
+        {
+            request = std::move(m_SpareRequests.back());
+            m_SpareRequests.pop_back();
+        }
+        else
+        {
+            request = std::make_unique<Request>();
+        }
+        request->FontIndex = Pending.FontIndex;
+        request->SourceIndex = sourceIndex;
+        request->Codepoint = Pending.Codepoint;
+        request->bFits = false;
+        request->Pixels.resize(static_cast<size_t>(m_CellWidth) * static_cast<size_t>(m_CellHeight));
+        request->bDone.store(false, std::memory_order_relaxed);
+
+        Request* target = request.get();
+        const FontSource* source = &state.Sources[static_cast<size_t>(sourceIndex)];
+        target->Task = m_Jobs.Run([this, target, source]() {
+            Rasterize(*target, *source);
+            target->bDone.store(true, std::memory_order_release);
+        });
+        m_InFlight.push_back(std::move(request));
+    }
+
+    void Rasterize(Request& Target, const FontSource& Source) const
+    {
+        const ImFontConfig& config = *Source.Config;
+        const float scale = GetScale(Source);
+        const int padding = m_Atlas->TexGlyphPadding;
+        const int glyphIndex = stbtt_FindGlyphIndex(&Source.FontInfo, Target.Codepoint);
+        int x0, y0, x1, y1;
+        stbtt_GetGlyphBitmapBoxSubpixel(&Source.FontInfo, glyphIndex, scale * config.OversampleH, scale * config.OversampleV,
+                                        0, 0, &x0, &y0, &x1, &y1);
+
+        // the same rect the atlas builder would pack, placed in the corner of a cell-sized buffer
+        stbrp_rect rect{};
+        rect.w = static_cast<stbrp_coord>(x1 - x0 + padding + config.OversampleH - 1);
+        rect.h = static_cast<stbrp_coord>(y1 - y0 + padding + config.OversampleV - 1);
+        rect.was_packed = 1;
+        Target.bFits = rect.w <= m_CellWidth && rect.h <= m_CellHeight;
+        if (!Target.bFits)
+            return;
+
+        int codepoint = Target.Codepoint;
+        stbtt_pack_range range{};
+        range.font_size = config.SizePixels;
+        range.array_of_unicode_codepoints = &codepoint;
+        range.num_chars = 1;
+        range.chardata_for_range = &Target.PackedChar;
+        range.h_oversample = static_cast<unsigned char>(config.OversampleH);
+        range.v_oversample = static_cast<unsigned char>(config.OversampleV);
+
+        stbtt_pack_context context = {};
+        stbtt_PackBegin(&context, Target.Pixels.data(), m_CellWidth, m_CellHeight, m_CellWidth, padding, nullptr);
+        stbtt_PackFontRangesRenderIntoRects(&context, &Source.FontInfo, &range, 1, &rect);
+        stbtt_PackEnd(&context);
+
+        if (config.RasterizerMultiply != 1.0f)
+        {
+            unsigned char multiplyTable[256];
+            ImFontAtlasBuildMultiplyCalcLookupTable(multiplyTable, config.RasterizerMultiply);
+            ImFontAtlasBuildMultiplyRectAlpha8(multiplyTable, Target.Pixels.data(), rect.x, rect.y, rect.w, rect.h, m_CellWidth);
+        }
+    }
+
+    void Complete(const Request& Done)
+    {
+        FontState& state = *m_Fonts[static_cast<size_t>(Done.FontIndex)];
+        if (!Done.bFits)
+        {
+            MapToFallback(state, Done.Codepoint);
+            return;
+        }
+
+        const int cellIndex = AllocateCell();
+        if (cellIndex < 0)
+        {
+            // every cell was needed by the last frame: drop the glyph, a later miss requests it again
+            state.Known.erase(Done.Codepoint);
+            return;
+        }
+        Cell& cell = m_Cells[static_cast<size_t>(cellIndex)];
+
+        // texels, including the cleared remainder of the cell
+        for (int y = 0; y < m_CellHeight; y++)
+        {
+            const unsigned char* src = Done.Pixels.data() + static_cast<size_t>(y) * m_CellWidth;
+            const size_t offset = static_cast<size_t>(cell.Y + y) * m_Atlas->TexWidth + cell.X;
+            memcpy(m_Atlas->TexPixelsAlpha8 + offset, src, static_cast<size_t>(m_CellWidth));
+            if (m_Atlas->TexPixelsRGBA32)
+            {
+                for (int x = 0; x < m_CellWidth; x++)
+                    m_Atlas->TexPixelsRGBA32[offset + x] = IM_COL32(255, 255, 255, src[x]);
+            }
+        }
+        Region& dirty = m_PageDirty[static_cast<size_t>(cell.Page)];
+        if (dirty.Width == 0)
+        {
+            dirty = {cell.X, cell.Y, m_CellWidth, m_CellHeight};
+        }
+        else
+        {
+            const int right = ImMax(dirty.X + dirty.Width, cell.X + m_CellWidth);
+            const int bottom = ImMax(dirty.Y + dirty.Height, cell.Y + m_CellHeight);
+            dirty.X = ImMin(dirty.X, cell.X);
+            dirty.Y = ImMin(dirty.Y, cell.Y);
+            dirty.Width = right - dirty.X;
+            dirty.Height = bottom - dirty.Y;
+        }
+
+        // glyph quad, as step 9 of the atlas build computes it
+        const FontSource& source = state.Sources[static_cast<size_t>(Done.SourceIndex)];
+        const ImFontConfig& config = *source.Config;
+        ImFont* font = state.Font;
+        stbtt_packedchar packedChar = Done.PackedChar;
+        packedChar.x0 = static_cast<unsigned short>(packedChar.x0 + cell.X);
+        packedChar.x1 = static_cast<unsigned short>(packedChar.x1 + cell.X);
+        packedChar.y0 = static_cast<unsigned short>(packedChar.y0 + cell.Y);
+        packedChar.y1 = static_cast<unsigned short>(packedChar.y1 + cell.Y);
+        stbtt_aligned_quad quad;
+        float unusedX = 0.0f, unusedY = 0.0f;
+        stbtt_GetPackedQuad(&packedChar, m_Atlas->TexWidth, m_Atlas->TexHeight, 0, &unusedX, &unusedY, &quad, 0);
+        const float offsetX = config.GlyphOffset.x;
+        const float offsetY = config.GlyphOffset.y + IM_ROUND(font->Ascent);
+
+        // AddGlyph() appends; a freed slot takes the new glyph over instead. Glyphs[] may move, FallbackGlyph with it.
+        const int fallbackIndex = font->FallbackGlyph ? static_cast<int>(font->FallbackGlyph - font->Glyphs.Data) : -1;
+        font->AddGlyph(&config, Done.Codepoint, quad.x0 + offsetX, quad.y0 + offsetY, quad.x1 + offsetX, quad.y1 + offsetY,
+                       quad.s0, quad.t0, quad.s1, quad.t1, Done.PackedChar.xadvance);
+        font->DirtyLookupTables = false;
+        int slot = font->Glyphs.Size - 1;
+        if (!state.FreeSlots.empty())
+        {
+            slot = state.FreeSlots.back();
+            state.FreeSlots.pop_back();
+            font->Glyphs[slot] = font->Glyphs.back();
+            font->Glyphs.pop_back();
+        }
+        if (fallbackIndex >= 0)
+            font->FallbackGlyph = &font->Glyphs[fallbackIndex];
+        font->GlyphTrackedLastUse.resize(font->Glyphs.Size - font->GlyphTrackedBegin, 0);
+        font->GlyphTrackedLastUse[slot - font->GlyphTrackedBegin] = m_Frame;
+
+        SetLookup(*font, Done.Codepoint, static_cast<ImWchar>(slot), font->Glyphs[slot].AdvanceX);
+        m_bAdvancesChanged = true;
+        font->Used4kPagesMap[Done.Codepoint >> 12 >> 3] |= 1 << ((Done.Codepoint >> 12) & 7);
+
+        cell.FontIndex = Done.FontIndex;
+        cell.Slot = slot;
+        cell.Codepoint = Done.Codepoint;
+        m_Stats.RasterizedCount++;
+    }
+
+    int AllocateCell()
+    {
+        if (!m_FreeCells.empty())
+        {
+            const int cell = m_FreeCells.back();
+            m_FreeCells.pop_back();
+            return cell;
+        }
+
+        // least recently used first, among the cells the last frame did not touch
+        if (!m_VictimsBuilt)
+        {
+            m_VictimsBuilt = true;
+            m_Victims.clear();
+            for (size_t i = 0; i < m_Cells.size(); i++)
+            {
+                if (m_Cells[i].FontIndex >= 0 && GetLastUse(m_Cells[i]) < m_Frame - 1)
+                    m_Victims.push_back(static_cast<int>(i));
+            }
+            std::sort(m_Victims.begin(), m_Victims.end(),
+                      [this](const int A, const int B) { return GetLastUse(m_Cells[static_cast<size_t>(A)]) > GetLastUse(m_Cells[static_cast<size_t>(B)]); });
+        }
+        if (m_Victims.empty())
+            return -1;
+
+        const int cellIndex = m_Victims.back();
+        m_Victims.pop_back();
+        Evict(m_Cells[static_cast<size_t>(cellIndex)]);
+        return cellIndex;
+    }
+
+    [[nodiscard]] int GetLastUse(const Cell& Used) const
+    {
+        const ImFont* font = m_Fonts[static_cast<size_t>(Used.FontIndex)]->Font;
+        return font->GlyphTrackedLastUse[Used.Slot - font->GlyphTrackedBegin];
+    }
+
+    void Evict(Cell& Victim)
+    {
+        FontState& state = *m_Fonts[static_cast<size_t>(Victim.FontIndex)];
+        ImFont* font = state.Font;
+        font->IndexLookup[Victim.Codepoint] = static_cast<ImWchar>(-1);
+        font->IndexAdvanceX[Victim.Codepoint] = font->FallbackAdvanceX;
+        font->Glyphs[Victim.Slot].Visible = false;
+        state.FreeSlots.push_back(Victim.Slot);
+        state.Known.erase(Victim.Codepoint);
+        m_bAdvancesChanged = true;
+        Victim.FontIndex = -1;
+        Victim.Slot = -1;
+        m_Stats.EvictedCount++;
+    }
+
+    void MapToFallback(FontState& State, const ImWchar Codepoint)
+    {
+        // the code-point stays Known, so it is never requested again; pointing it at the fallback glyph also stops
+        // FindGlyph() from reporting it
+        if (State.Font->FallbackGlyph)
+        {
+            const ImWchar fallback = static_cast<ImWchar>(State.Font->FallbackGlyph - State.Font->Glyphs.Data);
+            SetLookup(*State.Font, Codepoint, fallback, State.Font->FallbackAdvanceX);
+            m_bAdvancesChanged = true;
+        }
+        m_Stats.MissingCount++;
+    }
+
+    static void SetLookup(ImFont& Font, const ImWchar Codepoint, const ImWchar GlyphIndex, const float AdvanceX)
+    {
+        const int oldSize = Font.IndexLookup.Size;
+        if (Codepoint >= oldSize)
+        {
+            // GrowIndex() leaves -1 advances behind, which only BuildLookupTable() replaces with the fallback's
+            Font.GrowIndex(Codepoint + 1);
+            for (int c = oldSize; c < Font.IndexAdvanceX.Size; c++)
+                Font.IndexAdvanceX[c] = Font.FallbackAdvanceX;
+        }
+        Font.IndexLookup[Codepoint] = GlyphIndex;
+        Font.IndexAdvanceX[Codepoint] = AdvanceX;
+    }
+
+    JobSystem& m_Jobs;
+    DynamicGlyphCacheDesc m_Desc;
+    ImFontAtlas* m_Atlas{nullptr};
+    std::vector<int> m_PageRectIds;
+    int m_CellWidth{1};
+    int m_CellHeight{1};
+    int m_Frame{0};
+    bool m_bAdvancesChanged{false};
+
+    std::vector<std::unique_ptr<FontState>> m_Fonts;
+    std::vector<Cell> m_Cells;
+    std::vector<int> m_FreeCells;
+    std::vector<int> m_Victims;
+    bool m_VictimsBuilt{false};
+
+    std::vector<Miss> m_Misses;
+    std::vector<std::unique_ptr<Request>> m_InFlight;
+    std::vector<std::unique_ptr<Request>> m_SpareRequests;
+
+    std::vector<Region> m_PageDirty;
+    std::vector<Region> m_DirtyRegions;
+    Stats m_Stats;
+};
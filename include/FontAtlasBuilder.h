@@ -0,0 +1,458 @@
+#pragma once
+
+#include "JobSystem.h"
+
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <cstdlib>
+#include <vector>
+
+// a private stb_truetype/stb_rect_pack instance configured like imgui_draw.cpp's, so the rasterized output is identical;
+// it allocates from the C heap, which (unlike IM_ALLOC and its allocation counter) is safe on worker threads
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wtype-limits"
+#pragma GCC diagnostic ignored "-Wcast-qual"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#endif
+#define STBRP_STATIC
+#define STBRP_ASSERT(x) do { IM_ASSERT(x); } while (0)
+#define STBRP_SORT ImQsort
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imstb_rectpack.h"
+#define STBTT_malloc(x, u) ((void)(u), malloc(x))
+#define STBTT_free(x, u) ((void)(u), free(x))
+#define STBTT_assert(x) do { IM_ASSERT(x); } while (0)
+#define STBTT_fmod(x, y) ImFmod(x, y)
+#define STBTT_sqrt(x) ImSqrt(x)
+#define STBTT_pow(x, y) ImPow(x, y)
+#define STBTT_fabs(x) ImFabs(x)
+#define STBTT_ifloor(x) ((int)ImFloorSigned(x))
+#define STBTT_iceil(x) ((int)ImCeil(x))
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include "imstb_truetype.h"
+#undef STB_RECT_PACK_IMPLEMENTATION
+#undef STB_TRUETYPE_IMPLEMENTATION
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+/**
+ * \brief ImFontAtlas builder that rasterizes glyphs on the job system.
+ *
+ * Follows Dear ImGui's stb_truetype builder step for step (glyph gathering, rect packing, metrics), but once every
+ * glyph has its packed rectangle the rasterization - stbtt_MakeGlyphBitmapSubpixel, the oversampling prefilters and
+ * the RasterizerMultiply pass - runs as parallel tasks of GLYPHS_PER_TASK glyphs each. Packed rectangles are
+ * disjoint and every task runs the serial per-glyph code, so the atlas is bit-identical to ImGui's own build.
+ *
+ * Sources with BUILD_SDF in ImFontConfig::FontBuilderFlags are stored as signed distance fields instead (oversampling
+ * does not apply): texel alpha 128 is the glyph outline and every SDF_SPREAD pixels of the base size change it by 128.
+ * Such a font scales to any size, but needs the distance field shader of ImGui_ImplOpenGL3_CreateSdfFontsTexture(),
+ * so SDF fonts are built into an atlas of their own.
+ *
+ *     FontAtlasBuilder::SetJobSystem(&jobSystem);
+ *     io.Fonts->FontBuilderIO = FontAtlasBuilder::GetBuilderIO();
+ */
+class FontAtlasBuilder
+{
+public:
+    static constexpr int GLYPHS_PER_TASK = 16;
+    static constexpr unsigned int BUILD_SDF = 1u << 0;
+    static constexpr int SDF_SPREAD = 4;
+
+    /**
+     * \brief Job system to rasterize on; without one (or from a thread outside it) glyphs are rasterized serially
+     */
+    static void SetJobSystem(JobSystem* Jobs) { s_JobSystem = Jobs; }
+
+    static const ImFontBuilderIO* GetBuilderIO()
+    {
+        static ImFontBuilderIO builderIO;
+        builderIO.FontBuilder_Build = &Build;
+        return &builderIO;
+    }
+
+    static bool Build(ImFontAtlas* Atlas)
+    {
+        IM_ASSERT(Atlas->ConfigData.Size > 0);
+
+        ImFontAtlasBuildInit(Atlas);
+
+        // clear atlas
+        Atlas->TexID = (ImTextureID) nullptr;
+        Atlas->TexWidth = Atlas->TexHeight = 0;
+        Atlas->TexUvScale = ImVec2(0.0f, 0.0f);
+        Atlas->TexUvWhitePixel = ImVec2(0.0f, 0.0f);
+        Atlas->ClearTexData();
+
+        std::vector<SourceData> sources(static_cast<size_t>(Atlas->ConfigData.Size));
+        std::vector<DestinationData> destinations(static_cast<size_t>(Atlas->Fonts.Size));
+
+        // 1. initialize the font loading structures and check the font data
+        for (int sourceIndex = 0; sourceIndex < Atlas->ConfigData.Size; sourceIndex++)
+        {
+            SourceData& source = sources[static_cast<size_t>(sourceIndex)];
+            const ImFontConfig& config = Atlas->ConfigData[sourceIndex];
+            IM_ASSERT(config.DstFont && (!config.DstFont->IsLoaded() || config.DstFont->ContainerAtlas == Atlas));
+
+            for (int fontIndex = 0; fontIndex < Atlas->Fonts.Size && source.DestinationIndex == -1; fontIndex++)
+            {
+                if (config.DstFont == Atlas->Fonts[fontIndex])
+                    source.DestinationIndex = fontIndex;
+            }
+            if (source.DestinationIndex == -1)
+            {
+                IM_ASSERT(source.DestinationIndex != -1); // config.DstFont not pointing within Atlas->Fonts[]?
+                return false;
+            }
+            const int fontOffset = stbtt_GetFontOffsetForIndex(static_cast<unsigned char*>(config.FontData), config.FontNo);
+            IM_ASSERT(fontOffset >= 0 && "FontData is incorrect, or FontNo cannot be found.");
+            if (!stbtt_InitFont(&source.FontInfo, static_cast<unsigned char*>(config.FontData), fontOffset))
+                return false;
+            source.bSdf = (config.FontBuilderFlags & BUILD_SDF) != 0;
+
+            DestinationData& destination = destinations[static_cast<size_t>(source.DestinationIndex)];
+            source.SourceRanges = config.GlyphRanges ? config.GlyphRanges : Atlas->GetGlyphRangesDefault();
+            for (const ImWchar* range = source.SourceRanges; range[0] && range[1]; range += 2)
+            {
+                IM_ASSERT(range[0] <= range[1]);
+                source.GlyphsHighest = ImMax(source.GlyphsHighest, static_cast<int>(range[1]));
+            }
+            destination.SourceCount++;
+            destination.GlyphsHighest = ImMax(destination.GlyphsHighest, source.GlyphsHighest);
+        }
+
+        // 2. keep the requested codepoints present in the font data and not already provided by an earlier source
+        int totalGlyphsCount = 0;
+        for (SourceData& source : sources)
+        {
+            DestinationData& destination = destinations[static_cast<size_t>(source.DestinationIndex)];
+            source.GlyphsSet.Create(source.GlyphsHighest + 1);
+            if (destination.GlyphsSet.Storage.empty())
+                destination.GlyphsSet.Create(destination.GlyphsHighest + 1);
+
+            for (const ImWchar* range = source.SourceRanges; range[0] && range[1]; range += 2)
+            {
+                for (unsigned int codepoint = range[0]; codepoint <= range[1]; codepoint++)
+                {
+                    if (destination.GlyphsSet.TestBit(static_cast<int>(codepoint)))
+                        continue;
+                    if (!stbtt_FindGlyphIndex(&source.FontInfo, static_cast<int>(codepoint)))
+                        continue;
+
+                    source.GlyphsCount++;
+                    destination.GlyphsCount++;
+                    source.GlyphsSet.SetBit(static_cast<int>(codepoint));
+                    destination.GlyphsSet.SetBit(static_cast<int>(codepoint));
+                    totalGlyphsCount++;
+                }
+            }
+        }
+
+        // 3. flatten the bit sets into codepoint lists
+        for (SourceData& source : sources)
+        {
+            source.GlyphsList.reserve(source.GlyphsCount);
+            UnpackBitVector(source.GlyphsSet, source.GlyphsList);
+            source.GlyphsSet.Clear();
+            IM_ASSERT(source.GlyphsList.Size == source.GlyphsCount);
+        }
+        destinations.clear();
+
+        std::vector<stbrp_rect> rects(static_cast<size_t>(totalGlyphsCount));
+        std::vector<stbtt_packedchar> packedChars(static_cast<size_t>(totalGlyphsCount));
+
+        // 4. gather the glyph sizes to pack
+        int totalSurface = 0;
+        int rectsOffset = 0;
+        for (int sourceIndex = 0; sourceIndex < Atlas->ConfigData.Size; sourceIndex++)
+        {
+            SourceData& source = sources[static_cast<size_t>(sourceIndex)];
+            if (source.GlyphsCount == 0)
+                continue;
+
+            source.Rects = rects.data() + rectsOffset;
+            source.PackedChars = packedChars.data() + rectsOffset;
+            rectsOffset += source.GlyphsCount;
+
+            const ImFontConfig& config = Atlas->ConfigData[sourceIndex];
+            source.PackRange.font_size = config.SizePixels;
+            source.PackRange.first_unicode_codepoint_in_range = 0;
+            source.PackRange.array_of_unicode_codepoints = source.GlyphsList.Data;
+            source.PackRange.num_chars = source.GlyphsList.Size;
+            source.PackRange.chardata_for_range = source.PackedChars;
+            source.PackRange.h_oversample = static_cast<unsigned char>(config.OversampleH);
+            source.PackRange.v_oversample = static_cast<unsigned char>(config.OversampleV);
+
+            const float scale = config.SizePixels > 0 ? stbtt_ScaleForPixelHeight(&source.FontInfo, config.SizePixels)
+                                                      : stbtt_ScaleForMappingEmToPixels(&source.FontInfo, -config.SizePixels);
+            const int padding = Atlas->TexGlyphPadding;
+            source.Scale = scale;
+            for (int glyph = 0; glyph < source.GlyphsList.Size; glyph++)
+            {
+                int x0, y0, x1, y1;
+                const int glyphIndexInFont = stbtt_FindGlyphIndex(&source.FontInfo, source.GlyphsList[glyph]);
+                IM_ASSERT(glyphIndexInFont != 0);
+                if (source.bSdf)
+                {
+                    // blank glyphs get an empty rect, which the packer accepts without placing it
+                    const bool bVisible = GetSdfBox(source, glyphIndexInFont, x0, y0, x1, y1);
+                    source.Rects[glyph].w = static_cast<stbrp_coord>(bVisible ? x1 - x0 + padding : 0);
+                    source.Rects[glyph].h = static_cast<stbrp_coord>(bVisible ? y1 - y0 + padding : 0);
+                    totalSurface += source.Rects[glyph].w * source.Rects[glyph].h;
+                    continue;
+                }
+                stbtt_GetGlyphBitmapBoxSubpixel(&source.FontInfo, glyphIndexInFont, scale * config.OversampleH,
+                                                scale * config.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+                source.Rects[glyph].w = static_cast<stbrp_coord>(x1 - x0 + padding + config.OversampleH - 1);
+                source.Rects[glyph].h = static_cast<stbrp_coord>(y1 - y0 + padding + config.OversampleV - 1);
+                totalSurface += source.Rects[glyph].w * source.Rects[glyph].h;
+            }
+        }
+
+        // any width works for the skyline packer; pick one from the expected surface unless the user asked for one
+        const int surfaceSqrt = static_cast<int>(ImSqrt(static_cast<float>(totalSurface))) + 1;
+        Atlas->TexHeight = 0;
+        if (Atlas->TexDesiredWidth > 0)
+            Atlas->TexWidth = Atlas->TexDesiredWidth;
+        else
+            Atlas->TexWidth = surfaceSqrt >= 4096 * 0.7f ? 4096 : surfaceSqrt >= 2048 * 0.7f ? 2048 : surfaceSqrt >= 1024 * 0.7f ? 1024 : 512;
+
+        // 5. pack the custom rects first so they land in the upper-left corner
+        const int TEX_HEIGHT_MAX = 1024 * 32;
+        stbtt_pack_context packContext = {};
+        stbtt_PackBegin(&packContext, nullptr, Atlas->TexWidth, TEX_HEIGHT_MAX, 0, Atlas->TexGlyphPadding, nullptr);
+        ImFontAtlasBuildPackCustomRects(Atlas, packContext.pack_info);
+
+        // 6. pack each source font into an unbounded texture height
+        for (SourceData& source : sources)
+        {
+            if (source.GlyphsCount == 0)
+                continue;
+            stbrp_pack_rects(static_cast<stbrp_context*>(packContext.pack_info), source.Rects, source.GlyphsCount);
+            for (int glyph = 0; glyph < source.GlyphsCount; glyph++)
+            {
+                if (source.Rects[glyph].was_packed)
+                    Atlas->TexHeight = ImMax(Atlas->TexHeight, source.Rects[glyph].y + source.Rects[glyph].h);
+            }
+        }
+
+        // 7. allocate the texture
+        Atlas->TexHeight = (Atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? Atlas->TexHeight + 1 : ImUpperPowerOfTwo(Atlas->TexHeight);
+        Atlas->TexUvScale = ImVec2(1.0f / static_cast<float>(Atlas->TexWidth), 1.0f / static_cast<float>(Atlas->TexHeight));
+        Atlas->TexPixelsAlpha8 = static_cast<unsigned char*>(IM_ALLOC(static_cast<size_t>(Atlas->TexWidth) * Atlas->TexHeight));
+        memset(Atlas->TexPixelsAlpha8, 0, static_cast<size_t>(Atlas->TexWidth) * Atlas->TexHeight);
+        packContext.pixels = Atlas->TexPixelsAlpha8;
+        packContext.height = Atlas->TexHeight;
+
+        // 8. rasterize: every task renders a contiguous run of one source's glyphs into their own rectangles
+        std::vector<RasterTask> tasks;
+        for (int sourceIndex = 0; sourceIndex < Atlas->ConfigData.Size; sourceIndex++)
+        {
+            for (int first = 0; first < sources[static_cast<size_t>(sourceIndex)].GlyphsCount; first += GLYPHS_PER_TASK)
+                tasks.push_back({sourceIndex, first, ImMin(first + GLYPHS_PER_TASK, sources[static_cast<size_t>(sourceIndex)].GlyphsCount)});
+        }
+        const auto rasterize = [&](const size_t First, const size_t Last)
+        {
+            for (size_t task = First; task < Last; task++)
+            {
+                const int sourceIndex = tasks[task].SourceIndex;
+                Rasterize(Atlas, packContext, sources[static_cast<size_t>(sourceIndex)], Atlas->ConfigData[sourceIndex], tasks[task]);
+            }
+        };
+        if (s_JobSystem && s_JobSystem->GetCurrentWorkerIndex() >= 0)
+            s_JobSystem->ParallelFor(0, tasks.size(), rasterize, 1);
+        else
+            rasterize(0, tasks.size());
+
+        stbtt_PackEnd(&packContext);
+        rects.clear();
+
+        // 9. set up the fonts and their glyphs
+        for (int sourceIndex = 0; sourceIndex < Atlas->ConfigData.Size; sourceIndex++)
+        {
+            SourceData& source = sources[static_cast<size_t>(sourceIndex)];
+            if (source.GlyphsCount == 0)
+                continue;
+
+            // with MergeMode several sources write into the same destination font, whose ConfigData is the first source
+            ImFontConfig& config = Atlas->ConfigData[sourceIndex];
+            ImFont* font = config.DstFont;
+
+            const float fontScale = stbtt_ScaleForPixelHeight(&source.FontInfo, config.SizePixels);
+            int unscaledAscent, unscaledDescent, unscaledLineGap;
+            stbtt_GetFontVMetrics(&source.FontInfo, &unscaledAscent, &unscaledDescent, &unscaledLineGap);
+
+            const float ascent = ImFloor(unscaledAscent * fontScale + ((unscaledAscent > 0.0f) ? +1 : -1));
+            const float descent = ImFloor(unscaledDescent * fontScale + ((unscaledDescent > 0.0f) ? +1 : -1));
+            ImFontAtlasBuildSetupFont(Atlas, font, &config, ascent, descent);
+            const float offsetX = config.GlyphOffset.x;
+            const float offsetY = config.GlyphOffset.y + IM_ROUND(font->Ascent);
+
+            for (int glyph = 0; glyph < source.GlyphsCount; glyph++)
+            {
+                const int codepoint = source.GlyphsList[glyph];
+                if (source.bSdf)
+                {
+                    // the quad covers the whole field, spread included, so it keeps its size relative to the outline
+                    const int glyphIndexInFont = stbtt_FindGlyphIndex(&source.FontInfo, codepoint);
+                    int advance, leftSideBearing;
+                    stbtt_GetGlyphHMetrics(&source.FontInfo, glyphIndexInFont, &advance, &leftSideBearing);
+                    int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+                    float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+                    if (GetSdfBox(source, glyphIndexInFont, x0, y0, x1, y1))
+                    {
+                        const stbrp_rect& rect = source.Rects[glyph];
+                        u0 = static_cast<float>(rect.x + Atlas->TexGlyphPadding) * Atlas->TexUvScale.x;
+                        v0 = static_cast<float>(rect.y + Atlas->TexGlyphPadding) * Atlas->TexUvScale.y;
+                        u1 = u0 + static_cast<float>(x1 - x0) * Atlas->TexUvScale.x;
+                        v1 = v0 + static_cast<float>(y1 - y0) * Atlas->TexUvScale.y;
+                    }
+                    font->AddGlyph(&config, static_cast<ImWchar>(codepoint), x0 + offsetX, y0 + offsetY, x1 + offsetX, y1 + offsetY,
+                                   u0, v0, u1, v1, advance * source.Scale);
+                    continue;
+                }
+                const stbtt_packedchar& packedChar = source.PackedChars[glyph];
+                stbtt_aligned_quad quad;
+                float unusedX = 0.0f, unusedY = 0.0f;
+                stbtt_GetPackedQuad(source.PackedChars, Atlas->TexWidth, Atlas->TexHeight, glyph, &unusedX, &unusedY, &quad, 0);
+                font->AddGlyph(&config, static_cast<ImWchar>(codepoint), quad.x0 + offsetX, quad.y0 + offsetY, quad.x1 + offsetX,
+                               quad.y1 + offsetY, quad.s0, quad.t0, quad.s1, quad.t1, packedChar.xadvance);
+            }
+        }
+
+        ImFontAtlasBuildFinish(Atlas);
+        return true;
+    }
+
+private:
+    /**
+     * \brief One source font (several can be merged into one ImFont)
+     */
+    struct SourceData
+    {
+        stbtt_fontinfo FontInfo{};
+        stbtt_pack_range PackRange{};
+        stbrp_rect* Rects{nullptr};
+        stbtt_packedchar* PackedChars{nullptr};
+        const ImWchar* SourceRanges{nullptr};
+        float Scale{1.0f};
+        bool bSdf{false};
+        int DestinationIndex{-1};
+        int GlyphsHighest{0};
+        // glyphs that exist in the font and were not provided by an earlier source of the same ImFont
+        int GlyphsCount{0};
+        ImBitVector GlyphsSet;
+        ImVector<int> GlyphsList;
+    };
+
+    struct DestinationData
+    {
+        int SourceCount{0};
+        int GlyphsHighest{0};
+        int GlyphsCount{0};
+        ImBitVector GlyphsSet;
+    };
+
+    struct RasterTask
+    {
+        int SourceIndex;
+        int FirstGlyph;
+        int LastGlyph;
+    };
+
+    static void UnpackBitVector(const ImBitVector& Bits, ImVector<int>& Out)
+    {
+        const ImU32* begin = Bits.Storage.begin();
+        for (const ImU32* it = begin; it < Bits.Storage.end(); it++)
+        {
+            if (const ImU32 entries = *it)
+            {
+                for (ImU32 bit = 0; bit < 32; bit++)
+                {
+                    if (entries & (static_cast<ImU32>(1) << bit))
+                        Out.push_back(static_cast<int>(((it - begin) << 5) + bit));
+                }
+            }
+        }
+    }
+
+    /**
+     * \brief Pixel box of a glyph's distance field at the source's base size, spread included; false for blank glyphs
+     */
+    static bool GetSdfBox(const SourceData& Source, const int GlyphIndex, int& X0, int& Y0, int& X1, int& Y1)
+    {
+        stbtt_GetGlyphBitmapBoxSubpixel(&Source.FontInfo, GlyphIndex, Source.Scale, Source.Scale, 0.0f, 0.0f, &X0, &Y0, &X1, &Y1);
+        if (X0 == X1 || Y0 == Y1)
+        {
+            X0 = Y0 = X1 = Y1 = 0;
+            return false;
+        }
+        X0 -= SDF_SPREAD;
+        Y0 -= SDF_SPREAD;
+        X1 += SDF_SPREAD;
+        Y1 += SDF_SPREAD;
+        return true;
+    }
+
+    static void RasterizeSdf(const ImFontAtlas* Atlas, SourceData& Source, const RasterTask& Task)
+    {
+        const int padding = Atlas->TexGlyphPadding;
+        for (int glyph = Task.FirstGlyph; glyph < Task.LastGlyph; glyph++)
+        {
+            const stbrp_rect& rect = Source.Rects[glyph];
+            if (!rect.was_packed || rect.w == 0)
+                continue;
+
+            int width, height, offsetX, offsetY;
+            const int glyphIndexInFont = stbtt_FindGlyphIndex(&Source.FontInfo, Source.GlyphsList[glyph]);
+            unsigned char* field = stbtt_GetGlyphSDF(&Source.FontInfo, Source.Scale, glyphIndexInFont, SDF_SPREAD, 128,
+                                                     128.0f / SDF_SPREAD, &width, &height, &offsetX, &offsetY);
+            if (!field)
+                continue;
+            IM_ASSERT(width == rect.w - padding && height == rect.h - padding);
+            for (int y = 0; y < height; y++)
+            {
+                unsigned char* dst = Atlas->TexPixelsAlpha8 + static_cast<size_t>(rect.y + padding + y) * Atlas->TexWidth + rect.x + padding;
+                memcpy(dst, field + static_cast<size_t>(y) * width, static_cast<size_t>(width));
+            }
+            stbtt_FreeSDF(field, nullptr);
+        }
+    }
+
+    static void Rasterize(const ImFontAtlas* Atlas, const stbtt_pack_context& SharedContext, SourceData& Source,
+                          const ImFontConfig& Config, const RasterTask& Task)
+    {
+        if (Source.bSdf)
+        {
+            RasterizeSdf(Atlas, Source, Task);
+            return;
+        }
+
+        // stbtt_PackFontRangesRenderIntoRects on a sub-range: the same per-glyph code as the serial build, with a
+        // private copy of the context because it swaps the oversampling fields while rendering
+        stbtt_pack_context context = SharedContext;
+        stbtt_pack_range range = Source.PackRange;
+        range.array_of_unicode_codepoints = Source.GlyphsList.Data + Task.FirstGlyph;
+        range.chardata_for_range = Source.PackedChars + Task.FirstGlyph;
+        range.num_chars = Task.LastGlyph - Task.FirstGlyph;
+        stbrp_rect* rects = Source.Rects + Task.FirstGlyph;
+        stbtt_PackFontRangesRenderIntoRects(&context, &Source.FontInfo, &range, 1, rects);
+
+        if (Config.RasterizerMultiply != 1.0f)
+        {
+            unsigned char multiplyTable[256];
+            ImFontAtlasBuildMultiplyCalcLookupTable(multiplyTable, Config.RasterizerMultiply);
+            for (int glyph = 0; glyph < range.num_chars; glyph++)
+            {
+                const stbrp_rect& rect = rects[glyph];
+                if (rect.was_packed)
+                    ImFontAtlasBuildMultiplyRectAlpha8(multiplyTable, Atlas->TexPixelsAlpha8, rect.x, rect.y, rect.w, rect.h, Atlas->TexWidth);
+            }
+        }
+    }
+
+    static inline JobSystem* s_JobSystem{nullptr};
+};
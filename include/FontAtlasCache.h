@@ -0,0 +1,430 @@
+#pragma once
+
+#include "imgui.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * \brief Persists a built ImFontAtlas (alpha texture, glyph tables, packed custom rects and font metrics) so later
+ * runs skip ImFontAtlas::Build() and its stb_truetype rasterization.
+ *
+ * Call after every font has been added and before the atlas is built:
+ *
+ *     if (!FontAtlasCache::Load(io.Fonts, path, dpiScale)) { io.Fonts->Build(); FontAtlasCache::Save(io.Fonts, path, dpiScale); }
+ *
+ * The cache is keyed by a hash of everything the build depends on: the TTF bytes and every ImFontConfig field that
+ * affects rasterization (size, glyph ranges, oversampling, offsets, merge mode...), the atlas flags and padding, the
+ * user's custom rects, the Dear ImGui version and the caller's DPI scale. Any mismatch, or a truncated file, falls
+ * back to a normal build. The file is memory-mapped on load and written to a temporary file then renamed on save, so
+ * a crash never leaves a half-written cache behind.
+ */
+class FontAtlasCache
+{
+public:
+    static constexpr char MAGIC[8] = {'C', 'P', 'G', 'F', 'O', 'N', 'T', '\0'};
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * \brief Restores Atlas from the cache at Path if its key matches; returns false (leaving Atlas untouched) otherwise
+     */
+    static bool Load(ImFontAtlas* Atlas, const char* Path, const float DpiScale)
+    {
+        if (Atlas->ConfigData.Size == 0 || Atlas->TexReady)
+            return false;
+
+        MappedFile file(Path);
+        if (!file.Data || file.Size < sizeof(Header))
+            return false;
+
+        Header header;
+        memcpy(&header, file.Data, sizeof(header));
+        if (memcmp(header.Magic, MAGIC, sizeof(MAGIC)) != 0 || header.Version != VERSION || header.Key != ComputeKey(Atlas, DpiScale)
+            || header.FontCount != static_cast<uint32_t>(Atlas->Fonts.Size) || header.FileSize != file.Size)
+            return false;
+
+        // validate the whole layout before touching the atlas
+        const size_t fontsOffset = sizeof(Header);
+        const size_t rectsOffset = fontsOffset + header.FontCount * sizeof(FontRecord);
+        size_t glyphsSize = 0;
+        if (rectsOffset > file.Size)
+            return false;
+        std::vector<FontRecord> fonts(header.FontCount);
+        memcpy(fonts.data(), file.Data + fontsOffset, fonts.size() * sizeof(FontRecord));
+        for (const FontRecord& font : fonts)
+        {
+            if (font.ConfigIndex < 0 || font.ConfigIndex >= Atlas->ConfigData.Size)
+                return false;
+            glyphsSize += static_cast<size_t>(font.GlyphCount) * sizeof(ImFontGlyph);
+        }
+        const size_t glyphsOffset = rectsOffset + header.CustomRectCount * sizeof(RectRecord);
+        const size_t pixelsOffset = glyphsOffset + glyphsSize;
+        const size_t pixelsSize = static_cast<size_t>(header.TexWidth) * static_cast<size_t>(header.TexHeight);
+        if (pixelsOffset + pixelsSize != file.Size)
+            return false;
+
+        Atlas->ClearTexData();
+        Atlas->TexWidth = header.TexWidth;
+        Atlas->TexHeight = header.TexHeight;
+        Atlas->TexUvScale = header.TexUvScale;
+        Atlas->TexUvWhitePixel = header.TexUvWhitePixel;
+        memcpy(Atlas->TexUvLines, header.TexUvLines, sizeof(Atlas->TexUvLines));
+        Atlas->PackIdMouseCursors = header.PackIdMouseCursors;
+        Atlas->PackIdLines = header.PackIdLines;
+        // the atlas owns its pixels (ClearTexData frees them), so they are copied out of the mapping
+        Atlas->TexPixelsAlpha8 = static_cast<unsigned char*>(IM_ALLOC(pixelsSize));
+        memcpy(Atlas->TexPixelsAlpha8, file.Data + pixelsOffset, pixelsSize);
+
+        Atlas->CustomRects.resize(static_cast<int>(header.CustomRectCount));
+        for (uint32_t i = 0; i < header.CustomRectCount; i++)
+        {
+            RectRecord record;
+            memcpy(&record, file.Data + rectsOffset + i * sizeof(RectRecord), sizeof(record));
+            ImFontAtlasCustomRect& rect = Atlas->CustomRects[static_cast<int>(i)];
+            rect.Width = record.Width;
+            rect.Height = record.Height;
+            rect.X = record.X;
+            rect.Y = record.Y;
+            rect.GlyphID = record.GlyphID;
+            rect.GlyphAdvanceX = record.GlyphAdvanceX;
+            rect.GlyphOffset = record.GlyphOffset;
+            rect.Font = record.FontIndex >= 0 && record.FontIndex < Atlas->Fonts.Size ? Atlas->Fonts[record.FontIndex] : nullptr;
+        }
+
+        size_t glyphOffset = glyphsOffset;
+        for (int i = 0; i < Atlas->Fonts.Size; i++)
+        {
+            const FontRecord& record = fonts[static_cast<size_t>(i)];
+            ImFont* font = Atlas->Fonts[i];
+            font->ClearOutputData();
+            font->FontSize = record.FontSize;
+            font->Ascent = record.Ascent;
+            font->Descent = record.Descent;
+            font->MetricsTotalSurface = record.MetricsTotalSurface;
+            font->ConfigData = &Atlas->ConfigData[record.ConfigIndex];
+            font->ConfigDataCount = static_cast<short>(record.ConfigDataCount);
+            font->ContainerAtlas = Atlas;
+            font->Glyphs.resize(static_cast<int>(record.GlyphCount));
+            memcpy(font->Glyphs.Data, file.Data + glyphOffset, record.GlyphCount * sizeof(ImFontGlyph));
+            glyphOffset += record.GlyphCount * sizeof(ImFontGlyph);
+            font->BuildLookupTable();
+        }
+
+        Atlas->TexReady = true;
+        return true;
+    }
+
+    /**
+     * \brief Writes the built Atlas to Path; call right after ImFontAtlas::Build() with the DpiScale given to Load()
+     */
+    static bool Save(const ImFontAtlas* Atlas, const char* Path, const float DpiScale)
+    {
+        if (Atlas->ConfigData.Size == 0 || !Atlas->TexReady || !Atlas->TexPixelsAlpha8)
+            return false;
+
+        Header header;
+        memcpy(header.Magic, MAGIC, sizeof(MAGIC));
+        header.Version = VERSION;
+        header.Key = ComputeKey(Atlas, DpiScale);
+        header.TexWidth = Atlas->TexWidth;
+        header.TexHeight = Atlas->TexHeight;
+        header.TexUvScale = Atlas->TexUvScale;
+        header.TexUvWhitePixel = Atlas->TexUvWhitePixel;
+        memcpy(header.TexUvLines, Atlas->TexUvLines, sizeof(header.TexUvLines));
+        header.PackIdMouseCursors = Atlas->PackIdMouseCursors;
+        header.PackIdLines = Atlas->PackIdLines;
+        header.FontCount = static_cast<uint32_t>(Atlas->Fonts.Size);
+        header.CustomRectCount = static_cast<uint32_t>(Atlas->CustomRects.Size);
+
+        std::vector<FontRecord> fonts(header.FontCount);
+        size_t glyphsSize = 0;
+        for (int i = 0; i < Atlas->Fonts.Size; i++)
+        {
+            const ImFont* font = Atlas->Fonts[i];
+            FontRecord& record = fonts[static_cast<size_t>(i)];
+            record.FontSize = font->FontSize;
+            record.Ascent = font->Ascent;
+            record.Descent = font->Descent;
+            record.MetricsTotalSurface = font->MetricsTotalSurface;
+            record.ConfigIndex = font->ConfigData ? static_cast<int32_t>(font->ConfigData - Atlas->ConfigData.Data) : -1;
+            record.ConfigDataCount = font->ConfigDataCount;
+            record.GlyphCount = static_cast<uint32_t>(font->Glyphs.Size);
+            glyphsSize += static_cast<size_t>(font->Glyphs.Size) * sizeof(ImFontGlyph);
+        }
+        std::vector<RectRecord> rects(header.CustomRectCount);
+        for (int i = 0; i < Atlas->CustomRects.Size; i++)
+            rects[static_cast<size_t>(i)] = MakeRectRecord(Atlas, Atlas->CustomRects[i]);
+
+        const size_t pixelsSize = static_cast<size_t>(Atlas->TexWidth) * static_cast<size_t>(Atlas->TexHeight);
+        header.FileSize = sizeof(Header) + fonts.size() * sizeof(FontRecord) + rects.size() * sizeof(RectRecord) + glyphsSize + pixelsSize;
+
+        const std::string temporaryPath = std::string(Path) + ".tmp";
+        FILE* file = fopen(temporaryPath.c_str(), "wb");
+        if (!file)
+            return false;
+        bool bWritten = fwrite(&header, sizeof(header), 1, file) == 1;
+        bWritten = bWritten && fwrite(fonts.data(), sizeof(FontRecord), fonts.size(), file) == fonts.size();
+        bWritten = bWritten && fwrite(rects.data(), sizeof(RectRecord), rects.size(), file) == rects.size();
+        for (int i = 0; i < Atlas->Fonts.Size && bWritten; i++)
+        {
+            const ImVector<ImFontGlyph>& glyphs = Atlas->Fonts[i]->Glyphs;
+            bWritten = fwrite(glyphs.Data, sizeof(ImFontGlyph), static_cast<size_t>(glyphs.Size), file) == static_cast<size_t>(glyphs.Size);
+        }
+        bWritten = bWritten && fwrite(Atlas->TexPixelsAlpha8, 1, pixelsSize, file) == pixelsSize;
+        bWritten = fclose(file) == 0 && bWritten;
+        if (!bWritten || !ReplaceFile(temporaryPath.c_str(), Path))
+        {
+            remove(temporaryPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * \brief Hash of every input of ImFontAtlas::Build(); rects the builder registers itself (PackIdMouseCursors,
+     * PackIdLines) are skipped so the key is the same before and after building
+     */
+    static uint64_t ComputeKey(const ImFontAtlas* Atlas, const float DpiScale)
+    {
+        KeyHasher hasher;
+        hasher.Add(IMGUI_VERSION_NUM);
+        hasher.Add(static_cast<uint32_t>(sizeof(ImFontGlyph)));
+        hasher.Add(DpiScale);
+        hasher.Add(Atlas->Flags);
+        hasher.Add(Atlas->TexDesiredWidth);
+        hasher.Add(Atlas->TexGlyphPadding);
+        hasher.Add(Atlas->FontBuilderFlags);
+
+        for (const ImFontConfig& config : Atlas->ConfigData)
+        {
+            hasher.Add(config.FontDataSize);
+            hasher.AddBytes(config.FontData, static_cast<size_t>(config.FontDataSize));
+            hasher.Add(config.FontNo);
+            hasher.Add(config.SizePixels);
+            hasher.Add(config.OversampleH);
+            hasher.Add(config.OversampleV);
+            hasher.Add(config.PixelSnapH);
+            hasher.Add(config.GlyphExtraSpacing);
+            hasher.Add(config.GlyphOffset);
+            hasher.Add(config.GlyphMinAdvanceX);
+            hasher.Add(config.GlyphMaxAdvanceX);
+            hasher.Add(config.MergeMode);
+            hasher.Add(config.FontBuilderFlags);
+            hasher.Add(config.RasterizerMultiply);
+            hasher.Add(config.EllipsisChar);
+            hasher.Add(FindFontIndex(Atlas, config.DstFont));
+            // zero-terminated pairs; a null pointer means the default ranges
+            const ImWchar* ranges = config.GlyphRanges;
+            size_t rangeCount = 0;
+            while (ranges && ranges[rangeCount])
+                rangeCount++;
+            hasher.Add(static_cast<uint64_t>(rangeCount));
+            hasher.AddBytes(ranges, rangeCount * sizeof(ImWchar));
+        }
+
+        for (int i = 0; i < Atlas->CustomRects.Size; i++)
+        {
+            if (i == Atlas->PackIdMouseCursors || i == Atlas->PackIdLines)
+                continue;
+            const ImFontAtlasCustomRect& rect = Atlas->CustomRects[i];
+            hasher.Add(rect.Width);
+            hasher.Add(rect.Height);
+            hasher.Add(rect.GlyphID);
+            hasher.Add(rect.GlyphAdvanceX);
+            hasher.Add(rect.GlyphOffset);
+            hasher.Add(FindFontIndex(Atlas, rect.Font));
+        }
+        return hasher.Hash;
+    }
+
+private:
+    struct Header
+    {
+        char Magic[8];
+        uint32_t Version;
+        uint32_t FontCount;
+        uint64_t Key;
+        uint64_t FileSize;
+        int32_t TexWidth;
+        int32_t TexHeight;
+        ImVec2 TexUvScale;
+        ImVec2 TexUvWhitePixel;
+        ImVec4 TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+        int32_t PackIdMouseCursors;
+        int32_t PackIdLines;
+        uint32_t CustomRectCount;
+        uint32_t Padding{0};
+    };
+
+    struct FontRecord
+    {
+        float FontSize;
+        float Ascent;
+        float Descent;
+        int32_t MetricsTotalSurface;
+        int32_t ConfigIndex;
+        int32_t ConfigDataCount;
+        uint32_t GlyphCount;
+    };
+
+    struct RectRecord
+    {
+        uint16_t Width;
+        uint16_t Height;
+        uint16_t X;
+        uint16_t Y;
+        uint32_t GlyphID;
+        float GlyphAdvanceX;
+        ImVec2 GlyphOffset;
+        int32_t FontIndex;
+    };
+
+    /**
+     * \brief 64-bit multiply-xorshift hash; the font data dominates, so it is consumed eight bytes at a time
+     */
+    struct KeyHasher
+    {
+        uint64_t Hash{0x9E3779B97F4A7C15ull};
+
+        void Mix(const uint64_t Value)
+        {
+            Hash = (Hash ^ Value) * 0xBF58476D1CE4E5B9ull;
+            Hash ^= Hash >> 31;
+        }
+
+        void AddBytes(const void* Data, const size_t Size)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(Data);
+            size_t offset = 0;
+            for (; offset + sizeof(uint64_t) <= Size; offset += sizeof(uint64_t))
+            {
+                uint64_t word;
+                memcpy(&word, bytes + offset, sizeof(word));
+                Mix(word);
+            }
+            uint64_t tail = 0;
+            if (offset < Size)
+                memcpy(&tail, bytes + offset, Size - offset);
+            Mix(tail ^ (static_cast<uint64_t>(Size) << 56));
+        }
+
+        template <typename T>
+        void Add(const T& Value)
+        {
+            AddBytes(&Value, sizeof(Value));
+        }
+    };
+
+    /**
+     * \brief Read-only mapping of a whole file; Data is null if the file is missing or empty
+     */
+    struct MappedFile
+    {
+        const unsigned char* Data{nullptr};
+        size_t Size{0};
+
+        explicit MappedFile(const char* Path)
+        {
+#if defined(_WIN32)
+            m_File = CreateFileA(Path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            LARGE_INTEGER size;
+            if (m_File == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_File, &size) || size.QuadPart == 0)
+                return;
+            m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!m_Mapping)
+                return;
+            Data = static_cast<const unsigned char*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+            Size = Data ? static_cast<size_t>(size.QuadPart) : 0;
+#else
+            const int descriptor = open(Path, O_RDONLY);
+            if (descriptor < 0)
+                return;
+            struct stat status;
+            if (fstat(descriptor, &status) == 0 && status.st_size > 0)
+            {
+                void* mapping = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+                if (mapping != MAP_FAILED)
+                {
+                    Data = static_cast<const unsigned char*>(mapping);
+                    Size = static_cast<size_t>(status.st_size);
+                }
+            }
+            // the mapping stays valid after the descriptor is closed
+            close(descriptor);
+#endif
+        }
+
+        ~MappedFile()
+        {
+#if defined(_WIN32)
+            if (Data)
+                UnmapViewOfFile(Data);
+            if (m_Mapping)
+                CloseHandle(m_Mapping);
+            if (m_File != INVALID_HANDLE_VALUE)
+                CloseHandle(m_File);
+#else
+            if (Data)
+                munmap(const_cast<unsigned char*>(Data), Size);
+#endif
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+#if defined(_WIN32)
+    private:
+        HANDLE m_File{INVALID_HANDLE_VALUE};
+        HANDLE m_Mapping{nullptr};
+#endif
+    };
+
+    static int32_t FindFontIndex(const ImFontAtlas* Atlas, const ImFont* Font)
+    {
+        for (int i = 0; i < Atlas->Fonts.Size; i++)
+        {
+            if (Atlas->Fonts[i] == Font)
+                return i;
+        }
+        return -1;
+    }
+
+    static RectRecord MakeRectRecord(const ImFontAtlas* Atlas, const ImFontAtlasCustomRect& Rect)
+    {
+        RectRecord record;
+        record.Width = Rect.Width;
+        record.Height = Rect.Height;
+        record.X = Rect.X;
+        record.Y = Rect.Y;
+        record.GlyphID = Rect.GlyphID;
+        record.GlyphAdvanceX = Rect.GlyphAdvanceX;
+        record.GlyphOffset = Rect.GlyphOffset;
+        record.FontIndex = FindFontIndex(Atlas, Rect.Font);
+        return record;
+    }
+
+    static bool ReplaceFile(const char* From, const char* To)
+    {
+#if defined(_WIN32)
+        return MoveFileExA(From, To, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+        return rename(From, To) == 0;
+#endif
+    }
+};
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * \brief Streaming quantile sketch over log-spaced buckets (as in DDSketch): every quantile is within ~1% of the true
+ * value, memory is fixed, and values can be removed again, which makes sliding windows cheap.
+ */
+class QuantileSketch
+{
+public:
+    static constexpr double MIN_VALUE = 0.01;
+    static constexpr double GAMMA = 1.02;
+    // MIN_VALUE * GAMMA^BUCKET_COUNT is ~76000; anything larger lands in the last bucket
+    static constexpr size_t BUCKET_COUNT = 1024;
+
+    void Add(const double Value)
+    {
+        m_Counts[GetBucket(Value)]++;
+        m_Count++;
+    }
+
+    /**
+     * \brief Removes a value previously passed to Add()
+     */
+    void Remove(const double Value)
+    {
+        uint32_t& count = m_Counts[GetBucket(Value)];
+        if (count == 0)
+            return;
+        count--;
+        m_Count--;
+    }
+
+    void Clear()
+    {
+        m_Counts.fill(0);
+        m_Count = 0;
+    }
+
+    [[nodiscard]] uint64_t GetCount() const { return m_Count; }
+
+    /**
+     * \brief Quantile Q in [0, 1]; 0 when the sketch is empty
+     */
+    [[nodiscard]] double GetQuantile(const double Q) const
+    {
+        double result = 0.0;
+        GetQuantiles(&Q, &result, 1);
+        return result;
+    }
+
+    /**
+     * \brief Evaluates several quantiles (in ascending order) in one pass over the buckets
+     */
+    void GetQuantiles(const double* Qs, double* Results, const size_t Count) const
+    {
+        size_t q = 0;
+        uint64_t cumulative = 0;
+        for (size_t bucket = 0; bucket < BUCKET_COUNT && q < Count; bucket++)
+        {
+            cumulative += m_Counts[bucket];
+            while (q < Count && m_Count > 0 && static_cast<double>(cumulative) > Qs[q] * static_cast<double>(m_Count - 1))
+                Results[q++] = GetBucketValue(bucket);
+        }
+        for (; q < Count; q++)
+            Results[q] = 0.0;
+    }
+
+private:
+    static size_t GetBucket(const double Value)
+    {
+        if (!(Value > MIN_VALUE))
+            return 0;
+        const double index = std::ceil(std::log(Value / MIN_VALUE) / std::log(GAMMA));
+        return std::min(static_cast<size_t>(index), BUCKET_COUNT - 1);
+    }
+
+    static double GetBucketValue(const size_t Bucket)
+    {
+        // bucket i holds (MIN * GAMMA^(i-1), MIN * GAMMA^i]; this point has the same relative error to both ends
+        return Bucket == 0 ? MIN_VALUE : MIN_VALUE * std::pow(GAMMA, static_cast<double>(Bucket)) * 2.0 / (GAMMA + 1.0);
+    }
+
+    std::array<uint32_t, BUCKET_COUNT> m_Counts{};
+    uint64_t m_Count{0};
+};
+
+/**
+ * \brief Frame-time statistics over rolling windows of recent frames, plus hitch detection.
+ *
+ * Each window keeps a QuantileSketch that the newest frame is added to and the frame leaving the window is removed
+ * from, so percentiles cost a bucket scan regardless of window length. A hitch is a frame that takes more than
+ * HitchFactor times the median of the shortest window.
+ */
+class FrameTimeAnalytics
+{
+public:
+    static constexpr size_t HISTORY_SIZE = 3600;
+    static constexpr size_t WINDOW_COUNT = 3;
+    static constexpr size_t WINDOW_FRAMES[WINDOW_COUNT] = {120, 600, HISTORY_SIZE};
+    static constexpr size_t HITCH_LOG_SIZE = 16;
+
+    struct WindowStats
+    {
+        size_t Frames{0};
+        double P50{0.0};
+        double P95{0.0};
+        double P99{0.0};
+        double Max{0.0};
+    };
+
+    struct Hitch
+    {
+        uint64_t Frame{0};
+        double Milliseconds{0.0};
+        double MedianMilliseconds{0.0};
+    };
+
+    // frames slower than HitchFactor x median, and at least MinHitchMilliseconds over it, count as hitches
+    float HitchFactor{2.0f};
+    float MinHitchMilliseconds{2.0f};
+
+    /**
+     * \brief Adds a frame time in milliseconds. Returns true if the frame is a hitch.
+     */
+    bool AddFrame(const double Milliseconds)
+    {
+        // judged against the frames before it, so a hitch does not raise its own threshold
+        const QuantileSketch& shortWindow = m_Windows[0];
+        const double median = shortWindow.GetQuantile(0.5);
+        const bool bHitch = shortWindow.GetCount() >= WINDOW_FRAMES[0] / 2 && Milliseconds > median * HitchFactor
+                            && Milliseconds - median >= MinHitchMilliseconds;
+
+        // windows add the stored (float) value so that the later Remove() hits the same bucket
+        const float value = static_cast<float>(Milliseconds);
+        for (size_t window = 0; window < WINDOW_COUNT; window++)
+        {
+            if (m_FrameCount >= WINDOW_FRAMES[window])
+                m_Windows[window].Remove(m_History[(m_FrameCount - WINDOW_FRAMES[window]) % HISTORY_SIZE]);
+            m_Windows[window].Add(value);
+        }
+        m_History[m_FrameCount % HISTORY_SIZE] = value;
+
+        if (bHitch)
+        {
+            m_Hitches[m_HitchCount % HITCH_LOG_SIZE] = Hitch{m_FrameCount, Milliseconds, median};
+            m_HitchCount++;
+        }
+        m_FrameCount++;
+        return bHitch;
+    }
+
+    [[nodiscard]] WindowStats GetWindowStats(const size_t Window) const
+    {
+        WindowStats stats;
+        stats.Frames = static_cast<size_t>(std::min<uint64_t>(m_FrameCount, WINDOW_FRAMES[Window]));
+
+        constexpr double QUANTILES[] = {0.5, 0.95, 0.99};
+        double results[3];
+        m_Windows[Window].GetQuantiles(QUANTILES, results, 3);
+        stats.P50 = results[0];
+        stats.P95 = results[1];
+        stats.P99 = results[2];
+
+        // the exact maximum comes from the history; a sliding max is not subtractable
+        for (size_t i = 0; i < stats.Frames; i++)
+            stats.Max = std::max(stats.Max, static_cast<double>(m_History[(m_FrameCount - 1 - i) % HISTORY_SIZE]));
+        return stats;
+    }
+
+    /**
+     * \brief Frame times in milliseconds, a ring of GetHistoryCount() entries starting at GetHistoryOffset()
+     */
+    [[nodiscard]] const float* GetHistory() const { return m_History.data(); }
+    [[nodiscard]] size_t GetHistoryCount() const { return static_cast<size_t>(std::min<uint64_t>(m_FrameCount, HISTORY_SIZE)); }
+    [[nodiscard]] size_t GetHistoryOffset() const { return m_FrameCount < HISTORY_SIZE ? 0 : m_FrameCount % HISTORY_SIZE; }
+
+    [[nodiscard]] uint64_t GetFrameCount() const { return m_FrameCount; }
+    [[nodiscard]] uint64_t GetHitchCount() const { return m_HitchCount; }
+
+    /**
+     * \brief Index-th most recent hitch, 0 being the latest; Index must be below min(GetHitchCount(), HITCH_LOG_SIZE)
+     */
+    [[nodiscard]] const Hitch& GetRecentHitch(const size_t Index) const { return m_Hitches[(m_HitchCount - 1 - Index) % HITCH_LOG_SIZE]; }
+
+private:
+    std::array<float, HISTORY_SIZE> m_History{};
+    std::array<QuantileSketch, WINDOW_COUNT> m_Windows{};
+    uint64_t m_FrameCount{0};
+
+    std::array<Hitch, HITCH_LOG_SIZE> m_Hitches{};
+    uint64_t m_HitchCount{0};
+};
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "FrameTimeAnalytics.h"
+
+#include "imgui.h"
+#include "implot/implot.h"
+
+#include <cstdio>
+
+/**
+ * \brief ImGui window with frame-time percentiles per window, a frame-time histogram and the recent hitches
+ */
+class FrameTimePanel
+{
+public:
+    explicit FrameTimePanel(FrameTimeAnalytics& Analytics) : m_Analytics(Analytics) {}
+
+    // when set, hitches write the preceding profiler frames to a snapshot file
+    bool bAutoCapture{true};
+
+    void SetLastSnapshot(const char* Path)
+    {
+        snprintf(m_LastSnapshot, sizeof(m_LastSnapshot), "%s", Path);
+    }
+
+    void Render()
+    {
+        ImGui::Begin("Frame Times");
+
+        if (ImGui::BeginTable("Windows", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+        {
+            ImGui::TableSetupColumn("Window");
+            ImGui::TableSetupColumn("p50");
+            ImGui::TableSetupColumn("p95");
+            ImGui::TableSetupColumn("p99");
+            ImGui::TableSetupColumn("Max");
+            ImGui::TableHeadersRow();
+
+            for (size_t window = 0; window < FrameTimeAnalytics::WINDOW_COUNT; window++)
+            {
+                const FrameTimeAnalytics::WindowStats stats = m_Analytics.GetWindowStats(window);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%zu frames", FrameTimeAnalytics::WINDOW_FRAMES[window]);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f ms", stats.P50);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f ms", stats.P95);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f ms", stats.P99);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.2f ms", stats.Max);
+            }
+            ImGui::EndTable();
+        }
+
+        const int count = static_cast<int>(m_Analytics.GetHistoryCount());
+        if (count > 0 && ImPlot::BeginPlot("Frame time distribution", ImVec2(-1, 200)))
+        {
+            const FrameTimeAnalytics::WindowStats stats = m_Analytics.GetWindowStats(FrameTimeAnalytics::WINDOW_COUNT - 1);
+            const double percentiles[] = {stats.P50, stats.P95, stats.P99};
+
+            ImPlot::SetupAxes("ms", "frames", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+            ImPlot::PlotHistogram("Frames", m_Analytics.GetHistory(), count, 100);
+            ImPlot::PlotInfLines("p50 / p95 / p99", percentiles, 3);
+            ImPlot::EndPlot();
+        }
+
+        ImGui::SliderFloat("Hitch threshold (x median)", &m_Analytics.HitchFactor, 1.5f, 5.0f, "%.1f");
+        ImGui::SliderFloat("Minimum hitch (ms over median)", &m_Analytics.MinHitchMilliseconds, 0.0f, 20.0f, "%.1f");
+        ImGui::Checkbox("Write profiler snapshot on hitch", &bAutoCapture);
+
+        ImGui::Text("%llu hitches in %llu frames", static_cast<unsigned long long>(m_Analytics.GetHitchCount()),
+                    static_cast<unsigned long long>(m_Analytics.GetFrameCount()));
+        if (m_LastSnapshot[0])
+            ImGui::Text("Last snapshot: %s", m_LastSnapshot);
+
+        const size_t hitchesShown = static_cast<size_t>(
+            std::min<uint64_t>(m_Analytics.GetHitchCount(), FrameTimeAnalytics::HITCH_LOG_SIZE));
+        for (size_t i = 0; i < hitchesShown; i++)
+        {
+            const FrameTimeAnalytics::Hitch& hitch = m_Analytics.GetRecentHitch(i);
+            ImGui::BulletText("frame %llu: %.2f ms (median %.2f ms)", static_cast<unsigned long long>(hitch.Frame),
+                              hitch.Milliseconds, hitch.MedianMilliseconds);
+        }
+
+        ImGui::End();
+    }
+
+private:
+    FrameTimeAnalytics& m_Analytics;
+    char m_LastSnapshot[256]{};
+};
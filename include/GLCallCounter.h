@@ -0,0 +1,98 @@
+#pragma once
+
+#include "glad/glad.h"
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+// GL entry points counted by GLCallCounter; extend as needed
+#define GL_COUNTED_CALLS(X)                                                                                            \
+    X(glActiveTexture)                                                                                                 \
+    X(glBindBuffer)                                                                                                    \
+    X(glBindTexture)                                                                                                   \
+    X(glBindVertexArray)                                                                                               \
+    X(glBufferData)                                                                                                    \
+    X(glBufferSubData)                                                                                                 \
+    X(glClear)                                                                                                         \
+    X(glDrawArrays)                                                                                                    \
+    X(glDrawElements)                                                                                                  \
+    X(glGetUniformLocation)                                                                                            \
+    X(glTexImage2D)                                                                                                    \
+    X(glUniform1i)                                                                                                     \
+    X(glUniformMatrix4fv)                                                                                              \
+    X(glUseProgram)                                                                                                    \
+    X(glViewport)
+
+/**
+ * \brief Counts calls to the GL functions in GL_COUNTED_CALLS by replacing glad's function pointers with counting
+ * trampolines. Install() after gladLoadGLLoader(), on the thread that owns the context.
+ *
+ * Only calls made through glad are seen; the ImGui OpenGL backend has its own loader, so its draws are not included.
+ */
+class GLCallCounter
+{
+public:
+    enum Call : uint32_t
+    {
+#define GL_COUNTED_CALL_ENUM(Name) Name##_CALL,
+        GL_COUNTED_CALLS(GL_COUNTED_CALL_ENUM)
+#undef GL_COUNTED_CALL_ENUM
+        CALL_COUNT
+    };
+
+    static void Install()
+    {
+#define GL_COUNTED_CALL_INSTALL(Name) Hook<glad_##Name>::Install(Name##_CALL);
+        GL_COUNTED_CALLS(GL_COUNTED_CALL_INSTALL)
+#undef GL_COUNTED_CALL_INSTALL
+    }
+
+    [[nodiscard]] static uint64_t GetCount(const uint32_t Index) { return s_Counts[Index].load(std::memory_order_relaxed); }
+
+    static const char* GetName(const uint32_t Index)
+    {
+        static constexpr const char* NAMES[] = {
+#define GL_COUNTED_CALL_NAME(Name) #Name,
+            GL_COUNTED_CALLS(GL_COUNTED_CALL_NAME)
+#undef GL_COUNTED_CALL_NAME
+        };
+        return NAMES[Index];
+    }
+
+    [[nodiscard]] static uint64_t GetTotalCount()
+    {
+        uint64_t total = 0;
+        for (uint32_t i = 0; i < CALL_COUNT; i++)
+            total += GetCount(i);
+        return total;
+    }
+
+private:
+    template <auto& Slot, typename Function = std::remove_reference_t<decltype(Slot)>>
+    struct Hook;
+
+    template <auto& Slot, typename Result, typename... Args>
+    struct Hook<Slot, Result(APIENTRYP)(Args...)>
+    {
+        static void Install(const uint32_t Index)
+        {
+            if (!Slot || Slot == &Trampoline)
+                return;
+            s_Original = Slot;
+            s_Index = Index;
+            Slot = &Trampoline;
+        }
+
+        static Result APIENTRY Trampoline(Args... Arguments)
+        {
+            s_Counts[s_Index].fetch_add(1, std::memory_order_relaxed);
+            return s_Original(Arguments...);
+        }
+
+        static inline Result(APIENTRYP s_Original)(Args...){nullptr};
+        static inline uint32_t s_Index{0};
+    };
+
+    static inline std::atomic<uint64_t> s_Counts[CALL_COUNT]{};
+};
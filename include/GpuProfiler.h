@@ -0,0 +1,229 @@
+#pragma once
+
+#include "glad/glad.h"
+
+#include "LegitProfiler/ProfilerTask.h"
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * \brief GPU pass timings from GL_TIMESTAMP queries, without ever waiting on the GPU.
+ *
+ * Each frame records a timestamp at its start and one at the beginning and end of every scope. Query sets are kept in a
+ * ring of FRAME_SLOTS frames and polled with GL_QUERY_RESULT_AVAILABLE, so results are typically read two or three
+ * frames after submission. A frame whose results are still pending when its slot comes around again is dropped.
+ *
+ * Recording and collection happen on the render thread (Init/Shutdown/BeginFrame/EndFrame/scopes, with the profiled
+ * context current); ConsumeResults() hands the newest completed frame to the main thread.
+ */
+class GpuProfiler
+{
+public:
+    static constexpr uint32_t FRAME_SLOTS = 4;
+    static constexpr uint32_t MAX_SCOPES = 32;
+
+    GpuProfiler() = default;
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    void Init()
+    {
+        for (FrameQueries& frame : m_Frames)
+        {
+            glGenQueries(static_cast<GLsizei>(frame.Queries.size()), frame.Queries.data());
+        }
+        m_bInitialized = true;
+    }
+
+    void Shutdown()
+    {
+        if (!m_bInitialized)
+            return;
+
+        for (FrameQueries& frame : m_Frames)
+        {
+            glDeleteQueries(static_cast<GLsizei>(frame.Queries.size()), frame.Queries.data());
+        }
+        m_bInitialized = false;
+    }
+
+    void BeginFrame()
+    {
+        CollectFinishedFrames();
+
+        FrameQueries& frame = m_Frames[m_WriteFrame % FRAME_SLOTS];
+        if (frame.bPending)
+            m_DroppedFrames++;
+
+        frame.ScopeCount = 0;
+        frame.QueryCount = 1;
+        frame.bPending = false;
+        glQueryCounter(frame.Queries[0], GL_TIMESTAMP);
+    }
+
+    void EndFrame()
+    {
+        FrameQueries& frame = m_Frames[m_WriteFrame % FRAME_SLOTS];
+        frame.bPending = true;
+        m_WriteFrame++;
+    }
+
+    /**
+     * \brief Starts a timed scope. Returns the scope to pass to EndScope().
+     */
+    uint32_t BeginScope(const char* Name, const uint32_t Color) { return BeginScope(legit::TaskNames::Intern(Name), Color); }
+
+    /**
+     * \brief Starts a timed scope named by an ID from legit::TaskNames::Intern(), for call sites that intern once
+     */
+    uint32_t BeginScope(const uint32_t NameId, const uint32_t Color)
+    {
+        FrameQueries& frame = m_Frames[m_WriteFrame % FRAME_SLOTS];
+        if (frame.ScopeCount == MAX_SCOPES)
+            return MAX_SCOPES;
+
+        Scope& scope = frame.Scopes[frame.ScopeCount];
+        scope.NameId = NameId;
+        scope.Color = Color;
+        scope.BeginQuery = frame.QueryCount++;
+        scope.EndQuery = scope.BeginQuery;
+        glQueryCounter(frame.Queries[scope.BeginQuery], GL_TIMESTAMP);
+        return frame.ScopeCount++;
+    }
+
+    void EndScope(const uint32_t ScopeIndex)
+    {
+        if (ScopeIndex == MAX_SCOPES)
+            return;
+
+        FrameQueries& frame = m_Frames[m_WriteFrame % FRAME_SLOTS];
+        Scope& scope = frame.Scopes[ScopeIndex];
+        scope.EndQuery = frame.QueryCount++;
+        glQueryCounter(frame.Queries[scope.EndQuery], GL_TIMESTAMP);
+    }
+
+    /**
+     * \brief Copies the newest completed frame into Tasks (seconds relative to the frame start). Returns false if no
+     * new frame completed since the last call. Safe to call from any thread.
+     */
+    bool ConsumeResults(std::vector<legit::ProfilerTask>& Tasks)
+    {
+        std::lock_guard lock(m_ResultMutex);
+        if (!m_bHasNewResult)
+            return false;
+
+        Tasks.resize(m_Result.size());
+        for (size_t i = 0; i < m_Result.size(); i++)
+        {
+            Tasks[i].startTime = m_Result[i].startTime;
+            Tasks[i].endTime = m_Result[i].endTime;
+            Tasks[i].nameId = m_Result[i].nameId;
+            Tasks[i].color = m_Result[i].color;
+        }
+        m_bHasNewResult = false;
+        return true;
+    }
+
+    [[nodiscard]] uint64_t GetDroppedFrameCount() const { return m_DroppedFrames; }
+
+private:
+    struct Scope
+    {
+        uint32_t NameId{0};
+        uint32_t Color{0};
+        uint32_t BeginQuery{0};
+        uint32_t EndQuery{0};
+    };
+
+    struct FrameQueries
+    {
+        std::array<GLuint, 1 + MAX_SCOPES * 2> Queries{};
+        std::array<Scope, MAX_SCOPES> Scopes{};
+        uint32_t ScopeCount{0};
+        uint32_t QueryCount{0};
+        bool bPending{false};
+    };
+
+    void CollectFinishedFrames()
+    {
+        // oldest first; results become available in submission order, so stop at the first frame still in flight
+        const uint64_t oldestFrame = m_WriteFrame >= FRAME_SLOTS ? m_WriteFrame - FRAME_SLOTS : 0;
+        for (uint64_t frameIndex = oldestFrame; frameIndex < m_WriteFrame; frameIndex++)
+        {
+            FrameQueries& frame = m_Frames[frameIndex % FRAME_SLOTS];
+            if (!frame.bPending)
+                continue;
+
+            GLint bAvailable = 0;
+            glGetQueryObjectiv(frame.Queries[frame.QueryCount - 1], GL_QUERY_RESULT_AVAILABLE, &bAvailable);
+            if (!bAvailable)
+                break;
+
+            ReadFrame(frame);
+            frame.bPending = false;
+        }
+    }
+
+    void ReadFrame(const FrameQueries& Frame)
+    {
+        GLuint64 frameBegin = 0;
+        glGetQueryObjectui64v(Frame.Queries[0], GL_QUERY_RESULT, &frameBegin);
+
+        m_Scratch.resize(Frame.ScopeCount);
+        for (uint32_t i = 0; i < Frame.ScopeCount; i++)
+        {
+            const Scope& scope = Frame.Scopes[i];
+            GLuint64 begin = 0;
+            GLuint64 end = 0;
+            glGetQueryObjectui64v(Frame.Queries[scope.BeginQuery], GL_QUERY_RESULT, &begin);
+            glGetQueryObjectui64v(Frame.Queries[scope.EndQuery], GL_QUERY_RESULT, &end);
+
+            m_Scratch[i].startTime = static_cast<double>(begin - frameBegin) * 1e-9;
+            m_Scratch[i].endTime = static_cast<double>(end - frameBegin) * 1e-9;
+            m_Scratch[i].nameId = scope.NameId;
+            m_Scratch[i].color = scope.Color;
+        }
+
+        std::lock_guard lock(m_ResultMutex);
+        m_Result.swap(m_Scratch);
+        m_bHasNewResult = true;
+    }
+
+    std::array<FrameQueries, FRAME_SLOTS> m_Frames{};
+    uint64_t m_WriteFrame{0};
+    uint64_t m_DroppedFrames{0};
+    bool m_bInitialized{false};
+
+    std::vector<legit::ProfilerTask> m_Scratch;
+    std::mutex m_ResultMutex;
+    std::vector<legit::ProfilerTask> m_Result;
+    bool m_bHasNewResult{false};
+};
+
+/**
+ * \brief Times the GL commands issued during its lifetime
+ */
+class GpuProfileScope
+{
+public:
+    GpuProfileScope(GpuProfiler& Profiler, const char* Name, const uint32_t Color)
+        : m_Profiler(Profiler), m_Scope(Profiler.BeginScope(Name, Color))
+    {
+    }
+
+    ~GpuProfileScope()
+    {
+        m_Profiler.EndScope(m_Scope);
+    }
+
+    GpuProfileScope(const GpuProfileScope&) = delete;
+    GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+private:
+    GpuProfiler& m_Profiler;
+    uint32_t m_Scope;
+};
@@ -0,0 +1,738 @@
+#pragma once
+
+#include "AllocationTracker.h"
+#include "CpuProfiler.h"
+#include "SamplingProfiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+ * \brief Which thread may execute a job. GL calls must run where the context is current (the render thread).
+ */
+enum class JobAffinity : uint8_t
+{
+    ANY,
+    MAIN_THREAD,
+    RENDER_THREAD,
+    COUNT,
+};
+
+struct Job;
+using JobFunction = void (*)(Job&);
+
+/**
+ * \brief Unit of work. Jobs are pool-allocated per thread and carry their callable inline, so scheduling does not allocate.
+ */
+struct alignas(64) Job
+{
+    static constexpr size_t PAYLOAD_SIZE = 96;
+    static constexpr uint32_t MAX_DEPENDENTS = 6;
+
+    JobFunction Entry{nullptr};
+    void (*DestroyPayload)(Job&){nullptr};
+    Job* Parent{nullptr};
+    std::atomic<int32_t> Unfinished{0};
+    std::atomic<int32_t> PendingDependencies{0};
+    uint32_t DependentCount{0};
+    JobAffinity Affinity{JobAffinity::ANY};
+    Job* Dependents[MAX_DEPENDENTS]{};
+    alignas(16) unsigned char Payload[PAYLOAD_SIZE];
+
+    template <typename T>
+    T& GetPayload() { return *std::launder(reinterpret_cast<T*>(Payload)); }
+
+    [[nodiscard]] bool IsFinished() const { return Unfinished.load(std::memory_order_acquire) <= 0; }
+};
+
+/**
+ * \brief Chase-Lev work-stealing deque (Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models").
+ * The owner pushes and pops at the bottom, thieves steal from the top. Fixed capacity; Push fails when full.
+ */
+class WorkStealingDeque
+{
+public:
+    static constexpr int64_t CAPACITY = 4096;
+
+    enum class StealResult
+    {
+        SUCCESS,
+        EMPTY,
+        CONTENDED,
+    };
+
+    bool Push(Job* Item)
+    {
+        const int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+        const int64_t top = m_Top.load(std::memory_order_acquire);
+        if (bottom - top >= CAPACITY)
+            return false;
+
+        m_Buffer[bottom & MASK].store(Item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    Job* Pop()
+    {
+        const int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+        m_Bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_Top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Job* item = m_Buffer[bottom & MASK].load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            // last item: race against thieves for it
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                item = nullptr;
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    StealResult Steal(Job*& OutItem)
+    {
+        int64_t top = m_Top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+        if (top >= bottom)
+            return StealResult::EMPTY;
+
+        Job* item = m_Buffer[top & MASK].load(std::memory_order_relaxed);
+        if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return StealResult::CONTENDED;
+
+        OutItem = item;
+        return StealResult::SUCCESS;
+    }
+
+    [[nodiscard]] int64_t Size() const
+    {
+        return std::max<int64_t>(0, m_Bottom.load(std::memory_order_relaxed) - m_Top.load(std::memory_order_relaxed));
+    }
+
+private:
+    static constexpr int64_t MASK = CAPACITY - 1;
+    static_assert((CAPACITY & MASK) == 0, "Deque capacity must be a power of two");
+
+    alignas(64) std::atomic<int64_t> m_Top{0};
+    alignas(64) std::atomic<int64_t> m_Bottom{0};
+    alignas(64) std::array<std::atomic<Job*>, CAPACITY> m_Buffer{};
+};
+
+/**
+ * \brief Per-worker counters, written only by their worker and read by the instrumentation panel
+ */
+struct alignas(64) WorkerStats
+{
+    std::atomic<uint64_t> JobsExecuted{0};
+    std::atomic<uint64_t> JobsStolen{0};
+    std::atomic<uint64_t> StealAttempts{0};
+    std::atomic<uint64_t> StealContended{0};
+    std::atomic<uint64_t> DequeOverflows{0};
+    std::atomic<uint64_t> Sleeps{0};
+    std::atomic<uint64_t> BusyNanoseconds{0};
+
+    void Reset()
+    {
+        JobsExecuted = 0;
+        JobsStolen = 0;
+        StealAttempts = 0;
+        StealContended = 0;
+        DequeOverflows = 0;
+        Sleeps = 0;
+        BusyNanoseconds = 0;
+    }
+};
+
+struct JobSystemDesc
+{
+    // total number of threads executing jobs, including the main thread; 0 = one per hardware thread
+    uint32_t ThreadCount{0};
+    // pin worker i to core i (the main thread is left alone)
+    bool bPinThreads{false};
+};
+
+/**
+ * \brief Work-stealing task scheduler.
+ *
+ * Thread 0 is the thread that created the JobSystem (the main thread); it executes jobs while it waits. Every worker owns a
+ * Chase-Lev deque and steals from the others when its own runs dry. Jobs with a thread affinity bypass the deques and are
+ * queued until that thread calls RunAffineJobs().
+ */
+class JobSystem
+{
+public:
+    static constexpr uint32_t JOB_POOL_SIZE = 4096;
+
+    explicit JobSystem(const JobSystemDesc& Desc = JobSystemDesc())
+    {
+        // by default keep at least one background worker so that scheduled work progresses while the main thread is busy;
+        // an explicit ThreadCount of 1 runs every job on the main thread while it waits
+        const uint32_t threadCount = Desc.ThreadCount ? Desc.ThreadCount : std::max(std::thread::hardware_concurrency(), 2u);
+
+        m_Workers.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; i++)
+        {
+            m_Workers.push_back(std::make_unique<Worker>());
+        }
+
+        // the creating thread becomes worker 0; remember what it was registered with before (nested job systems)
+        m_CreatorContext = s_Current;
+        s_Current.System = this;
+        s_Current.WorkerIndex = 0;
+
+        for (uint32_t i = 1; i < threadCount; i++)
+        {
+            m_Workers[i]->Thread = std::thread([this, i, bPin = Desc.bPinThreads]()
+            {
+                if (bPin)
+                    PinCurrentThread(i);
+                WorkerMain(i);
+            });
+        }
+    }
+
+    ~JobSystem()
+    {
+        {
+            std::lock_guard lock(m_SleepMutex);
+            m_bStopping = true;
+        }
+        m_SleepCond.notify_all();
+
+        for (auto& worker : m_Workers)
+        {
+            if (worker->Thread.joinable())
+                worker->Thread.join();
+        }
+
+        if (s_Current.System == this)
+            s_Current = m_CreatorContext;
+    }
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    JobSystem(JobSystem&&) = delete;
+    JobSystem& operator=(JobSystem&&) = delete;
+
+    [[nodiscard]] uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+
+    [[nodiscard]] const WorkerStats& GetWorkerStats(const uint32_t WorkerIndex) const { return m_Workers[WorkerIndex]->Stats; }
+
+    void ResetStats()
+    {
+        for (auto& worker : m_Workers)
+            worker->Stats.Reset();
+    }
+
+    /**
+     * \brief Index of the calling thread in this job system, or -1 if it is not one of its threads
+     */
+    [[nodiscard]] int32_t GetCurrentWorkerIndex() const
+    {
+        return s_Current.System == this ? s_Current.WorkerIndex : -1;
+    }
+
+    /**
+     * \brief Allocates a job that runs Function. The job is not scheduled until Schedule() is called.
+     * \param Parent Optional job that only completes once this job has completed
+     */
+    template <typename F>
+    Job* CreateJob(F&& Function, Job* Parent = nullptr, const JobAffinity Affinity = JobAffinity::ANY)
+    {
+        using Callable = std::decay_t<F>;
+        static_assert(sizeof(Callable) <= Job::PAYLOAD_SIZE, "Job callable too large; capture by reference or pointer");
+        static_assert(alignof(Callable) <= 16, "Job callable over-aligned");
+
+        Job* job = AllocateJob();
+        job->Entry = [](Job& Self) { Self.GetPayload<Callable>()(); };
+        job->DestroyPayload = std::is_trivially_destructible_v<Callable> ? nullptr : +[](Job& Self) { Self.GetPayload<Callable>().~Callable(); };
+        new (job->Payload) Callable(std::forward<F>(Function));
+        job->Parent = Parent;
+        job->Unfinished.store(1, std::memory_order_relaxed);
+        // held until Schedule(), so that neither it nor the last dependency to finish can queue the job alone
+        job->PendingDependencies.store(1, std::memory_order_relaxed);
+        job->DependentCount = 0;
+        job->Affinity = Affinity;
+
+        if (Parent)
+            Parent->Unfinished.fetch_add(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    /**
+     * \brief Creates an empty job, useful as a parent to wait on a group of jobs
+     */
+    Job* CreateGroup(Job* Parent = nullptr)
+    {
+        return CreateJob([]() {}, Parent);
+    }
+
+    /**
+     * \brief Makes After wait for Before. Must be called before either job is scheduled; they may then be scheduled in
+     * any order.
+     */
+    static void AddDependency(Job* Before, Job* After)
+    {
+        assert(Before->DependentCount < Job::MAX_DEPENDENTS && "Too many dependents; insert an intermediate group job");
+        Before->Dependents[Before->DependentCount++] = After;
+        After->PendingDependencies.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * \brief Queues the job for execution once all of its dependencies have completed
+     */
+    void Schedule(Job* Task)
+    {
+        // otherwise the last dependency to finish queues it
+        if (Task->PendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            Enqueue(Task);
+    }
+
+    template <typename F>
+    Job* Run(F&& Function, Job* Parent = nullptr, const JobAffinity Affinity = JobAffinity::ANY)
+    {
+        Job* job = CreateJob(std::forward<F>(Function), Parent, Affinity);
+        Schedule(job);
+        return job;
+    }
+
+    /**
+     * \brief Executes other jobs until Job has completed
+     */
+    void Wait(const Job* Task)
+    {
+        const int32_t workerIndex = GetCurrentWorkerIndex();
+        uint32_t idleSpins = 0;
+        while (!Task->IsFinished())
+        {
+            if (workerIndex >= 0 && TryExecuteOne(static_cast<uint32_t>(workerIndex)))
+            {
+                idleSpins = 0;
+                continue;
+            }
+
+            // the waited-on job may be affine to this thread
+            if (workerIndex == 0 && RunAffineJobs(JobAffinity::MAIN_THREAD) > 0)
+                continue;
+
+            if (++idleSpins > 64)
+                std::this_thread::yield();
+        }
+    }
+
+    /**
+     * \brief Runs Function(Begin, End) over [First, Last) in parallel and waits for completion.
+     *
+     * Ranges are split lazily: a task keeps halving its remaining range into stealable jobs only while its own deque is
+     * empty, so the effective grain adapts to how busy the other workers are. MinGrain bounds the smallest chunk.
+     */
+    template <typename F>
+    void ParallelFor(const size_t First, const size_t Last, F&& Function, size_t MinGrain = 0)
+    {
+        if (First >= Last)
+            return;
+
+        const size_t count = Last - First;
+        if (MinGrain == 0)
+            MinGrain = std::max<size_t>(1, count / (GetThreadCount() * 64));
+
+        Job* root = CreateGroup();
+        ParallelForRange<std::remove_reference_t<F>>(root, &Function, First, Last, MinGrain);
+        Schedule(root);
+        Wait(root);
+    }
+
+    /**
+     * \brief Executes queued jobs that must run on the calling thread. Returns the number of jobs executed.
+     */
+    uint32_t RunAffineJobs(const JobAffinity Affinity)
+    {
+        AffineQueue& queue = m_AffineQueues[static_cast<size_t>(Affinity)];
+        uint32_t executed = 0;
+        while (true)
+        {
+            Job* job = nullptr;
+            {
+                std::lock_guard lock(queue.Mutex);
+                if (queue.Jobs.empty())
+                    break;
+                job = queue.Jobs.front();
+                queue.Jobs.pop_front();
+            }
+            Execute(job, nullptr);
+            executed++;
+        }
+        return executed;
+    }
+
+    /**
+     * \brief Registers a function called whenever a job is queued for Affinity, so that the owning thread can wake up
+     * and call RunAffineJobs() without waiting for its next frame
+     */
+    void SetAffinityNotify(const JobAffinity Affinity, void (*Callback)(void*), void* UserData)
+    {
+        AffineQueue& queue = m_AffineQueues[static_cast<size_t>(Affinity)];
+        std::lock_guard lock(queue.Mutex);
+        queue.Notify = Callback;
+        queue.NotifyUserData = UserData;
+    }
+
+    [[nodiscard]] size_t GetAffineQueueSize(const JobAffinity Affinity)
+    {
+        AffineQueue& queue = m_AffineQueues[static_cast<size_t>(Affinity)];
+        std::lock_guard lock(queue.Mutex);
+        return queue.Jobs.size();
+    }
+
+private:
+    struct alignas(64) Worker
+    {
+        WorkStealingDeque Deque;
+        WorkerStats Stats;
+        std::unique_ptr<Job[]> JobPool{new Job[JOB_POOL_SIZE]};
+        uint32_t NextPoolIndex{0};
+        uint32_t StealSeed{0x9E3779B9u};
+        std::thread Thread;
+    };
+
+    struct AffineQueue
+    {
+        std::mutex Mutex;
+        std::deque<Job*> Jobs;
+        void (*Notify)(void*){nullptr};
+        void* NotifyUserData{nullptr};
+    };
+
+    struct ThreadContext
+    {
+        JobSystem* System{nullptr};
+        int32_t WorkerIndex{-1};
+    };
+
+    template <typename F>
+    void ParallelForRange(Job* Parent, F* Function, size_t Begin, size_t End, const size_t MinGrain)
+    {
+        Run([this, Parent, Function, Begin, End, MinGrain]() mutable
+        {
+            const int32_t workerIndex = GetCurrentWorkerIndex();
+            size_t first = Begin;
+            size_t last = End;
+            while (first < last)
+            {
+                // offer half of the remaining range to thieves whenever our own deque has nothing to steal
+                if (last - first >= 2 * MinGrain && workerIndex >= 0 && m_Workers[workerIndex]->Deque.Size() == 0)
+                {
+                    const size_t mid = first + (last - first) / 2;
+                    ParallelForRange(Parent, Function, mid, last, MinGrain);
+                    last = mid;
+                    continue;
+                }
+
+                const size_t chunkEnd = std::min(last, first + MinGrain);
+                (*Function)(first, chunkEnd);
+                first = chunkEnd;
+            }
+        }, Parent);
+    }
+
+    Job* AllocateJob()
+    {
+        const int32_t workerIndex = GetCurrentWorkerIndex();
+        if (workerIndex >= 0)
+        {
+            Worker& worker = *m_Workers[workerIndex];
+            return TakeFinishedJob(worker.JobPool.get(), worker.NextPoolIndex);
+        }
+
+        // threads outside the job system share one locked pool
+        std::lock_guard lock(m_ExternalPoolMutex);
+        return TakeFinishedJob(m_ExternalPool.get(), m_ExternalPoolIndex);
+    }
+
+    /**
+     * \brief Next free slot of a pool handed out round-robin; slots still in use (a long-lived group, say) are skipped
+     */
+    static Job* TakeFinishedJob(Job* Pool, uint32_t& NextIndex)
+    {
+        for (uint32_t attempt = 0; attempt < JOB_POOL_SIZE; attempt++)
+        {
+            Job* job = &Pool[NextIndex++ & (JOB_POOL_SIZE - 1)];
+            if (job->IsFinished())
+                return job;
+        }
+
+        // reusing a live job would corrupt it
+        std::cout << "Job pool exhausted: " << JOB_POOL_SIZE << " unfinished jobs created by one thread" << std::endl;
+        std::abort();
+    }
+
+    void Enqueue(Job* Task)
+    {
+        if (Task->Affinity != JobAffinity::ANY)
+        {
+            AffineQueue& queue = m_AffineQueues[static_cast<size_t>(Task->Affinity)];
+            std::lock_guard lock(queue.Mutex);
+            queue.Jobs.push_back(Task);
+            if (queue.Notify)
+                queue.Notify(queue.NotifyUserData);
+            return;
+        }
+
+        const int32_t workerIndex = GetCurrentWorkerIndex();
+        if (workerIndex >= 0)
+        {
+            Worker& worker = *m_Workers[workerIndex];
+            if (!worker.Deque.Push(Task))
+            {
+                // deque full: run inline rather than growing the deque
+                worker.Stats.DequeOverflows.fetch_add(1, std::memory_order_relaxed);
+                Execute(Task, &worker.Stats);
+                return;
+            }
+        }
+        else
+        {
+            std::lock_guard lock(m_InjectionMutex);
+            m_InjectionQueue.push_back(Task);
+            m_InjectionSize.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // pairs with the fence in WorkerMain before a worker goes to sleep
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_SleepingWorkers.load(std::memory_order_relaxed) > 0)
+        {
+            std::lock_guard lock(m_SleepMutex);
+            m_SleepCond.notify_one();
+        }
+    }
+
+    bool TryExecuteOne(const uint32_t WorkerIndex)
+    {
+        Worker& worker = *m_Workers[WorkerIndex];
+        Job* job = worker.Deque.Pop();
+
+        if (!job && m_InjectionSize.load(std::memory_order_relaxed) > 0)
+        {
+            std::lock_guard lock(m_InjectionMutex);
+            if (!m_InjectionQueue.empty())
+            {
+                job = m_InjectionQueue.front();
+                m_InjectionQueue.pop_front();
+                m_InjectionSize.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+
+        if (!job)
+            job = TrySteal(WorkerIndex);
+
+        if (!job)
+            return false;
+
+        Execute(job, &worker.Stats);
+        return true;
+    }
+
+    Job* TrySteal(const uint32_t WorkerIndex)
+    {
+        Worker& worker = *m_Workers[WorkerIndex];
+        const uint32_t workerCount = GetThreadCount();
+
+        // xorshift to pick a random first victim, then scan the rest
+        uint32_t seed = worker.StealSeed;
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        worker.StealSeed = seed;
+
+        for (uint32_t i = 0; i < workerCount; i++)
+        {
+            const uint32_t victim = (seed + i) % workerCount;
+            if (victim == WorkerIndex)
+                continue;
+
+            worker.Stats.StealAttempts.fetch_add(1, std::memory_order_relaxed);
+            Job* job = nullptr;
+            const WorkStealingDeque::StealResult result = m_Workers[victim]->Deque.Steal(job);
+            if (result == WorkStealingDeque::StealResult::SUCCESS)
+            {
+                worker.Stats.JobsStolen.fetch_add(1, std::memory_order_relaxed);
+                return job;
+            }
+            if (result == WorkStealingDeque::StealResult::CONTENDED)
+                worker.Stats.StealContended.fetch_add(1, std::memory_order_relaxed);
+        }
+        return nullptr;
+    }
+
+    void Execute(Job* Task, WorkerStats* Stats)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        Task->Entry(*Task);
+        // what the callable captured is released now rather than when the slot is reused
+        if (Task->DestroyPayload)
+        {
+            Task->DestroyPayload(*Task);
+            Task->DestroyPayload = nullptr;
+        }
+        Finish(Task);
+
+        if (Stats)
+        {
+            Stats->JobsExecuted.fetch_add(1, std::memory_order_relaxed);
+            Stats->BusyNanoseconds.fetch_add(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count(),
+                std::memory_order_relaxed);
+        }
+    }
+
+    void Finish(Job* Task)
+    {
+        // once finished, the slot may be reused by its owner at any time, so read what follows first
+        Job* parent = Task->Parent;
+        const uint32_t dependentCount = Task->DependentCount;
+        Job* dependents[Job::MAX_DEPENDENTS];
+        std::copy_n(Task->Dependents, dependentCount, dependents);
+        if (Task->Unfinished.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        for (uint32_t i = 0; i < dependentCount; i++)
+        {
+            if (dependents[i]->PendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                Enqueue(dependents[i]);
+        }
+
+        if (parent)
+            Finish(parent);
+    }
+
+    void WorkerMain(const uint32_t WorkerIndex)
+    {
+        AllocationTracker::SetCurrentTag(MemoryTag::JOBS);
+        char threadName[32];
+        snprintf(threadName, sizeof(threadName), "Worker %u", WorkerIndex);
+        CpuProfiler::SetThreadName(threadName);
+        SamplingProfiler::RegisterThread();
+
+        s_Current.System = this;
+        s_Current.WorkerIndex = static_cast<int32_t>(WorkerIndex);
+
+        uint32_t idleSpins = 0;
+        while (true)
+        {
+            if (TryExecuteOne(WorkerIndex))
+            {
+                idleSpins = 0;
+                continue;
+            }
+
+            if (++idleSpins < 256)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // nothing to do: announce that we sleep, then re-check before blocking so that a concurrent Enqueue is not missed
+            std::unique_lock lock(m_SleepMutex);
+            m_SleepingWorkers.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!m_bStopping && !HasStealableWork())
+            {
+                m_Workers[WorkerIndex]->Stats.Sleeps.fetch_add(1, std::memory_order_relaxed);
+                m_SleepCond.wait_for(lock, std::chrono::milliseconds(5));
+            }
+            m_SleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+            idleSpins = 0;
+
+            if (m_bStopping)
+                break;
+        }
+    }
+
+    [[nodiscard]] bool HasStealableWork() const
+    {
+        if (m_InjectionSize.load(std::memory_order_relaxed) > 0)
+            return true;
+        for (const auto& worker : m_Workers)
+        {
+            if (worker->Deque.Size() > 0)
+                return true;
+        }
+        return false;
+    }
+
+    static void PinCurrentThread(const uint32_t Core)
+    {
+        const uint32_t coreCount = std::max(1u, std::thread::hardware_concurrency());
+#if defined(_WIN32)
+        SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << (Core % coreCount));
+#elif defined(__linux__)
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(Core % coreCount, &cpuSet);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#else
+        (void)Core;
+        (void)coreCount;
+#endif
+    }
+
+    std::vector<std::unique_ptr<Worker>> m_Workers;
+    std::array<AffineQueue, static_cast<size_t>(JobAffinity::COUNT)> m_AffineQueues;
+
+    std::mutex m_InjectionMutex;
+    std::deque<Job*> m_InjectionQueue;
+    std::atomic<uint32_t> m_InjectionSize{0};
+
+    std::mutex m_ExternalPoolMutex;
+    std::unique_ptr<Job[]> m_ExternalPool{new Job[JOB_POOL_SIZE]};
+    uint32_t m_ExternalPoolIndex{0};
+
+    std::mutex m_SleepMutex;
+    std::condition_variable m_SleepCond;
+    std::atomic<uint32_t> m_SleepingWorkers{0};
+    bool m_bStopping{false};
+
+    ThreadContext m_CreatorContext;
+
+    static thread_local ThreadContext s_Current;
+};
+
+inline thread_local JobSystem::ThreadContext JobSystem::s_Current;
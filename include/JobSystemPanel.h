@@ -0,0 +1,218 @@
+#pragma once
+
+#include "JobSystem.h"
+
+#include "imgui.h"
+#include "implot/implot.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+/**
+ * \brief Result of running the scaling benchmark with a given number of threads
+ */
+struct JobSystemScalingSample
+{
+    double Threads{0.0};
+    double ParallelForMs{0.0};
+    double TaskGraphMs{0.0};
+    double ParallelForSpeedup{0.0};
+    double TaskGraphSpeedup{0.0};
+};
+
+/**
+ * \brief Runs a compute-bound ParallelFor and a fine-grained task fan-out with 1..MaxThreads threads.
+ * Each configuration reports the best of several repetitions; speedups are relative to the single thread run.
+ */
+inline std::vector<JobSystemScalingSample> RunJobSystemScalingBenchmark(const uint32_t MaxThreads, const uint32_t Repetitions = 5)
+{
+    constexpr size_t ELEMENT_COUNT = 1 << 22;
+    constexpr uint32_t TASK_COUNT = 2048;
+
+    std::vector<float> data(ELEMENT_COUNT);
+    std::vector<JobSystemScalingSample> samples;
+
+    using Clock = std::chrono::steady_clock;
+    const auto elapsedMs = [](const Clock::time_point Begin)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - Begin).count();
+    };
+
+    for (uint32_t threads = 1; threads <= MaxThreads; threads++)
+    {
+        JobSystem jobSystem(JobSystemDesc{threads, false});
+        JobSystemScalingSample sample;
+        sample.Threads = threads;
+        sample.ParallelForMs = sample.TaskGraphMs = 1e30;
+
+        for (uint32_t repetition = 0; repetition < Repetitions; repetition++)
+        {
+            auto begin = Clock::now();
+            jobSystem.ParallelFor(0, ELEMENT_COUNT, [&data](const size_t First, const size_t Last)
+            {
+                for (size_t i = First; i < Last; i++)
+                    data[i] = std::sqrt(static_cast<float>(i)) * std::sin(static_cast<float>(i));
+            });
+            sample.ParallelForMs = std::min(sample.ParallelForMs, elapsedMs(begin));
+
+            // many small independent jobs under one group: measures scheduling and stealing overhead
+            begin = Clock::now();
+            Job* root = jobSystem.CreateGroup();
+            for (uint32_t task = 0; task < TASK_COUNT; task++)
+            {
+                float* slice = data.data() + task * (ELEMENT_COUNT / TASK_COUNT);
+                jobSystem.Run([slice]()
+                {
+                    for (size_t i = 0; i < ELEMENT_COUNT / TASK_COUNT; i++)
+                        slice[i] = slice[i] * 0.5f + 1.0f;
+                }, root);
+            }
+            jobSystem.Schedule(root);
+            jobSystem.Wait(root);
+            sample.TaskGraphMs = std::min(sample.TaskGraphMs, elapsedMs(begin));
+        }
+
+        samples.push_back(sample);
+    }
+
+    for (JobSystemScalingSample& sample : samples)
+    {
+        sample.ParallelForSpeedup = samples.front().ParallelForMs / sample.ParallelForMs;
+        sample.TaskGraphSpeedup = samples.front().TaskGraphMs / sample.TaskGraphMs;
+    }
+    return samples;
+}
+
+/**
+ * \brief ImGui window showing per-worker scheduling, stealing and contention counters of a JobSystem
+ */
+class JobSystemPanel
+{
+public:
+    explicit JobSystemPanel(JobSystem& System) : m_System(System)
+    {
+        m_Previous.resize(System.GetThreadCount());
+        m_Utilization.resize(System.GetThreadCount());
+    }
+
+    void Render()
+    {
+        UpdateRates();
+
+        ImGui::Begin("Job System");
+        ImGui::Text("%u threads (main thread is worker 0)", m_System.GetThreadCount());
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Reset counters"))
+        {
+            m_System.ResetStats();
+            for (Snapshot& snapshot : m_Previous)
+                snapshot = Snapshot();
+        }
+
+        if (ImGui::BeginTable("Workers", 8, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit))
+        {
+            ImGui::TableSetupColumn("Worker");
+            ImGui::TableSetupColumn("Executed");
+            ImGui::TableSetupColumn("Stolen");
+            ImGui::TableSetupColumn("Steal attempts");
+            ImGui::TableSetupColumn("Contended");
+            ImGui::TableSetupColumn("Overflows");
+            ImGui::TableSetupColumn("Sleeps");
+            ImGui::TableSetupColumn("Busy");
+            ImGui::TableHeadersRow();
+
+            for (uint32_t i = 0; i < m_System.GetThreadCount(); i++)
+            {
+                const WorkerStats& stats = m_System.GetWorkerStats(i);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::Text("%u", i);
+                ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(stats.JobsExecuted.load()));
+                ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(stats.JobsStolen.load()));
+                ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(stats.StealAttempts.load()));
+                ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(stats.StealContended.load()));
+                ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(stats.DequeOverflows.load()));
+                ImGui::TableNextColumn(); ImGui::Text("%llu", static_cast<unsigned long long>(stats.Sleeps.load()));
+                ImGui::TableNextColumn(); ImGui::Text("%.1f%%", m_Utilization[i] * 100.0);
+            }
+            ImGui::EndTable();
+        }
+
+        if (ImGui::CollapsingHeader("Scaling benchmark"))
+        {
+            const int hardwareThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+            if (m_BenchmarkMaxThreads == 0)
+                m_BenchmarkMaxThreads = hardwareThreads;
+            ImGui::SliderInt("Max threads", &m_BenchmarkMaxThreads, 1, hardwareThreads * 2);
+            if (ImGui::Button("Run (blocks the UI)"))
+                m_Scaling = RunJobSystemScalingBenchmark(static_cast<uint32_t>(m_BenchmarkMaxThreads));
+
+            if (!m_Scaling.empty() && ImPlot::BeginPlot("Speedup", ImVec2(-1, 200)))
+            {
+                ImPlot::SetupAxes("threads", "speedup", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+                const int stride = sizeof(JobSystemScalingSample);
+                ImPlot::PlotLine("ParallelFor", &m_Scaling[0].Threads, &m_Scaling[0].ParallelForSpeedup,
+                                 static_cast<int>(m_Scaling.size()), 0, 0, stride);
+                ImPlot::PlotLine("Task fan-out", &m_Scaling[0].Threads, &m_Scaling[0].TaskGraphSpeedup,
+                                 static_cast<int>(m_Scaling.size()), 0, 0, stride);
+                ImPlot::EndPlot();
+            }
+
+            if (!m_Scaling.empty() && ImGui::BeginTable("Scaling", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit))
+            {
+                ImGui::TableSetupColumn("Threads");
+                ImGui::TableSetupColumn("ParallelFor");
+                ImGui::TableSetupColumn("Speedup");
+                ImGui::TableSetupColumn("Task fan-out");
+                ImGui::TableSetupColumn("Speedup");
+                ImGui::TableHeadersRow();
+
+                for (const JobSystemScalingSample& sample : m_Scaling)
+                {
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn(); ImGui::Text("%.0f", sample.Threads);
+                    ImGui::TableNextColumn(); ImGui::Text("%.3f ms", sample.ParallelForMs);
+                    ImGui::TableNextColumn(); ImGui::Text("x%.2f", sample.ParallelForSpeedup);
+                    ImGui::TableNextColumn(); ImGui::Text("%.3f ms", sample.TaskGraphMs);
+                    ImGui::TableNextColumn(); ImGui::Text("x%.2f", sample.TaskGraphSpeedup);
+                }
+                ImGui::EndTable();
+            }
+        }
+
+        ImGui::End();
+    }
+
+private:
+    struct Snapshot
+    {
+        uint64_t BusyNanoseconds{0};
+        std::chrono::steady_clock::time_point Time{std::chrono::steady_clock::now()};
+    };
+
+    void UpdateRates()
+    {
+        // utilization is refreshed a few times per second to keep the numbers readable
+        const auto now = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < m_System.GetThreadCount(); i++)
+        {
+            Snapshot& previous = m_Previous[i];
+            const double elapsed = std::chrono::duration<double, std::nano>(now - previous.Time).count();
+            if (elapsed < 250e6)
+                continue;
+
+            const uint64_t busy = m_System.GetWorkerStats(i).BusyNanoseconds.load(std::memory_order_relaxed);
+            // nested waits execute jobs inside jobs, so busy time can exceed wall time
+            m_Utilization[i] = busy >= previous.BusyNanoseconds ? std::min(1.0, (busy - previous.BusyNanoseconds) / elapsed) : 0.0;
+            previous.BusyNanoseconds = busy;
+            previous.Time = now;
+        }
+    }
+
+    JobSystem& m_System;
+    std::vector<Snapshot> m_Previous;
+    std::vector<double> m_Utilization;
+    std::vector<JobSystemScalingSample> m_Scaling;
+    int m_BenchmarkMaxThreads{0};
+};
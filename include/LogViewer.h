@@ -0,0 +1,1160 @@
+#pragma once
+
+#include "JobSystem.h"
+
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/inotify.h>
+#endif
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LOG_VIEWER_SSE2 1
+#endif
+
+/**
+ * \brief Read-only viewer for log files of any size.
+ *
+ * The file is memory-mapped and never copied. Its line index (the offset of every '\n', 4 bytes per line) is built in
+ * chunks on the job system, 64 bytes per step; Open() indexes the first chunk itself, so the first screen is there at once
+ * while the rest streams in. Scanned pages are handed back to the OS, so memory stays proportional to the index rather
+ * than to the file. Appends are picked up (inotify on Linux, polling elsewhere) and extend the last chunk until it is full,
+ * indexing only the new bytes, so a log that keeps growing still ends up in full-size chunks; Follow keeps the last line in
+ * view.
+ *
+ * Search is a case-insensitive substring match run over the indexed chunks in parallel; hits show as they are found, are
+ * marked on the scrollbar and can be stepped through. Typing onto the search text only rechecks the lines that matched
+ * before. Lines are addressed by 64-bit number and scrolled by line, and only the lines on screen are drawn.
+ *
+ * Like any mapping, a file truncated in place while it is read raises SIGBUS; logs rotated by renaming are reopened.
+ * The owning JobSystem needs at least one thread besides the one calling Draw().
+ */
+class LogViewer
+{
+public:
+    // indexed by Open() itself: enough for the first screen of any reasonable log
+    static constexpr uint64_t FIRST_CHUNK_BYTES = 1ull << 20;
+    static constexpr uint64_t CHUNK_BYTES = 32ull << 20;
+    // longer lines are cut on screen; the search still sees all of them
+    static constexpr size_t MAX_DISPLAY_BYTES = 4096;
+    // the unterminated last line is searched on the UI thread, so only while it is short
+    static constexpr size_t MAX_TAIL_SEARCH_BYTES = 1u << 20;
+
+    struct Stats
+    {
+        uint64_t FileBytes{0};
+        uint64_t IndexedBytes{0};
+        uint64_t LineCount{0};
+        uint64_t IndexBytes{0};
+        uint64_t HitCount{0};
+        bool bIndexing{false};
+        bool bSearching{false};
+    };
+
+    explicit LogViewer(JobSystem& Jobs) : m_Jobs(Jobs) {}
+    ~LogViewer() { Close(); }
+
+    LogViewer(const LogViewer&) = delete;
+    LogViewer& operator=(const LogViewer&) = delete;
+
+    /**
+     * \brief Maps Path and starts indexing it; on failure the current file stays open
+     */
+    bool Open(const std::string& Path)
+    {
+        FileHandle file = OpenFile(Path);
+        if (file == INVALID_FILE)
+        {
+            std::cout << "Failed to open log file " << Path << std::endl;
+            return false;
+        }
+
+        const uint64_t size = QueryFileSize(file);
+        std::unique_ptr<Mapping> mapping = MapFile(file, size);
+        if (!mapping)
+        {
+            std::cout << "Failed to map log file " << Path << std::endl;
+            CloseFile(file);
+            return false;
+        }
+
+        Close();
+        m_File = file;
+        m_Mapping = std::move(mapping);
+        m_Path = Path;
+        m_FileBytes = size;
+        m_LastPoll = m_LastGrowth = std::chrono::steady_clock::now();
+        WatchFile();
+
+        AddChunks(0, std::min(size, FIRST_CHUNK_BYTES));
+        if (!m_Chunks.empty())
+        {
+            Chunk& first = *m_Chunks.front();
+            IndexChunk(first, m_Mapping->Data, first.Begin);
+            first.bIndexed.store(true, std::memory_order_release);
+        }
+        const size_t firstBackground = m_Chunks.size();
+        AddChunks(std::min(size, FIRST_CHUNK_BYTES), size);
+        LaunchIndexing(firstBackground, nullptr, 0, 0);
+        AdvanceIndex();
+
+        // the search on screen carries over to the new file
+        if (!m_SearchText.empty())
+            SetSearch(std::string(std::exchange(m_SearchText, std::string())));
+        return true;
+    }
+
+    void Close()
+    {
+        // running jobs stop at their next chunk
+        m_FileGeneration.fetch_add(1, std::memory_order_relaxed);
+        m_SearchGeneration.fetch_add(1, std::memory_order_relaxed);
+        while (m_InFlight.load(std::memory_order_acquire) > 0)
+            std::this_thread::yield();
+
+        m_Search.reset();
+        m_Chunks.clear();
+        m_TailReplacement.reset();
+        m_RetiredChunks.clear();
+        m_ChunkFirstLines.clear();
+        m_Retired.clear();
+        m_Mapping.reset();
+        if (m_File != INVALID_FILE)
+            CloseFile(m_File);
+        m_File = INVALID_FILE;
+#if defined(__linux__)
+        if (m_Inotify >= 0)
+            close(m_Inotify);
+        m_Inotify = -1;
+#endif
+        m_Path.clear();
+        m_FileBytes = m_IndexedBytes = m_IndexBytes = 0;
+        m_IndexedChunks = 0;
+        m_TerminatedLines = m_NextLineStart = 0;
+        m_TopLine = 0;
+        m_SelectedLine = UINT64_MAX;
+        m_bReplaced = false;
+        m_PendingBytes = 0;
+        m_HitCount = 0;
+        m_bSearchComplete = true;
+        m_bTailHit = false;
+        m_TailKey = {};
+        m_Markers.clear();
+        m_MarkersKey = {};
+    }
+
+    [[nodiscard]] bool IsOpen() const { return m_Mapping != nullptr; }
+    [[nodiscard]] const std::string& GetPath() const { return m_Path; }
+
+    /**
+     * \brief Lines indexed so far, including an unterminated last one
+     */
+    [[nodiscard]] uint64_t GetLineCount() const { return m_TerminatedLines + (m_IndexedBytes > m_NextLineStart ? 1 : 0); }
+
+    /**
+     * \brief Line text without its line break; valid until the next Update()
+     */
+    [[nodiscard]] std::string_view GetLine(const uint64_t Line) const
+    {
+        const LineRange range = GetLineRange(Line);
+        std::string_view text(m_Mapping->Data + range.Begin, range.End - range.Begin);
+        if (!text.empty() && text.back() == '\r')
+            text.remove_suffix(1);
+        return text;
+    }
+
+    [[nodiscard]] bool IsHit(const uint64_t Line) const
+    {
+        if (!m_Search || Line >= GetLineCount())
+            return false;
+        if (Line >= m_TerminatedLines)
+            return m_bTailHit;
+
+        const size_t chunkIndex = FindChunk(Line);
+        const Chunk& chunk = *m_Chunks[chunkIndex];
+        if (chunk.SearchGeneration.load(std::memory_order_acquire) != m_Search->Generation)
+            return false;
+        return std::binary_search(chunk.Hits.begin(), chunk.Hits.end(), static_cast<uint32_t>(Line - chunk.FirstLine));
+    }
+
+    /**
+     * \brief Case-insensitive text to search for; empty stops searching
+     */
+    void SetSearch(const std::string_view Text)
+    {
+        if (Text == m_SearchText)
+            return;
+
+        // every line with "texture" also has "tex", so lines that did not match before need no second look
+        const bool bNarrowing = m_Search && !Text.empty() &&
+                                ImStristr(Text.data(), Text.data() + Text.size(), m_SearchText.data(), m_SearchText.data() + m_SearchText.size());
+        m_SearchText.assign(Text);
+        if (m_SearchText != m_SearchBuffer)
+            ImStrncpy(m_SearchBuffer, m_SearchText.c_str(), sizeof(m_SearchBuffer));
+        const uint64_t generation = m_SearchGeneration.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (!bNarrowing)
+            m_NarrowFromGeneration = generation;
+
+        if (Text.empty())
+            m_Search.reset();
+        else
+            m_Search = std::make_shared<SearchQuery>(Text, generation);
+        m_TailKey = {};
+        UpdateSearch();
+    }
+
+    /**
+     * \brief Picks up index and search progress and file growth; Draw() calls this first
+     */
+    void Update()
+    {
+        if (!IsOpen())
+            return;
+
+        PollFile();
+        AdvanceIndex();
+        if (m_InFlight.load(std::memory_order_acquire) == 0)
+        {
+            m_Retired.clear();
+            m_RetiredChunks.clear();
+        }
+        UpdateSearch();
+    }
+
+    [[nodiscard]] Stats GetStats() const
+    {
+        Stats stats;
+        stats.FileBytes = m_FileBytes;
+        stats.IndexedBytes = m_IndexedBytes;
+        stats.LineCount = GetLineCount();
+        stats.IndexBytes = m_IndexBytes;
+        stats.HitCount = m_HitCount;
+        stats.bIndexing = m_IndexedChunks < m_Chunks.size() || m_TailReplacement;
+        stats.bSearching = m_Search && !m_bSearchComplete;
+        return stats;
+    }
+
+    /**
+     * \brief Search bar and the lines, filling Size (0 = remaining space)
+     */
+    void Draw(const char* StrId, const ImVec2& Size = ImVec2(0.0f, 0.0f))
+    {
+        Update();
+        ImGui::PushID(StrId);
+
+        if (!IsOpen())
+        {
+            ImGui::TextDisabled("No file open");
+            ImGui::PopID();
+            return;
+        }
+
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 16.0f);
+        if (ImGui::InputTextWithHint("##Search", "Search", m_SearchBuffer, sizeof(m_SearchBuffer)))
+            SetSearch(m_SearchBuffer);
+        ImGui::SameLine();
+        if (ImGui::ArrowButton("##Previous", ImGuiDir_Up))
+            GoToHit(false);
+        ImGui::SameLine();
+        if (ImGui::ArrowButton("##Next", ImGuiDir_Down))
+            GoToHit(true);
+        ImGui::SameLine();
+        ImGui::Checkbox("Follow", &m_bFollow);
+
+        const Stats stats = GetStats();
+        ImGui::SameLine();
+        ImGui::Text("%llu lines", static_cast<unsigned long long>(stats.LineCount));
+        if (m_Search)
+        {
+            ImGui::SameLine();
+            ImGui::Text("%llu hits%s", static_cast<unsigned long long>(stats.HitCount), stats.bSearching ? ", searching..." : "");
+        }
+        ImGui::SameLine();
+        if (stats.bIndexing)
+            ImGui::TextDisabled("(indexing %.0f%%)", 100.0 * static_cast<double>(stats.IndexedBytes) / static_cast<double>(stats.FileBytes));
+        else
+            ImGui::TextDisabled("(%.1f MiB, index %.1f MiB)", static_cast<double>(stats.FileBytes) / (1024.0 * 1024.0),
+                                static_cast<double>(stats.IndexBytes) / (1024.0 * 1024.0));
+
+        if (ImGui::BeginChild("Lines", Size, true, ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse))
+            DrawLines();
+        ImGui::EndChild();
+
+        ImGui::PopID();
+    }
+
+    /**
+     * \brief Appends to Out the offset from Begin of every '\n' in [Begin, End)
+     */
+    static void FindNewlines(const char* Begin, const char* End, std::vector<uint32_t>& Out)
+    {
+        const char* text = Begin;
+#ifdef LOG_VIEWER_SSE2
+        const __m128i newline = _mm_set1_epi8('\n');
+        for (; End - text >= 64; text += 64)
+        {
+            const uint64_t mask0 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text)), newline)));
+            const uint64_t mask1 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 16)), newline)));
+            const uint64_t mask2 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 32)), newline)));
+            const uint64_t mask3 = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 48)), newline)));
+            uint64_t mask = mask0 | (mask1 << 16) | (mask2 << 32) | (mask3 << 48);
+            const uint32_t base = static_cast<uint32_t>(text - Begin);
+            for (; mask != 0; mask &= mask - 1)
+                Out.push_back(base + static_cast<uint32_t>(std::countr_zero(mask)));
+        }
+#endif
+        for (; text < End; text++)
+        {
+            if (*text == '\n')
+                Out.push_back(static_cast<uint32_t>(text - Begin));
+        }
+    }
+
+private:
+#if defined(_WIN32)
+    using FileHandle = HANDLE;
+    static inline const FileHandle INVALID_FILE = INVALID_HANDLE_VALUE;
+#else
+    using FileHandle = int;
+    static constexpr FileHandle INVALID_FILE = -1;
+#endif
+
+    // polled even with inotify, which misses writes on network file systems
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{1000};
+    // narrowing a search rechecks a chunk's hits only while it has this many lines per hit
+    static constexpr size_t NARROW_HIT_RATIO = 4;
+    // appends arriving faster than this are indexed together
+    static constexpr std::chrono::milliseconds GROWTH_INTERVAL{250};
+
+    struct Mapping
+    {
+        const char* Data{nullptr};
+        uint64_t Capacity{0};
+#if defined(_WIN32)
+        HANDLE Handle{nullptr};
+#endif
+
+        Mapping() = default;
+        Mapping(const Mapping&) = delete;
+        Mapping& operator=(const Mapping&) = delete;
+
+        ~Mapping()
+        {
+#if defined(_WIN32)
+            if (Data)
+                UnmapViewOfFile(Data);
+            if (Handle)
+                CloseHandle(Handle);
+#else
+            if (Data)
+                munmap(const_cast<char*>(Data), Capacity);
+#endif
+        }
+    };
+
+    /**
+     * \brief [Begin, End) of the file. Newlines is written by one indexing job and read once bIndexed is set; the main
+     * thread then fills in where the chunk's lines start. A chunk owns the lines its newlines end, the first of which may
+     * start in an earlier chunk.
+     */
+    struct Chunk
+    {
+        uint64_t Begin{0};
+        uint64_t End{0};
+        std::vector<uint32_t> Newlines;
+        std::atomic<bool> bIndexed{false};
+
+        uint64_t FirstLine{0};
+        uint64_t FirstLineStart{0};
+
+        // owned lines (relative to FirstLine) matching the search of SearchGeneration, written by one search job at a time
+        std::vector<uint32_t> Hits;
+        std::atomic<uint64_t> SearchGeneration{0};
+    };
+
+    struct SearchQuery
+    {
+        SearchQuery(const std::string_view Text, const uint64_t Generation) : Text(Text), Generation(Generation)
+        {
+            ImStristrPrepare(&Needle, this->Text.data(), this->Text.data() + this->Text.size());
+        }
+
+        const std::string Text;
+        ImStristrNeedle Needle;
+        const uint64_t Generation;
+    };
+
+    struct IndexTask
+    {
+        std::vector<Chunk*> Chunks;
+        const char* Data;
+        uint64_t FileGeneration;
+        // extended copy of the last chunk: indexed from TailFrom on, and searched (from line TailSearchedLines on, when
+        // it carries the hits of the current search) before it replaces the published one
+        Chunk* Tail;
+        uint64_t TailFrom;
+        uint32_t TailSearchedLines;
+        std::shared_ptr<const SearchQuery> Query;
+    };
+
+    struct SearchTask
+    {
+        std::shared_ptr<const SearchQuery> Query;
+        std::vector<Chunk*> Chunks;
+        const char* Data;
+        uint64_t NarrowFromGeneration;
+    };
+
+    struct LineRange
+    {
+        uint64_t Begin;
+        uint64_t End;
+    };
+
+    struct TailKey
+    {
+        uint64_t Generation{0};
+        uint64_t Begin{0};
+        uint64_t End{0};
+
+        bool operator==(const TailKey&) const = default;
+    };
+
+    struct MarkersKey
+    {
+        uint64_t Generation{0};
+        uint64_t LineCount{0};
+        uint64_t HitCount{0};
+        int Height{0};
+
+        bool operator==(const MarkersKey&) const = default;
+    };
+
+    static FileHandle OpenFile(const std::string& Path)
+    {
+#if defined(_WIN32)
+        return CreateFileA(Path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+#else
+        return open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+    }
+
+    static void CloseFile(const FileHandle File)
+    {
+#if defined(_WIN32)
+        CloseHandle(File);
+#else
+        close(File);
+#endif
+    }
+
+    static uint64_t QueryFileSize(const FileHandle File)
+    {
+#if defined(_WIN32)
+        LARGE_INTEGER size;
+        return GetFileSizeEx(File, &size) ? static_cast<uint64_t>(size.QuadPart) : 0;
+#else
+        struct stat status;
+        return fstat(File, &status) == 0 ? static_cast<uint64_t>(status.st_size) : 0;
+#endif
+    }
+
+    /**
+     * \brief Maps at least Size bytes. POSIX mappings reserve room past the end, so appends rarely need a new mapping.
+     */
+    static std::unique_ptr<Mapping> MapFile(const FileHandle File, const uint64_t Size)
+    {
+        auto mapping = std::make_unique<Mapping>();
+#if defined(_WIN32)
+        // a view cannot extend past the file, and an empty file cannot be mapped at all
+        if (Size == 0)
+            return mapping;
+        mapping->Handle = CreateFileMappingA(File, nullptr, PAGE_READONLY, static_cast<DWORD>(Size >> 32), static_cast<DWORD>(Size), nullptr);
+        if (!mapping->Handle)
+            return nullptr;
+        mapping->Data = static_cast<const char*>(MapViewOfFile(mapping->Handle, FILE_MAP_READ, 0, 0, 0));
+        if (!mapping->Data)
+            return nullptr;
+        mapping->Capacity = Size;
+#else
+        const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        const uint64_t capacity = (Size + std::max<uint64_t>(Size / 4, 64ull << 20) + pageSize - 1) / pageSize * pageSize;
+        void* data = mmap(nullptr, capacity, PROT_READ, MAP_SHARED, File, 0);
+        if (data == MAP_FAILED)
+            return nullptr;
+        mapping->Data = static_cast<const char*>(data);
+        mapping->Capacity = capacity;
+#endif
+        return mapping;
+    }
+
+    /**
+     * \brief Maps in a range about to be scanned with one call rather than a page fault per page (Linux 5.14 and later)
+     */
+    static void PopulatePages(const char* Begin, const char* End)
+    {
+#if defined(MADV_POPULATE_READ)
+        const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        const uintptr_t begin = reinterpret_cast<uintptr_t>(Begin) / pageSize * pageSize;
+        const uintptr_t end = reinterpret_cast<uintptr_t>(End);
+        if (begin < end)
+            madvise(reinterpret_cast<void*>(begin), end - begin, MADV_POPULATE_READ);
+#else
+        (void)Begin;
+        (void)End;
+#endif
+    }
+
+    /**
+     * \brief Drops the pages of a scanned range from the process; they come back from the page cache when read again
+     */
+    static void ReleasePages(const char* Begin, const char* End)
+    {
+#if !defined(_WIN32)
+        const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        const uintptr_t begin = (reinterpret_cast<uintptr_t>(Begin) + pageSize - 1) / pageSize * pageSize;
+        const uintptr_t end = reinterpret_cast<uintptr_t>(End) / pageSize * pageSize;
+        if (begin < end)
+            madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+#else
+        (void)Begin;
+        (void)End;
+#endif
+    }
+
+    void WatchFile()
+    {
+#if defined(__linux__)
+        m_Inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_Inotify >= 0 && inotify_add_watch(m_Inotify, m_Path.c_str(), IN_MODIFY | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF) < 0)
+        {
+            close(m_Inotify);
+            m_Inotify = -1;
+        }
+#endif
+    }
+
+    void PollFile()
+    {
+        bool bChanged = false;
+#if defined(__linux__)
+        if (m_Inotify >= 0)
+        {
+            alignas(inotify_event) char events[4096];
+            ssize_t bytes;
+            while ((bytes = read(m_Inotify, events, sizeof(events))) > 0)
+            {
+                for (const char* event = events; event < events + bytes;)
+                {
+                    const inotify_event* header = reinterpret_cast<const inotify_event*>(event);
+                    if (header->mask & (IN_MOVE_SELF | IN_DELETE_SELF))
+                        m_bReplaced = true;
+                    else
+                        bChanged = true;
+                    event += sizeof(inotify_event) + header->len;
+                }
+            }
+        }
+#endif
+        const auto now = std::chrono::steady_clock::now();
+        if (now - m_LastPoll >= POLL_INTERVAL)
+        {
+            m_LastPoll = now;
+            bChanged = true;
+
+            // a rotated log is followed to the file that took its name once there is one
+            if (m_bReplaced)
+            {
+                const FileHandle file = OpenFile(m_Path);
+                if (file != INVALID_FILE)
+                {
+                    CloseFile(file);
+                    Open(std::string(m_Path));
+                    return;
+                }
+            }
+        }
+
+        if (bChanged)
+        {
+            // a truncated file is reopened at once, before the next frame reads past its new end
+            const uint64_t size = QueryFileSize(m_File);
+            if (size < m_FileBytes)
+            {
+                Open(std::string(m_Path));
+                return;
+            }
+            m_PendingBytes = size;
+        }
+
+        if (m_PendingBytes <= m_FileBytes || now - m_LastGrowth < GROWTH_INTERVAL)
+            return;
+        // the last chunk can only be extended once it is published, and once its previous extension has replaced it
+        if (m_IndexedChunks < m_Chunks.size() || m_TailReplacement)
+            return;
+        m_LastGrowth = now;
+
+        const uint64_t size = m_PendingBytes;
+        if (size > m_Mapping->Capacity)
+        {
+            std::unique_ptr<Mapping> mapping = MapFile(m_File, size);
+            if (!mapping)
+                return;
+            // jobs still scanning the old mapping keep it alive until they are done
+            m_Retired.push_back(std::move(m_Mapping));
+            m_Mapping = std::move(mapping);
+        }
+        const size_t first = m_Chunks.size();
+        uint64_t next = m_FileBytes;
+        const uint64_t tailFrom = m_FileBytes;
+        uint32_t tailSearchedLines = 0;
+        if (!m_Chunks.empty() && m_Chunks.back()->End - m_Chunks.back()->Begin < CHUNK_BYTES)
+        {
+            // the published chunk stays on screen until its extended copy is indexed and searched
+            const Chunk& last = *m_Chunks.back();
+            m_TailReplacement = std::make_unique<Chunk>();
+            m_TailReplacement->Begin = last.Begin;
+            m_TailReplacement->End = std::min(size, last.Begin + CHUNK_BYTES);
+            m_TailReplacement->Newlines = last.Newlines;
+            m_TailReplacement->FirstLine = last.FirstLine;
+            m_TailReplacement->FirstLineStart = last.FirstLineStart;
+            // hits of the current search are final once published, so only the new lines need searching
+            if (m_Search && last.SearchGeneration.load(std::memory_order_acquire) == m_Search->Generation)
+            {
+                m_TailReplacement->Hits = last.Hits;
+                m_TailReplacement->SearchGeneration.store(m_Search->Generation, std::memory_order_relaxed);
+                tailSearchedLines = static_cast<uint32_t>(last.Newlines.size());
+            }
+            next = m_TailReplacement->End;
+        }
+        AddChunks(next, size);
+        m_FileBytes = size;
+        LaunchIndexing(first, m_TailReplacement.get(), tailFrom, tailSearchedLines);
+    }
+
+    void AddChunks(const uint64_t Begin, const uint64_t End)
+    {
+        for (uint64_t begin = Begin; begin < End; begin += CHUNK_BYTES)
+        {
+            auto chunk = std::make_unique<Chunk>();
+            chunk->Begin = begin;
+            chunk->End = std::min(End, begin + CHUNK_BYTES);
+            m_Chunks.push_back(std::move(chunk));
+        }
+    }
+
+    /**
+     * \brief Appends the newlines of the chunk's bytes from From on; the caller publishes it through bIndexed
+     */
+    static void IndexChunk(Chunk& Target, const char* Data, const uint64_t From)
+    {
+        // reserving for 64-byte lines saves most of the regrowth on typical logs
+        const size_t indexed = Target.Newlines.size();
+        Target.Newlines.reserve(indexed + static_cast<size_t>((Target.End - From) / 64));
+        PopulatePages(Data + From, Data + Target.End);
+        FindNewlines(Data + From, Data + Target.End, Target.Newlines);
+        // FindNewlines counts from From, the index from the chunk start
+        if (From != Target.Begin)
+        {
+            for (size_t i = indexed; i < Target.Newlines.size(); i++)
+                Target.Newlines[i] += static_cast<uint32_t>(From - Target.Begin);
+        }
+        Target.Newlines.shrink_to_fit();
+        ReleasePages(Data + From, Data + Target.End);
+    }
+
+    void LaunchIndexing(const size_t FirstChunk, Chunk* Tail, const uint64_t TailFrom, const uint32_t TailSearchedLines)
+    {
+        if (FirstChunk >= m_Chunks.size() && !Tail)
+            return;
+
+        // the job owns the task; capturing only pointers keeps the job payload trivially destructible
+        IndexTask* task = new IndexTask{{}, m_Mapping->Data, m_FileGeneration.load(std::memory_order_relaxed), Tail, TailFrom,
+                                        TailSearchedLines, m_Search};
+        for (size_t chunk = FirstChunk; chunk < m_Chunks.size(); chunk++)
+            task->Chunks.push_back(m_Chunks[chunk].get());
+
+        m_InFlight.fetch_add(1, std::memory_order_relaxed);
+        m_Jobs.Run([this, task]()
+        {
+            const std::unique_ptr<IndexTask> owned(task);
+            if (owned->Tail && m_FileGeneration.load(std::memory_order_relaxed) == owned->FileGeneration)
+            {
+                Chunk& tail = *owned->Tail;
+                IndexChunk(tail, owned->Data, owned->TailFrom);
+                const SearchQuery* query = owned->Query.get();
+                if (query && m_SearchGeneration.load(std::memory_order_relaxed) == query->Generation)
+                {
+                    SearchChunk(tail, owned->Data, *query, false, owned->TailSearchedLines);
+                }
+                else
+                {
+                    // searched afterwards like any other chunk
+                    tail.Hits.clear();
+                    tail.SearchGeneration.store(0, std::memory_order_relaxed);
+                }
+                tail.bIndexed.store(true, std::memory_order_release);
+            }
+            m_Jobs.ParallelFor(0, owned->Chunks.size(), [this, &owned](const size_t First, const size_t Last)
+            {
+                for (size_t chunk = First; chunk < Last; chunk++)
+                {
+                    if (m_FileGeneration.load(std::memory_order_relaxed) != owned->FileGeneration)
+                        return;
+                    Chunk& target = *owned->Chunks[chunk];
+                    IndexChunk(target, owned->Data, target.Begin);
+                    target.bIndexed.store(true, std::memory_order_release);
+                }
+            }, 1);
+            m_InFlight.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    /**
+     * \brief Publishes the chunks indexed since the last call, in file order, assigning each its first line
+     */
+    void AdvanceIndex()
+    {
+        // an extended copy of the last chunk takes its place once indexed; that chunk is the last published one, since
+        // nothing after it is published meanwhile
+        if (m_TailReplacement)
+        {
+            if (!m_TailReplacement->bIndexed.load(std::memory_order_acquire))
+                return;
+            const size_t tailIndex = m_IndexedChunks - 1;
+            const Chunk& replaced = *m_Chunks[tailIndex];
+            m_IndexedChunks = tailIndex;
+            m_ChunkFirstLines.pop_back();
+            m_TerminatedLines = replaced.FirstLine;
+            m_NextLineStart = replaced.FirstLineStart;
+            m_IndexBytes -= replaced.Newlines.capacity() * sizeof(uint32_t);
+            // a search job may still hold the replaced chunk
+            m_RetiredChunks.push_back(std::exchange(m_Chunks[tailIndex], std::move(m_TailReplacement)));
+        }
+
+        while (m_IndexedChunks < m_Chunks.size() && m_Chunks[m_IndexedChunks]->bIndexed.load(std::memory_order_acquire))
+        {
+            Chunk& chunk = *m_Chunks[m_IndexedChunks];
+            chunk.FirstLine = m_TerminatedLines;
+            chunk.FirstLineStart = m_NextLineStart;
+            m_ChunkFirstLines.push_back(chunk.FirstLine);
+            if (!chunk.Newlines.empty())
+                m_NextLineStart = chunk.Begin + chunk.Newlines.back() + 1;
+            m_TerminatedLines += chunk.Newlines.size();
+            m_IndexBytes += chunk.Newlines.capacity() * sizeof(uint32_t);
+            m_IndexedBytes = chunk.End;
+            m_IndexedChunks++;
+        }
+    }
+
+    /**
+     * \brief The published chunk owning a terminated line. Chunks without newlines share their FirstLine with the next
+     * chunk, and the last of equal ones is the owner.
+     */
+    [[nodiscard]] size_t FindChunk(const uint64_t Line) const
+    {
+        return static_cast<size_t>(std::upper_bound(m_ChunkFirstLines.begin(), m_ChunkFirstLines.end(), Line) - m_ChunkFirstLines.begin()) - 1;
+    }
+
+    [[nodiscard]] LineRange GetLineRange(const uint64_t Line) const
+    {
+        if (Line >= m_TerminatedLines)
+            return {m_NextLineStart, m_IndexedBytes};
+
+        const Chunk& chunk = *m_Chunks[FindChunk(Line)];
+        const size_t local = static_cast<size_t>(Line - chunk.FirstLine);
+        const uint64_t begin = local == 0 ? chunk.FirstLineStart : chunk.Begin + chunk.Newlines[local - 1] + 1;
+        return {begin, chunk.Begin + chunk.Newlines[local]};
+    }
+
+    /**
+     * \brief Finds the owned lines of Target matching Query. From FirstLocal on only: the hits before it are Target's
+     * own, for the same query.
+     */
+    static void SearchChunk(Chunk& Target, const char* Data, const SearchQuery& Query, const bool bNarrow, const uint32_t FirstLocal = 0)
+    {
+        std::vector<uint32_t> hits;
+        if (FirstLocal > 0)
+            hits = std::move(Target.Hits);
+        const char* chunkBegin = Data + Target.Begin;
+        // rechecking the previous hits line by line only beats one scan over the chunk while they are a small part of it
+        if (bNarrow && Target.Hits.size() * NARROW_HIT_RATIO < Target.Newlines.size())
+        {
+            // hits on most pages are cheaper to map in at once too
+            if (Target.Hits.size() * 4096 >= Target.End - Target.Begin)
+                PopulatePages(chunkBegin, Data + Target.End);
+            for (const uint32_t local : Target.Hits)
+            {
+                const char* lineBegin = local == 0 ? Data + Target.FirstLineStart : chunkBegin + Target.Newlines[local - 1] + 1;
+                if (ImStristrPrepared(lineBegin, chunkBegin + Target.Newlines[local], Query.Needle))
+                    hits.push_back(local);
+            }
+        }
+        else if (FirstLocal < Target.Newlines.size())
+        {
+            // the needle has no line break, so one scan over all owned lines finds matches within lines only; after a hit
+            // the rest of its line is skipped
+            const char* begin = FirstLocal == 0 ? Data + Target.FirstLineStart : chunkBegin + Target.Newlines[FirstLocal - 1] + 1;
+            const char* end = chunkBegin + Target.Newlines.back();
+            PopulatePages(begin, end);
+            size_t local = FirstLocal;
+            for (const char* text = begin; text < end;)
+            {
+                const char* found = ImStristrPrepared(text, end, Query.Needle);
+                if (!found)
+                    break;
+
+                // hits only move forward: a few steps find the line of a close one, a binary search that of a distant one
+                const uint32_t offset = found < chunkBegin ? 0 : static_cast<uint32_t>(found - chunkBegin);
+                const size_t probeEnd = std::min(Target.Newlines.size(), local + 8);
+                while (local < probeEnd && Target.Newlines[local] < offset)
+                    local++;
+                if (local == probeEnd)
+                    local = static_cast<size_t>(std::lower_bound(Target.Newlines.begin() + static_cast<ptrdiff_t>(local), Target.Newlines.end(), offset) - Target.Newlines.begin());
+                hits.push_back(static_cast<uint32_t>(local));
+                text = chunkBegin + Target.Newlines[local] + 1;
+                local++;
+            }
+        }
+        ReleasePages(chunkBegin, Data + Target.End);
+        Target.Hits = std::move(hits);
+        Target.SearchGeneration.store(Query.Generation, std::memory_order_release);
+    }
+
+    /**
+     * \brief Counts the hits of the current search and, when no search job runs, starts one over the published chunks not
+     * searched for it yet (new ones included)
+     */
+    void UpdateSearch()
+    {
+        m_HitCount = 0;
+        m_bSearchComplete = true;
+        if (!m_Search || !IsOpen())
+            return;
+
+        const uint64_t generation = m_Search->Generation;
+        std::vector<Chunk*> pending;
+        for (size_t chunkIndex = 0; chunkIndex < m_IndexedChunks; chunkIndex++)
+        {
+            Chunk& chunk = *m_Chunks[chunkIndex];
+            if (chunk.SearchGeneration.load(std::memory_order_acquire) == generation)
+                m_HitCount += chunk.Hits.size();
+            else
+                pending.push_back(&chunk);
+        }
+
+        const TailKey tailKey{generation, m_NextLineStart, m_IndexedBytes};
+        if (tailKey != m_TailKey)
+        {
+            m_TailKey = tailKey;
+            const char* tail = m_Mapping->Data + m_NextLineStart;
+            m_bTailHit = m_IndexedBytes - m_NextLineStart <= MAX_TAIL_SEARCH_BYTES &&
+                         ImStristrPrepared(tail, tail + (m_IndexedBytes - m_NextLineStart), m_Search->Needle);
+        }
+        m_HitCount += m_bTailHit ? 1 : 0;
+        m_bSearchComplete = pending.empty();
+
+        // one search job at a time, so a chunk's hits are never written by two; a superseded one stops at its next chunk
+        if (pending.empty() || m_bSearchRunning.load(std::memory_order_acquire))
+            return;
+
+        SearchTask* task = new SearchTask{m_Search, std::move(pending), m_Mapping->Data, m_NarrowFromGeneration};
+        m_bSearchRunning.store(true, std::memory_order_relaxed);
+        m_InFlight.fetch_add(1, std::memory_order_relaxed);
+        m_Jobs.Run([this, task]()
+        {
+            std::unique_ptr<SearchTask> owned(task);
+            m_Jobs.ParallelFor(0, owned->Chunks.size(), [this, &owned](const size_t First, const size_t Last)
+            {
+                const SearchQuery& query = *owned->Query;
+                for (size_t chunk = First; chunk < Last; chunk++)
+                {
+                    if (m_SearchGeneration.load(std::memory_order_relaxed) != query.Generation)
+                        return;
+                    Chunk& target = *owned->Chunks[chunk];
+                    const uint64_t searched = target.SearchGeneration.load(std::memory_order_relaxed);
+                    SearchChunk(target, owned->Data, query, searched != 0 && searched >= owned->NarrowFromGeneration);
+                }
+            }, 1);
+            owned.reset();
+            m_bSearchRunning.store(false, std::memory_order_release);
+            m_InFlight.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    /**
+     * \brief Selects the nearest hit after (or before) the selected line, or the top line when none is selected
+     */
+    void GoToHit(const bool bForward)
+    {
+        if (!m_Search || GetLineCount() == 0)
+            return;
+
+        const uint64_t from = m_SelectedLine != UINT64_MAX ? m_SelectedLine : m_TopLine;
+        const uint64_t generation = m_Search->Generation;
+        const auto isSearched = [generation](const Chunk& Candidate) { return Candidate.SearchGeneration.load(std::memory_order_acquire) == generation; };
+        uint64_t hit = UINT64_MAX;
+        if (bForward)
+        {
+            const uint64_t first = m_SelectedLine != UINT64_MAX ? from + 1 : from;
+            for (size_t chunkIndex = first < m_TerminatedLines ? FindChunk(first) : m_IndexedChunks; chunkIndex < m_IndexedChunks && hit == UINT64_MAX; chunkIndex++)
+            {
+                const Chunk& chunk = *m_Chunks[chunkIndex];
+                if (!isSearched(chunk))
+                    continue;
+                const uint64_t local = first > chunk.FirstLine ? first - chunk.FirstLine : 0;
+                const auto found = std::lower_bound(chunk.Hits.begin(), chunk.Hits.end(), local);
+                if (found != chunk.Hits.end())
+                    hit = chunk.FirstLine + *found;
+            }
+            if (hit == UINT64_MAX && m_bTailHit && m_TerminatedLines >= first)
+                hit = m_TerminatedLines;
+        }
+        else if (from > 0)
+        {
+            const uint64_t last = from - 1;
+            if (m_bTailHit && last >= m_TerminatedLines)
+                hit = m_TerminatedLines;
+            const size_t lastChunk = m_TerminatedLines > 0 ? FindChunk(std::min(last, m_TerminatedLines - 1)) + 1 : 0;
+            for (size_t chunkIndex = lastChunk; chunkIndex-- > 0 && hit == UINT64_MAX;)
+            {
+                const Chunk& chunk = *m_Chunks[chunkIndex];
+                if (!isSearched(chunk) || chunk.FirstLine > last)
+                    continue;
+                const auto found = std::upper_bound(chunk.Hits.begin(), chunk.Hits.end(), last - chunk.FirstLine);
+                if (found != chunk.Hits.begin())
+                    hit = chunk.FirstLine + *(found - 1);
+            }
+        }
+
+        if (hit == UINT64_MAX)
+            return;
+        m_SelectedLine = hit;
+        m_bScrollToSelected = true;
+        m_bFollow = false;
+    }
+
+    void DrawLines()
+    {
+        ImGuiWindow* window = ImGui::GetCurrentWindow();
+        const ImGuiStyle& style = ImGui::GetStyle();
+        const float lineHeight = ImGui::GetTextLineHeightWithSpacing();
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        const ImVec2 avail = ImGui::GetContentRegionAvail();
+        const uint64_t lineCount = GetLineCount();
+        const uint64_t visibleLines = std::max<uint64_t>(1, static_cast<uint64_t>(avail.y / lineHeight));
+        const uint64_t maxTopLine = lineCount > visibleLines ? lineCount - visibleLines : 0;
+
+        // scrolling is by line in 64-bit, which stays exact on files with billions of lines
+        ImGui::InvisibleButton("##Text", ImVec2(std::max(1.0f, avail.x - style.ScrollbarSize), std::max(1.0f, avail.y)));
+        ImGui::SetItemKeyOwner(ImGuiKey_MouseWheelY);
+        int64_t scroll = 0;
+        if (ImGui::IsItemHovered())
+            scroll -= static_cast<int64_t>(ImGui::GetIO().MouseWheel * 3.0f);
+        if (ImGui::IsItemClicked() && lineCount > 0)
+            m_SelectedLine = std::min(lineCount - 1, m_TopLine + static_cast<uint64_t>((ImGui::GetMousePos().y - origin.y) / lineHeight));
+        if (ImGui::IsWindowFocused())
+        {
+            const int64_t page = static_cast<int64_t>(visibleLines);
+            scroll += ImGui::IsKeyPressed(ImGuiKey_DownArrow) ? 1 : 0;
+            scroll -= ImGui::IsKeyPressed(ImGuiKey_UpArrow) ? 1 : 0;
+            scroll += ImGui::IsKeyPressed(ImGuiKey_PageDown) ? page : 0;
+            scroll -= ImGui::IsKeyPressed(ImGuiKey_PageUp) ? page : 0;
+            if (ImGui::IsKeyPressed(ImGuiKey_Home))
+                scroll = -static_cast<int64_t>(m_TopLine);
+            if (ImGui::IsKeyPressed(ImGuiKey_End))
+                m_bFollow = true;
+        }
+        if (scroll < 0)
+            m_bFollow = false;
+        m_TopLine = scroll < 0 ? m_TopLine - std::min<uint64_t>(m_TopLine, static_cast<uint64_t>(-scroll)) : m_TopLine + static_cast<uint64_t>(scroll);
+        if (m_bScrollToSelected && m_SelectedLine < lineCount)
+        {
+            if (m_SelectedLine < m_TopLine || m_SelectedLine >= m_TopLine + visibleLines)
+                m_TopLine = m_SelectedLine > visibleLines / 2 ? m_SelectedLine - visibleLines / 2 : 0;
+            m_bScrollToSelected = false;
+        }
+        if (m_bFollow)
+            m_TopLine = maxTopLine;
+        m_TopLine = std::min(m_TopLine, maxTopLine);
+
+        const ImRect scrollbar(window->InnerRect.Max.x - style.ScrollbarSize, window->InnerRect.Min.y, window->InnerRect.Max.x, window->InnerRect.Max.y);
+        ImS64 topLine = static_cast<ImS64>(m_TopLine);
+        if (ImGui::ScrollbarEx(scrollbar, ImGui::GetID("##Scrollbar"), ImGuiAxis_Y, &topLine, static_cast<ImS64>(visibleLines),
+                               static_cast<ImS64>(std::max(lineCount, visibleLines)), ImDrawFlags_RoundCornersAll))
+        {
+            m_TopLine = static_cast<uint64_t>(topLine);
+            m_bFollow = m_TopLine >= maxTopLine && lineCount > visibleLines;
+        }
+
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        DrawHitMarkers(*drawList, scrollbar, lineCount);
+
+        char number[24];
+        const int digits = snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(std::max<uint64_t>(lineCount, 1)));
+        const float gutterWidth = ImGui::CalcTextSize("0").x * static_cast<float>(digits) + style.ItemSpacing.x * 2.0f;
+        const ImU32 textColor = ImGui::GetColorU32(ImGuiCol_Text);
+        const ImU32 numberColor = ImGui::GetColorU32(ImGuiCol_TextDisabled);
+        const ImU32 selectedColor = ImGui::GetColorU32(ImGuiCol_Header);
+        const ImU32 matchColor = ImGui::GetColorU32(ImGuiCol_TextSelectedBg);
+        const float textRight = scrollbar.Min.x;
+
+        drawList->PushClipRect(window->InnerRect.Min, ImVec2(textRight, window->InnerRect.Max.y), true);
+        for (uint64_t row = 0; row <= visibleLines && m_TopLine + row < lineCount; row++)
+        {
+            const uint64_t line = m_TopLine + row;
+            const float y = origin.y + static_cast<float>(row) * lineHeight;
+            if (line == m_SelectedLine)
+                drawList->AddRectFilled(ImVec2(origin.x, y), ImVec2(textRight, y + lineHeight), selectedColor);
+
+            snprintf(number, sizeof(number), "%*llu", digits, static_cast<unsigned long long>(line + 1));
+            drawList->AddText(ImVec2(origin.x, y), numberColor, number);
+
+            std::string_view text = GetLine(line);
+            if (text.size() > MAX_DISPLAY_BYTES)
+                text = text.substr(0, MAX_DISPLAY_BYTES);
+            const float textX = origin.x + gutterWidth;
+            if (IsHit(line))
+            {
+                const char* textEnd = text.data() + text.size();
+                for (const char* match = text.data(); (match = ImStristrPrepared(match, textEnd, m_Search->Needle)) != nullptr;)
+                {
+                    const char* matchEnd = std::min(textEnd, match + m_Search->Text.size());
+                    const float x0 = textX + ImGui::CalcTextSize(text.data(), match).x;
+                    const float x1 = x0 + ImGui::CalcTextSize(match, matchEnd).x;
+                    drawList->AddRectFilled(ImVec2(x0, y), ImVec2(x1, y + lineHeight), matchColor);
+                    match = matchEnd;
+                    if (x1 > textRight)
+                        break;
+                }
+            }
+            drawList->AddText(ImVec2(textX, y), textColor, text.data(), text.data() + text.size());
+        }
+        drawList->PopClipRect();
+    }
+
+    /**
+     * \brief Marks the scrollbar rows holding hits; rebuilt only when the hits or the line count change, and at most every
+     * quarter second while they keep changing
+     */
+    void DrawHitMarkers(ImDrawList& DrawList, const ImRect& Scrollbar, const uint64_t LineCount)
+    {
+        if (!m_Search || LineCount == 0)
+            return;
+
+        const int height = std::max(1, static_cast<int>(Scrollbar.GetHeight()));
+        const MarkersKey key{m_Search->Generation, LineCount, m_HitCount, height};
+        const auto now = std::chrono::steady_clock::now();
+        const bool bSettled = m_bSearchComplete && m_IndexedChunks == m_Chunks.size();
+        if (key != m_MarkersKey && (bSettled || now - m_MarkersTime >= std::chrono::milliseconds(250) || m_MarkersKey.Generation != key.Generation))
+        {
+            m_MarkersKey = key;
+            m_MarkersTime = now;
+            m_Markers.assign(static_cast<size_t>(height), 0);
+            const auto mark = [this, height, LineCount](const uint64_t Line)
+            {
+                m_Markers[static_cast<size_t>(static_cast<double>(Line) * height / static_cast<double>(LineCount))] = 1;
+            };
+            for (size_t chunkIndex = 0; chunkIndex < m_IndexedChunks; chunkIndex++)
+            {
+                const Chunk& chunk = *m_Chunks[chunkIndex];
+                if (chunk.SearchGeneration.load(std::memory_order_acquire) != key.Generation)
+                    continue;
+                for (const uint32_t local : chunk.Hits)
+                    mark(chunk.FirstLine + local);
+            }
+            if (m_bTailHit)
+                mark(m_TerminatedLines);
+        }
+
+        const ImU32 markerColor = ImGui::GetColorU32(ImGuiCol_PlotHistogram);
+        for (size_t row = 0; row < m_Markers.size(); row++)
+        {
+            if (m_Markers[row])
+            {
+                const float y = Scrollbar.Min.y + static_cast<float>(row);
+                DrawList.AddRectFilled(ImVec2(Scrollbar.Min.x + 2.0f, y), ImVec2(Scrollbar.Max.x - 2.0f, y + 2.0f), markerColor);
+            }
+        }
+    }
+
+    JobSystem& m_Jobs;
+
+    std::string m_Path;
+    FileHandle m_File{INVALID_FILE};
+#if defined(__linux__)
+    int m_Inotify{-1};
+#endif
+    std::unique_ptr<Mapping> m_Mapping;
+    std::vector<std::unique_ptr<Mapping>> m_Retired;
+    uint64_t m_FileBytes{0};
+    std::chrono::steady_clock::time_point m_LastPoll;
+    std::chrono::steady_clock::time_point m_LastGrowth;
+    bool m_bReplaced{false};
+    // size last seen; appends are indexed at most every GROWTH_INTERVAL
+    uint64_t m_PendingBytes{0};
+
+    // chunks are only appended while open, except that the last one is replaced by an extended copy while it is not full;
+    // jobs hold pointers to them, so replaced ones are retired until no job runs
+    std::vector<std::unique_ptr<Chunk>> m_Chunks;
+    std::unique_ptr<Chunk> m_TailReplacement;
+    std::vector<std::unique_ptr<Chunk>> m_RetiredChunks;
+    size_t m_IndexedChunks{0};
+    std::vector<uint64_t> m_ChunkFirstLines;
+    uint64_t m_IndexedBytes{0};
+    uint64_t m_IndexBytes{0};
+    uint64_t m_TerminatedLines{0};
+    uint64_t m_NextLineStart{0};
+
+    std::string m_SearchText;
+    char m_SearchBuffer[256]{};
+    std::shared_ptr<const SearchQuery> m_Search;
+    // chunks searched for this generation or later can narrow their hits instead of rescanning
+    uint64_t m_NarrowFromGeneration{0};
+    uint64_t m_HitCount{0};
+    bool m_bSearchComplete{true};
+    bool m_bTailHit{false};
+    TailKey m_TailKey;
+
+    std::vector<uint8_t> m_Markers;
+    MarkersKey m_MarkersKey;
+    std::chrono::steady_clock::time_point m_MarkersTime;
+
+    uint64_t m_TopLine{0};
+    uint64_t m_SelectedLine{UINT64_MAX};
+    bool m_bFollow{false};
+    bool m_bScrollToSelected{false};
+
+    std::atomic<uint64_t> m_FileGeneration{0};
+    std::atomic<uint64_t> m_SearchGeneration{0};
+    std::atomic<bool> m_bSearchRunning{false};
+    std::atomic<uint32_t> m_InFlight{0};
+};
@@ -106,7 +106,12 @@ public:
         model = glm::translate(model, CUBE_POSITIONS[i]);
         //float angle = 20.0f * i;
         //model = glm::rotate(model, glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
-        Shader.SetMat4("model", model);
+        Draw(Shader, model);
+    }
+
+    void Draw(const Shader& Shader, const glm::mat4& Model) const
+    {
+        Shader.SetMat4("model", Model);
 
         glDrawArrays(GL_TRIANGLES, 0, 36);
     }
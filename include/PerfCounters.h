@@ -0,0 +1,417 @@
+#pragma once
+
+#include "CpuProfiler.h"
+
+#include "LegitProfiler/ProfilerTask.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * \brief Counter values of one interval, in the order of PerfCounters::GetCounterName()
+ */
+struct PerfCounterValues
+{
+    static constexpr uint32_t MAX_COUNTERS = 5;
+
+    uint64_t Values[MAX_COUNTERS]{};
+
+    PerfCounterValues operator-(const PerfCounterValues& Other) const
+    {
+        PerfCounterValues result;
+        for (uint32_t i = 0; i < MAX_COUNTERS; i++)
+            result.Values[i] = Values[i] >= Other.Values[i] ? Values[i] - Other.Values[i] : 0;
+        return result;
+    }
+
+    PerfCounterValues& operator+=(const PerfCounterValues& Other)
+    {
+        for (uint32_t i = 0; i < MAX_COUNTERS; i++)
+            Values[i] += Other.Values[i];
+        return *this;
+    }
+};
+
+/**
+ * \brief Per-thread perf_event counter groups (Linux), read per frame and per PROFILE_SCOPE_COUNTERS scope.
+ *
+ * Each thread opens its own group on first use: cycles, instructions, LLC misses, branch misses and context switches
+ * when the CPU exposes a PMU, otherwise (e.g. in most VMs) the software set task clock, context switches, page faults
+ * and CPU migrations. Groups are read with one read() and scaled by enabled/running time, so multiplexed counters
+ * stay comparable. Off by default; while disabled a counted scope costs one relaxed atomic load.
+ */
+class PerfCounters
+{
+public:
+    enum class Mode : uint8_t
+    {
+        UNAVAILABLE,
+        SOFTWARE,
+        HARDWARE
+    };
+
+    /**
+     * \brief Counters accumulated over one frame for one scope name (all threads combined)
+     */
+    struct ScopeStats
+    {
+        uint32_t NameId{0};
+        uint32_t Calls{0};
+        PerfCounterValues Counters;
+        // "<scope> <counter>" names for capture export, interned when the scope is first seen
+        uint32_t CounterNameIds[PerfCounterValues::MAX_COUNTERS]{};
+    };
+
+    /**
+     * \brief Enables counting. The first call probes the counter set on the calling thread; returns false if
+     * perf_event_open is unavailable (non-Linux, seccomp, perf_event_paranoid 3) and counting stays off.
+     */
+    static bool SetEnabled(const bool bEnabled)
+    {
+        if (bEnabled && s_Mode.load(std::memory_order_acquire) == Mode::UNAVAILABLE)
+        {
+            std::lock_guard lock(s_Mutex);
+            if (s_Mode.load(std::memory_order_relaxed) == Mode::UNAVAILABLE)
+                Probe();
+        }
+        const bool bAvailable = s_Mode.load(std::memory_order_acquire) != Mode::UNAVAILABLE;
+        s_bEnabled.store(bEnabled && bAvailable, std::memory_order_relaxed);
+        return !bEnabled || bAvailable;
+    }
+
+    [[nodiscard]] static bool IsEnabled() { return s_bEnabled.load(std::memory_order_relaxed); }
+    [[nodiscard]] static Mode GetMode() { return s_Mode.load(std::memory_order_acquire); }
+
+    /**
+     * \brief Why counters are unavailable or limited, for display; empty when hardware counters work
+     */
+    [[nodiscard]] static const char* GetStatus() { return s_Status; }
+
+    [[nodiscard]] static uint32_t GetCounterCount() { return GetMode() == Mode::HARDWARE ? 5 : GetMode() == Mode::SOFTWARE ? 4 : 0; }
+
+    static const char* GetCounterName(const uint32_t Index)
+    {
+        static constexpr const char* HARDWARE_NAMES[] = {"cycles", "instructions", "LLC misses", "branch misses", "context switches"};
+        static constexpr const char* SOFTWARE_NAMES[] = {"task clock (ns)", "context switches", "page faults", "CPU migrations", ""};
+        return GetMode() == Mode::HARDWARE ? HARDWARE_NAMES[Index] : SOFTWARE_NAMES[Index];
+    }
+
+    /**
+     * \brief Reads the calling thread's counters (cumulative since its group was opened). Returns false if the thread
+     * has no group; Values is then zero.
+     */
+    static bool Read(PerfCounterValues& Values)
+    {
+        Values = PerfCounterValues();
+        ThreadGroup& group = GetThreadGroup();
+        if (!group.bOpened)
+            group.Open(GetMode());
+        return group.Read(Values);
+    }
+
+    /**
+     * \brief Adds one execution of a scope; called by PerfCounterScope
+     */
+    static void AddScope(const uint32_t NameId, const PerfCounterValues& Delta)
+    {
+        std::lock_guard lock(s_Mutex);
+        ScopeStats* stats = nullptr;
+        for (ScopeStats& candidate : s_PendingScopes)
+        {
+            if (candidate.NameId == NameId)
+            {
+                stats = &candidate;
+                break;
+            }
+        }
+        if (!stats)
+        {
+            stats = &s_PendingScopes.emplace_back();
+            stats->NameId = NameId;
+            InternCounterNames(legit::TaskNames::Get(NameId), stats->CounterNameIds);
+        }
+        stats->Calls++;
+        stats->Counters += Delta;
+    }
+
+    /**
+     * \brief Starts the frame interval on the main thread
+     */
+    static void BeginFrame()
+    {
+        if (IsEnabled())
+            Read(s_FrameStart);
+    }
+
+    /**
+     * \brief Ends the frame interval and publishes it together with the scopes completed since the last EndFrame()
+     */
+    static void EndFrame()
+    {
+        if (!IsEnabled())
+        {
+            s_bFrameValid = false;
+            return;
+        }
+
+        PerfCounterValues frameEnd;
+        s_bFrameValid = Read(frameEnd);
+        s_Frame = frameEnd - s_FrameStart;
+        if (s_FrameCounterNameIds[0] == 0)
+            InternCounterNames("Frame", s_FrameCounterNameIds);
+
+        std::lock_guard lock(s_Mutex);
+        // entries are kept (zeroed) so steady-state frames do not allocate
+        s_FrameScopes.resize(s_PendingScopes.size());
+        for (size_t i = 0; i < s_PendingScopes.size(); i++)
+        {
+            s_FrameScopes[i] = s_PendingScopes[i];
+            s_PendingScopes[i].Calls = 0;
+            s_PendingScopes[i].Counters = PerfCounterValues();
+        }
+    }
+
+    /**
+     * \brief Main-thread counters of the last frame; false if counting is off or the read failed
+     */
+    [[nodiscard]] static bool GetFrameCounters(PerfCounterValues& Values)
+    {
+        Values = s_Frame;
+        return s_bFrameValid;
+    }
+
+    [[nodiscard]] static const uint32_t* GetFrameCounterNameIds() { return s_FrameCounterNameIds; }
+
+    /**
+     * \brief Counted scopes of the last frame; scopes that did not run have Calls == 0
+     */
+    [[nodiscard]] static const std::vector<ScopeStats>& GetFrameScopes() { return s_FrameScopes; }
+
+private:
+    struct ThreadGroup
+    {
+        int Fds[PerfCounterValues::MAX_COUNTERS]{-1, -1, -1, -1, -1};
+        uint32_t Count{0};
+        bool bOpened{false};
+
+        ThreadGroup() = default;
+        ThreadGroup(const ThreadGroup&) = delete;
+        ThreadGroup& operator=(const ThreadGroup&) = delete;
+
+        ~ThreadGroup() { Close(); }
+
+        /**
+         * \brief Opens the counter set of Target on the calling thread; returns false if any event fails to open
+         */
+        bool Open(const Mode Target)
+        {
+            Close();
+            bOpened = true;
+#if defined(__linux__)
+            struct Event
+            {
+                uint32_t Type;
+                uint64_t Config;
+            };
+            static constexpr Event HARDWARE_EVENTS[] = {{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                                                        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+                                                        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+                                                        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+                                                        {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES}};
+            static constexpr Event SOFTWARE_EVENTS[] = {{PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+                                                        {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+                                                        {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+                                                        {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS}};
+            const Event* events = Target == Mode::HARDWARE ? HARDWARE_EVENTS : SOFTWARE_EVENTS;
+            const uint32_t eventCount = Target == Mode::HARDWARE ? 5 : Target == Mode::SOFTWARE ? 4 : 0;
+
+            for (uint32_t i = 0; i < eventCount; i++)
+            {
+                Fds[i] = OpenEvent(events[i].Type, events[i].Config, i == 0 ? -1 : Fds[0]);
+                if (Fds[i] < 0)
+                {
+                    Close();
+                    bOpened = true;
+                    return false;
+                }
+                Count = i + 1;
+            }
+            return Count > 0;
+#else
+            (void)Target;
+            return false;
+#endif
+        }
+
+        bool Read(PerfCounterValues& Values) const
+        {
+#if defined(__linux__)
+            if (Count == 0)
+                return false;
+            // PERF_FORMAT_GROUP | TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING: nr, enabled, running, values[nr]
+            uint64_t buffer[3 + PerfCounterValues::MAX_COUNTERS];
+            if (read(Fds[0], buffer, sizeof(buffer)) < static_cast<ssize_t>((3 + Count) * sizeof(uint64_t)))
+                return false;
+            const uint64_t enabled = buffer[1];
+            const uint64_t running = buffer[2];
+            for (uint32_t i = 0; i < Count && i < buffer[0]; i++)
+            {
+                // scaled up for the share of time the group was multiplexed out
+                Values.Values[i] = running > 0 && running < enabled
+                                       ? static_cast<uint64_t>(static_cast<double>(buffer[3 + i]) * enabled / running)
+                                       : buffer[3 + i];
+            }
+            return true;
+#else
+            (void)Values;
+            return false;
+#endif
+        }
+
+        void Close()
+        {
+#if defined(__linux__)
+            for (int& fd : Fds)
+            {
+                if (fd >= 0)
+                    close(fd);
+                fd = -1;
+            }
+#endif
+            Count = 0;
+            bOpened = false;
+        }
+    };
+
+    static ThreadGroup& GetThreadGroup()
+    {
+        static thread_local ThreadGroup group;
+        return group;
+    }
+
+#if defined(__linux__)
+    static int OpenEvent(const uint32_t Type, const uint64_t Config, const int GroupFd)
+    {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = Type;
+        attr.config = Config;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.exclude_hv = 1;
+        // context switches happen in the kernel, so they read 0 in user-only mode; count them there if permitted
+        const bool bKernelEvent = Type == PERF_TYPE_SOFTWARE && Config == PERF_COUNT_SW_CONTEXT_SWITCHES;
+        attr.exclude_kernel = bKernelEvent ? 0 : 1;
+        int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, GroupFd, PERF_FLAG_FD_CLOEXEC));
+        if (fd < 0 && bKernelEvent)
+        {
+            attr.exclude_kernel = 1;
+            fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, GroupFd, PERF_FLAG_FD_CLOEXEC));
+        }
+        return fd;
+    }
+#endif
+
+    /**
+     * \brief Picks the counter set: hardware if the calling thread can open it, otherwise software. Holds s_Mutex.
+     */
+    static void Probe()
+    {
+#if defined(__linux__)
+        ThreadGroup& group = GetThreadGroup();
+        if (group.Open(Mode::HARDWARE))
+        {
+            s_Status[0] = '\0';
+            s_Mode.store(Mode::HARDWARE, std::memory_order_release);
+            return;
+        }
+        const int hardwareError = errno;
+        if (group.Open(Mode::SOFTWARE))
+        {
+            snprintf(s_Status, sizeof(s_Status), "No hardware counters (%s); showing software counters", strerror(hardwareError));
+            s_Mode.store(Mode::SOFTWARE, std::memory_order_release);
+            return;
+        }
+        snprintf(s_Status, sizeof(s_Status), "perf_event_open failed: %s (see /proc/sys/kernel/perf_event_paranoid)", strerror(errno));
+        group.Close();
+#else
+        snprintf(s_Status, sizeof(s_Status), "Performance counters are only supported on Linux");
+#endif
+    }
+
+    static void InternCounterNames(const char* Prefix, uint32_t* NameIds)
+    {
+        char name[160];
+        for (uint32_t i = 0; i < GetCounterCount(); i++)
+        {
+            snprintf(name, sizeof(name), "%s %s", Prefix, GetCounterName(i));
+            NameIds[i] = legit::TaskNames::Intern(name);
+        }
+    }
+
+    static inline std::atomic<bool> s_bEnabled{false};
+    static inline std::atomic<Mode> s_Mode{Mode::UNAVAILABLE};
+    static inline char s_Status[160]{};
+
+    static inline std::mutex s_Mutex;
+    static inline std::vector<ScopeStats> s_PendingScopes;
+    static inline std::vector<ScopeStats> s_FrameScopes;
+
+    // main thread only
+    static inline PerfCounterValues s_FrameStart;
+    static inline PerfCounterValues s_Frame;
+    static inline bool s_bFrameValid{false};
+    static inline uint32_t s_FrameCounterNameIds[PerfCounterValues::MAX_COUNTERS]{};
+};
+
+/**
+ * \brief Adds the calling thread's counter deltas over its lifetime to PerfCounters' stats for NameId
+ */
+class PerfCounterScope
+{
+public:
+    explicit PerfCounterScope(const uint32_t NameId) : m_NameId(NameId), m_bActive(PerfCounters::IsEnabled())
+    {
+        if (m_bActive)
+            m_bActive = PerfCounters::Read(m_Begin);
+    }
+
+    ~PerfCounterScope()
+    {
+        if (!m_bActive)
+            return;
+        PerfCounterValues end;
+        if (PerfCounters::Read(end))
+            PerfCounters::AddScope(m_NameId, end - m_Begin);
+    }
+
+    PerfCounterScope(const PerfCounterScope&) = delete;
+    PerfCounterScope& operator=(const PerfCounterScope&) = delete;
+
+private:
+    uint32_t m_NameId;
+    bool m_bActive;
+    PerfCounterValues m_Begin;
+};
+
+#if PROFILER_ENABLED
+/**
+ * \brief PROFILE_SCOPE that also collects PerfCounters for the scope while counting is enabled
+ */
+#define PROFILE_SCOPE_COUNTERS(Name)                                                                                   \
+    static const uint32_t PROFILE_CONCAT(profileNameId, __LINE__) = CpuProfiler::InternName(Name);                     \
+    CpuProfileScope PROFILE_CONCAT(profileScope, __LINE__)(PROFILE_CONCAT(profileNameId, __LINE__));                   \
+    PerfCounterScope PROFILE_CONCAT(perfScope, __LINE__)(PROFILE_CONCAT(profileNameId, __LINE__))
+#else
+#define PROFILE_SCOPE_COUNTERS(Name) ((void)0)
+#endif
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "PerfCounters.h"
+
+#include "LegitProfiler/ProfilerTask.h"
+
+#include "imgui.h"
+#include "implot/implot.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+
+/**
+ * \brief ImGui window with the PerfCounters of the last frame (main thread and counted scopes) and a history plot of
+ * one frame counter. Sits next to the profiler graphs: those show where time goes, this shows why.
+ */
+class PerfCountersPanel
+{
+public:
+    static constexpr size_t HISTORY_SIZE = 300;
+
+    /**
+     * \brief Records the frame PerfCounters::EndFrame() just published; call once per frame
+     */
+    void AddFrame()
+    {
+        PerfCounterValues frame;
+        if (!PerfCounters::GetFrameCounters(frame))
+            return;
+        for (uint32_t i = 0; i < PerfCounterValues::MAX_COUNTERS; i++)
+            m_History[i][m_HistoryCount % HISTORY_SIZE] = static_cast<float>(frame.Values[i]);
+        m_HistoryCount++;
+    }
+
+    void Render()
+    {
+        ImGui::Begin("Performance Counters");
+
+        bool bEnabled = PerfCounters::IsEnabled();
+        if (ImGui::Checkbox("Count (perf_event)", &bEnabled))
+            PerfCounters::SetEnabled(bEnabled);
+        if (PerfCounters::GetStatus()[0])
+            ImGui::TextWrapped("%s", PerfCounters::GetStatus());
+
+        const uint32_t counterCount = PerfCounters::GetCounterCount();
+        const bool bHardware = PerfCounters::GetMode() == PerfCounters::Mode::HARDWARE;
+        PerfCounterValues frame;
+        if (!PerfCounters::GetFrameCounters(frame) || counterCount == 0)
+        {
+            ImGui::End();
+            return;
+        }
+
+        const int columns = 2 + static_cast<int>(counterCount) + (bHardware ? 1 : 0);
+        if (ImGui::BeginTable("Counters", columns, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp))
+        {
+            ImGui::TableSetupColumn("Scope");
+            ImGui::TableSetupColumn("Calls");
+            for (uint32_t i = 0; i < counterCount; i++)
+                ImGui::TableSetupColumn(PerfCounters::GetCounterName(i));
+            if (bHardware)
+                ImGui::TableSetupColumn("IPC");
+            ImGui::TableHeadersRow();
+
+            RenderRow("Frame (main thread)", 1, frame, counterCount, bHardware);
+            for (const PerfCounters::ScopeStats& scope : PerfCounters::GetFrameScopes())
+            {
+                if (scope.Calls > 0)
+                    RenderRow(legit::TaskNames::Get(scope.NameId), scope.Calls, scope.Counters, counterCount, bHardware);
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::SetNextItemWidth(200.0f);
+        m_PlottedCounter = std::min(m_PlottedCounter, static_cast<int>(counterCount) - 1);
+        if (ImGui::BeginCombo("Plotted counter", PerfCounters::GetCounterName(static_cast<uint32_t>(m_PlottedCounter))))
+        {
+            for (uint32_t i = 0; i < counterCount; i++)
+            {
+                if (ImGui::Selectable(PerfCounters::GetCounterName(i), m_PlottedCounter == static_cast<int>(i)))
+                    m_PlottedCounter = static_cast<int>(i);
+            }
+            ImGui::EndCombo();
+        }
+
+        const int count = static_cast<int>(std::min<uint64_t>(m_HistoryCount, HISTORY_SIZE));
+        if (count > 0 && ImPlot::BeginPlot("##CounterHistory", ImVec2(-1, 150)))
+        {
+            ImPlot::SetupAxes("frame", PerfCounters::GetCounterName(static_cast<uint32_t>(m_PlottedCounter)),
+                              ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+            const int offset = m_HistoryCount < HISTORY_SIZE ? 0 : static_cast<int>(m_HistoryCount % HISTORY_SIZE);
+            ImPlot::PlotLine("Frame", m_History[m_PlottedCounter].data(), count, 1.0, 0.0, ImPlotLineFlags_None, offset);
+            ImPlot::EndPlot();
+        }
+
+        ImGui::End();
+    }
+
+private:
+    static void RenderRow(const char* Name, const uint32_t Calls, const PerfCounterValues& Values, const uint32_t CounterCount,
+                          const bool bHardware)
+    {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(Name);
+        ImGui::TableNextColumn();
+        ImGui::Text("%u", Calls);
+        for (uint32_t i = 0; i < CounterCount; i++)
+        {
+            ImGui::TableNextColumn();
+            ImGui::Text("%llu", static_cast<unsigned long long>(Values.Values[i]));
+        }
+        if (bHardware)
+        {
+            // cycles and instructions are the first two hardware counters
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", Values.Values[0] > 0 ? static_cast<double>(Values.Values[1]) / Values.Values[0] : 0.0);
+        }
+    }
+
+    std::array<std::array<float, HISTORY_SIZE>, PerfCounterValues::MAX_COUNTERS> m_History{};
+    uint64_t m_HistoryCount{0};
+    int m_PlottedCounter{0};
+};
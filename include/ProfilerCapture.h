@@ -0,0 +1,651 @@
+#pragma once
+
+#include "CpuProfiler.h"
+#include "JobSystem.h"
+
+#include "LegitProfiler/ProfilerTask.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * \brief Streams profiler data (CPU scopes, GPU timings, frame markers and counters) to a binary capture file.
+ *
+ * The main thread serializes each frame into a pooled buffer and hands it to a writer thread, so the only per-frame
+ * cost is a copy of the frame's events. If the writer falls behind and the pool runs dry the frame is dropped rather
+ * than stalling the loop. ExportChromeTrace() converts a capture to Chrome trace JSON, which chrome://tracing and
+ * ui.perfetto.dev both open.
+ *
+ * File layout: an 8-byte magic and a uint32 version, then records, each a one-byte RecordType followed by its fields in
+ * native byte order. Timestamps are CpuProfiler ticks; every frame record carries the current tick calibration.
+ */
+class ProfilerCapture
+{
+public:
+    static constexpr char MAGIC[8] = {'C', 'P', 'G', 'C', 'A', 'P', '\0', '\0'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t BUFFER_COUNT = 32;
+    static constexpr size_t BUFFER_RESERVE = 256 * 1024;
+
+    enum class RecordType : uint8_t
+    {
+        NAME = 1,      // uint32 id, uint16 length, characters
+        THREAD = 2,    // uint16 index, uint16 length, characters
+        FRAME = 3,     // uint64 index, uint64 begin, uint64 end, double seconds per tick
+        CPU_EVENT = 4, // uint64 begin, uint64 end, uint32 name, uint16 depth, uint16 thread
+        GPU_TASK = 5,  // uint64 anchor tick, double start, double end (seconds after the anchor), uint32 name
+        COUNTER = 6,   // uint64 tick, uint32 name, double value
+    };
+
+    /**
+     * \brief A per-frame counter sample; NameId from legit::TaskNames::Intern()
+     */
+    struct Counter
+    {
+        uint32_t NameId;
+        double Value;
+    };
+
+    ProfilerCapture() = default;
+
+    ~ProfilerCapture()
+    {
+        Stop();
+    }
+
+    ProfilerCapture(const ProfilerCapture&) = delete;
+    ProfilerCapture& operator=(const ProfilerCapture&) = delete;
+
+    bool Start(const char* Path)
+    {
+        Stop();
+
+        m_File = fopen(Path, "wb");
+        if (!m_File)
+        {
+            std::cout << "Failed to open capture file " << Path << std::endl;
+            return false;
+        }
+        std::vector<char> header;
+        EncodeHeader(header);
+        fwrite(header.data(), 1, header.size(), m_File);
+
+        m_Path = Path;
+        m_FreeBuffers.clear();
+        m_FreeBuffers.reserve(BUFFER_COUNT);
+        m_PendingBegin = 0;
+        m_PendingCount = 0;
+        for (size_t i = 0; i < BUFFER_COUNT; i++)
+        {
+            m_Buffers[i].clear();
+            m_Buffers[i].reserve(BUFFER_RESERVE);
+            m_FreeBuffers.push_back(&m_Buffers[i]);
+        }
+        m_Current = TakeFreeBuffer();
+        m_bNameWritten.assign(legit::TaskNames::maxNames, false);
+        m_ThreadsWritten = 0;
+        m_FrameIndex = 0;
+        m_DroppedFrames = 0;
+        m_WrittenBytes = 0;
+        m_bStopRequested = false;
+        m_Writer = std::thread([this]() { WriterMain(); });
+        return true;
+    }
+
+    void Stop()
+    {
+        if (!m_File)
+            return;
+
+        {
+            std::lock_guard lock(m_Mutex);
+            m_bStopRequested = true;
+        }
+        m_Cond.notify_one();
+        m_Writer.join();
+
+        fclose(m_File);
+        m_File = nullptr;
+        std::cout << "Wrote capture " << m_Path << " (" << m_FrameIndex << " frames, " << m_DroppedFrames << " dropped)"
+                  << std::endl;
+    }
+
+    [[nodiscard]] bool IsCapturing() const { return m_File != nullptr; }
+    [[nodiscard]] uint64_t GetFrameCount() const { return m_FrameIndex; }
+    [[nodiscard]] uint64_t GetDroppedFrameCount() const { return m_DroppedFrames; }
+    [[nodiscard]] uint64_t GetWrittenBytes() const { return m_WrittenBytes.load(std::memory_order_relaxed); }
+    [[nodiscard]] const std::string& GetPath() const { return m_Path; }
+
+    /**
+     * \brief Records the frame CpuProfiler just drained (call after CpuProfiler::EndFrame()), the GPU timings that became
+     * available during it and the frame's counters, then hands the frame to the writer
+     */
+    void SubmitFrame(const legit::ProfilerTask* GpuTasks, const size_t GpuTaskCount, const Counter* Counters,
+                     const size_t CounterCount)
+    {
+        if (!m_File)
+            return;
+        if (!m_Current)
+        {
+            // every buffer is still queued for the writer; skip this frame instead of waiting
+            m_Current = TakeFreeBuffer();
+            m_DroppedFrames++;
+            return;
+        }
+
+        const uint32_t threadCount = CpuProfiler::GetThreadCount();
+        for (; m_ThreadsWritten < threadCount; m_ThreadsWritten++)
+            EncodeThread(*m_Current, m_ThreadsWritten);
+
+        // names go out the first time a frame references them, ahead of that frame's records
+        for (const ProfilerEvent& event : CpuProfiler::GetFrameEvents())
+            WriteNameOnce(event.NameId);
+        for (size_t i = 0; i < GpuTaskCount; i++)
+            WriteNameOnce(GpuTasks[i].nameId);
+        for (size_t i = 0; i < CounterCount; i++)
+            WriteNameOnce(Counters[i].NameId);
+
+        EncodeFrame(*m_Current, m_FrameIndex++, GpuTasks, GpuTaskCount, Counters, CounterCount);
+
+        {
+            std::lock_guard lock(m_Mutex);
+            m_PendingBuffers[(m_PendingBegin + m_PendingCount++) % BUFFER_COUNT] = m_Current;
+            m_Current = m_FreeBuffers.empty() ? nullptr : m_FreeBuffers.back();
+            if (m_Current)
+                m_FreeBuffers.pop_back();
+        }
+        m_Cond.notify_one();
+    }
+
+    static void EncodeHeader(std::vector<char>& Buffer)
+    {
+        Buffer.insert(Buffer.end(), MAGIC, MAGIC + sizeof(MAGIC));
+        const char* version = reinterpret_cast<const char*>(&VERSION);
+        Buffer.insert(Buffer.end(), version, version + sizeof(VERSION));
+    }
+
+    static void EncodeName(std::vector<char>& Buffer, const uint32_t NameId)
+    {
+        WriteRecord(Buffer, RecordType::NAME, NameId);
+        WriteString(Buffer, legit::TaskNames::Get(NameId));
+    }
+
+    static void EncodeThread(std::vector<char>& Buffer, const uint32_t ThreadIndex)
+    {
+        WriteRecord(Buffer, RecordType::THREAD, static_cast<uint16_t>(ThreadIndex));
+        WriteString(Buffer, CpuProfiler::GetThreadName(ThreadIndex));
+    }
+
+    /**
+     * \brief Appends the frame record, the CPU events of the frame CpuProfiler just drained, GPU timings and counters.
+     * GPU timings are relative to their own frame start and are placed at the beginning of the frame that received them.
+     * Name and thread records are left to the caller.
+     */
+    static void EncodeFrame(std::vector<char>& Buffer, const uint64_t FrameIndex, const legit::ProfilerTask* GpuTasks,
+                            const size_t GpuTaskCount, const Counter* Counters, const size_t CounterCount)
+    {
+        const uint64_t frameBegin = CpuProfiler::GetFrameBegin();
+        const uint64_t frameEnd = CpuProfiler::GetFrameEnd();
+        WriteRecord(Buffer, RecordType::FRAME, FrameIndex, frameBegin, frameEnd, CpuProfiler::TicksToSeconds(1));
+
+        for (const ProfilerEvent& event : CpuProfiler::GetFrameEvents())
+            WriteRecord(Buffer, RecordType::CPU_EVENT, event.Begin, event.End, event.NameId, event.Depth, event.ThreadIndex);
+
+        for (size_t i = 0; i < GpuTaskCount; i++)
+            WriteRecord(Buffer, RecordType::GPU_TASK, frameBegin, GpuTasks[i].startTime, GpuTasks[i].endTime, GpuTasks[i].nameId);
+
+        for (size_t i = 0; i < CounterCount; i++)
+            WriteRecord(Buffer, RecordType::COUNTER, frameEnd, Counters[i].NameId, Counters[i].Value);
+    }
+
+    /**
+     * \brief Converts a capture file to Chrome trace event JSON
+     */
+    static bool ExportChromeTrace(const char* CapturePath, const char* TracePath)
+    {
+        std::vector<char> data;
+        if (!ReadWholeFile(CapturePath, data))
+            return false;
+        if (data.size() < sizeof(MAGIC) + sizeof(VERSION) || memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0)
+        {
+            std::cout << "Not a capture file " << CapturePath << std::endl;
+            return false;
+        }
+
+        // first pass: names, thread names and the time base
+        std::vector<std::string> names;
+        std::vector<std::string> threads;
+        uint64_t firstTick = UINT64_MAX;
+        double secondsPerTick = 1e-9;
+        CaptureReader reader(data);
+        RecordType type;
+        while (reader.Next(type))
+        {
+            if (type == RecordType::NAME)
+            {
+                const uint32_t id = reader.Read<uint32_t>();
+                if (id >= names.size())
+                    names.resize(id + 1);
+                names[id] = reader.ReadString();
+            }
+            else if (type == RecordType::THREAD)
+            {
+                const uint16_t index = reader.Read<uint16_t>();
+                if (index >= threads.size())
+                    threads.resize(index + 1);
+                threads[index] = reader.ReadString();
+            }
+            else if (type == RecordType::FRAME)
+            {
+                reader.Read<uint64_t>();
+                firstTick = std::min(firstTick, reader.Read<uint64_t>());
+                reader.Read<uint64_t>();
+                secondsPerTick = reader.Read<double>();
+            }
+            else if (!reader.Skip(type))
+            {
+                break;
+            }
+        }
+        if (!reader.IsValid())
+        {
+            std::cout << "Capture file is truncated or corrupt " << CapturePath << std::endl;
+            return false;
+        }
+        if (firstTick == UINT64_MAX)
+            firstTick = 0;
+
+        FILE* out = fopen(TracePath, "wb");
+        if (!out)
+        {
+            std::cout << "Failed to open trace file " << TracePath << std::endl;
+            return false;
+        }
+
+        const uint32_t gpuThread = static_cast<uint32_t>(CpuProfiler::MAX_THREADS);
+        const uint32_t frameThread = gpuThread + 1;
+        auto toMicroseconds = [&](const uint64_t Tick)
+        { return Tick > firstTick ? static_cast<double>(Tick - firstTick) * secondsPerTick * 1e6 : 0.0; };
+        auto nameOf = [&](const uint32_t Id) { return Id < names.size() ? names[Id].c_str() : "?"; };
+
+        fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", out);
+        bool bFirst = true;
+        auto beginEvent = [&]()
+        {
+            fputs(bFirst ? "" : ",\n", out);
+            bFirst = false;
+        };
+
+        for (size_t i = 0; i < threads.size(); i++)
+        {
+            beginEvent();
+            fprintf(out, "{\"ph\":\"M\",\"pid\":1,\"tid\":%zu,\"name\":\"thread_name\",\"args\":{\"name\":", i);
+            WriteJsonString(out, threads[i].c_str());
+            fputs("}}", out);
+        }
+        beginEvent();
+        fprintf(out, "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"GPU\"}}", gpuThread);
+        beginEvent();
+        fprintf(out, "{\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"name\":\"thread_name\",\"args\":{\"name\":\"Frames\"}}", frameThread);
+
+        reader = CaptureReader(data);
+        while (reader.Next(type))
+        {
+            if (type == RecordType::FRAME)
+            {
+                const uint64_t index = reader.Read<uint64_t>();
+                const uint64_t begin = reader.Read<uint64_t>();
+                const uint64_t end = reader.Read<uint64_t>();
+                reader.Read<double>();
+                beginEvent();
+                fprintf(out, "{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"name\":\"Frame %llu\",\"ts\":%.3f,\"dur\":%.3f}", frameThread,
+                        static_cast<unsigned long long>(index), toMicroseconds(begin), toMicroseconds(end) - toMicroseconds(begin));
+            }
+            else if (type == RecordType::CPU_EVENT)
+            {
+                const uint64_t begin = reader.Read<uint64_t>();
+                const uint64_t end = reader.Read<uint64_t>();
+                const uint32_t nameId = reader.Read<uint32_t>();
+                reader.Read<uint16_t>();
+                const uint16_t thread = reader.Read<uint16_t>();
+                beginEvent();
+                fprintf(out, "{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":", thread, toMicroseconds(begin),
+                        toMicroseconds(end) - toMicroseconds(begin));
+                WriteJsonString(out, nameOf(nameId));
+                fputs("}", out);
+            }
+            else if (type == RecordType::GPU_TASK)
+            {
+                const double anchor = toMicroseconds(reader.Read<uint64_t>());
+                const double start = reader.Read<double>() * 1e6;
+                const double end = reader.Read<double>() * 1e6;
+                const uint32_t nameId = reader.Read<uint32_t>();
+                beginEvent();
+                fprintf(out, "{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":", gpuThread, anchor + start,
+                        end - start);
+                WriteJsonString(out, nameOf(nameId));
+                fputs("}", out);
+            }
+            else if (type == RecordType::COUNTER)
+            {
+                const uint64_t tick = reader.Read<uint64_t>();
+                const uint32_t nameId = reader.Read<uint32_t>();
+                const double value = reader.Read<double>();
+                beginEvent();
+                fprintf(out, "{\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"name\":", toMicroseconds(tick));
+                WriteJsonString(out, nameOf(nameId));
+                fprintf(out, ",\"args\":{\"value\":%.17g}}", value);
+            }
+            else
+            {
+                reader.Skip(type);
+            }
+        }
+
+        fputs("\n]}\n", out);
+        const bool bWritten = ferror(out) == 0;
+        fclose(out);
+        if (!bWritten)
+            std::cout << "Failed to write trace file " << TracePath << std::endl;
+        return bWritten;
+    }
+
+private:
+    /**
+     * \brief Bounds-checked sequential reader over a capture file loaded in memory
+     */
+    class CaptureReader
+    {
+    public:
+        explicit CaptureReader(const std::vector<char>& Data) : m_Data(&Data), m_Offset(sizeof(MAGIC) + sizeof(VERSION)) {}
+
+        bool Next(RecordType& Type)
+        {
+            if (!m_bValid || m_Offset >= m_Data->size())
+                return false;
+            Type = static_cast<RecordType>(Read<uint8_t>());
+            return m_bValid;
+        }
+
+        template <typename T>
+        T Read()
+        {
+            T value{};
+            if (m_Offset + sizeof(T) > m_Data->size())
+            {
+                m_bValid = false;
+                m_Offset = m_Data->size();
+                return value;
+            }
+            memcpy(&value, m_Data->data() + m_Offset, sizeof(T));
+            m_Offset += sizeof(T);
+            return value;
+        }
+
+        std::string ReadString()
+        {
+            const uint16_t length = Read<uint16_t>();
+            if (m_Offset + length > m_Data->size())
+            {
+                m_bValid = false;
+                m_Offset = m_Data->size();
+                return {};
+            }
+            std::string value(m_Data->data() + m_Offset, length);
+            m_Offset += length;
+            return value;
+        }
+
+        /**
+         * \brief Skips the fields of a record whose type was just read. Returns false for an unknown type.
+         */
+        bool Skip(const RecordType Type)
+        {
+            switch (Type)
+            {
+            case RecordType::NAME:
+                Read<uint32_t>();
+                ReadString();
+                return m_bValid;
+            case RecordType::THREAD:
+                Read<uint16_t>();
+                ReadString();
+                return m_bValid;
+            case RecordType::FRAME:
+                return Advance(3 * sizeof(uint64_t) + sizeof(double));
+            case RecordType::CPU_EVENT:
+                return Advance(2 * sizeof(uint64_t) + sizeof(uint32_t) + 2 * sizeof(uint16_t));
+            case RecordType::GPU_TASK:
+                return Advance(sizeof(uint64_t) + 2 * sizeof(double) + sizeof(uint32_t));
+            case RecordType::COUNTER:
+                return Advance(sizeof(uint64_t) + sizeof(uint32_t) + sizeof(double));
+            }
+            m_bValid = false;
+            return false;
+        }
+
+        [[nodiscard]] bool IsValid() const { return m_bValid; }
+
+    private:
+        bool Advance(const size_t Bytes)
+        {
+            if (m_Offset + Bytes > m_Data->size())
+                m_bValid = false;
+            m_Offset = std::min(m_Offset + Bytes, m_Data->size());
+            return m_bValid;
+        }
+
+        const std::vector<char>* m_Data;
+        size_t m_Offset;
+        bool m_bValid{true};
+    };
+
+    /**
+     * \brief Appends the record type and its fields, packed, with a single resize of the frame buffer
+     */
+    template <typename... Ts>
+    static void WriteRecord(std::vector<char>& Buffer, const RecordType Type, const Ts... Fields)
+    {
+        const size_t offset = Buffer.size();
+        Buffer.resize(offset + sizeof(Type) + (sizeof(Ts) + ...));
+        char* out = Buffer.data() + offset;
+        memcpy(out, &Type, sizeof(Type));
+        out += sizeof(Type);
+        ((memcpy(out, &Fields, sizeof(Fields)), out += sizeof(Fields)), ...);
+    }
+
+    static void WriteString(std::vector<char>& Buffer, const char* Value)
+    {
+        const uint16_t length = static_cast<uint16_t>(std::min<size_t>(strlen(Value), UINT16_MAX));
+        const char* lengthBytes = reinterpret_cast<const char*>(&length);
+        Buffer.insert(Buffer.end(), lengthBytes, lengthBytes + sizeof(length));
+        Buffer.insert(Buffer.end(), Value, Value + length);
+    }
+
+    void WriteNameOnce(const uint32_t NameId)
+    {
+        if (NameId >= m_bNameWritten.size() || m_bNameWritten[NameId])
+            return;
+        m_bNameWritten[NameId] = true;
+        EncodeName(*m_Current, NameId);
+    }
+
+    std::vector<char>* TakeFreeBuffer()
+    {
+        std::lock_guard lock(m_Mutex);
+        if (m_FreeBuffers.empty())
+            return nullptr;
+        std::vector<char>* buffer = m_FreeBuffers.back();
+        m_FreeBuffers.pop_back();
+        return buffer;
+    }
+
+    void WriterMain()
+    {
+        std::unique_lock lock(m_Mutex);
+        while (true)
+        {
+            m_Cond.wait(lock, [this]() { return m_bStopRequested || m_PendingCount > 0; });
+            if (m_PendingCount == 0)
+                break;
+
+            std::vector<char>* buffer = m_PendingBuffers[m_PendingBegin];
+            m_PendingBegin = (m_PendingBegin + 1) % BUFFER_COUNT;
+            m_PendingCount--;
+            lock.unlock();
+
+            if (fwrite(buffer->data(), 1, buffer->size(), m_File) != buffer->size())
+                std::cout << "Failed to write capture file " << m_Path << std::endl;
+            m_WrittenBytes.fetch_add(buffer->size(), std::memory_order_relaxed);
+            buffer->clear();
+
+            lock.lock();
+            m_FreeBuffers.push_back(buffer);
+        }
+    }
+
+    static bool ReadWholeFile(const char* Path, std::vector<char>& Data)
+    {
+        FILE* file = fopen(Path, "rb");
+        if (!file)
+        {
+            std::cout << "Failed to open file " << Path << std::endl;
+            return false;
+        }
+        fseek(file, 0, SEEK_END);
+        const long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        Data.resize(size > 0 ? static_cast<size_t>(size) : 0);
+        const bool bRead = fread(Data.data(), 1, Data.size(), file) == Data.size();
+        fclose(file);
+        if (!bRead)
+            std::cout << "Failed to read file " << Path << std::endl;
+        return bRead;
+    }
+
+    static void WriteJsonString(FILE* Out, const char* Value)
+    {
+        fputc('"', Out);
+        for (const char* c = Value; *c; c++)
+        {
+            if (*c == '"' || *c == '\\')
+                fputc('\\', Out);
+            if (static_cast<unsigned char>(*c) < 0x20)
+                fprintf(Out, "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(*c)));
+            else
+                fputc(*c, Out);
+        }
+        fputc('"', Out);
+    }
+
+    FILE* m_File{nullptr};
+    std::string m_Path;
+    std::thread m_Writer;
+
+    std::mutex m_Mutex;
+    std::condition_variable m_Cond;
+    bool m_bStopRequested{false};
+    std::vector<char> m_Buffers[BUFFER_COUNT];
+    std::vector<std::vector<char>*> m_FreeBuffers;
+    std::vector<char>* m_PendingBuffers[BUFFER_COUNT]{};
+    size_t m_PendingBegin{0};
+    size_t m_PendingCount{0};
+
+    std::vector<char>* m_Current{nullptr};
+    std::vector<bool> m_bNameWritten;
+    uint32_t m_ThreadsWritten{0};
+    uint64_t m_FrameIndex{0};
+    uint64_t m_DroppedFrames{0};
+    std::atomic<uint64_t> m_WrittenBytes{0};
+};
+
+/**
+ * \brief Keeps the last few frames of profiler data encoded in memory so they can be written out after the fact, e.g.
+ * when a hitch is detected. Snapshots are regular capture files (see ProfilerCapture::ExportChromeTrace()).
+ */
+class ProfilerFrameHistory
+{
+public:
+    explicit ProfilerFrameHistory(const size_t FrameCount = 300) : m_Frames(FrameCount) {}
+
+    ~ProfilerFrameHistory()
+    {
+        // the snapshot job writes from m_Snapshot
+        while (m_bWriting.load(std::memory_order_acquire))
+            std::this_thread::yield();
+    }
+
+    ProfilerFrameHistory(const ProfilerFrameHistory&) = delete;
+    ProfilerFrameHistory& operator=(const ProfilerFrameHistory&) = delete;
+
+    /**
+     * \brief Encodes the frame CpuProfiler just drained into the oldest slot. Same arguments as ProfilerCapture::SubmitFrame().
+     */
+    void RecordFrame(const legit::ProfilerTask* GpuTasks, const size_t GpuTaskCount, const ProfilerCapture::Counter* Counters,
+                     const size_t CounterCount)
+    {
+        std::vector<char>& frame = m_Frames[m_FrameIndex % m_Frames.size()];
+        frame.clear();
+        ProfilerCapture::EncodeFrame(frame, m_FrameIndex, GpuTasks, GpuTaskCount, Counters, CounterCount);
+        m_FrameIndex++;
+    }
+
+    /**
+     * \brief Writes the recorded frames to Path on a worker thread. Returns false if the previous snapshot is still
+     * being written.
+     */
+    bool WriteSnapshot(JobSystem& Jobs, const char* Path)
+    {
+        if (m_bWriting.load(std::memory_order_acquire))
+            return false;
+
+        m_Snapshot.clear();
+        ProfilerCapture::EncodeHeader(m_Snapshot);
+        const uint32_t threadCount = CpuProfiler::GetThreadCount();
+        for (uint32_t i = 0; i < threadCount; i++)
+            ProfilerCapture::EncodeThread(m_Snapshot, i);
+        const uint32_t nameCount = legit::TaskNames::GetCount();
+        for (uint32_t i = 1; i < nameCount; i++)
+            ProfilerCapture::EncodeName(m_Snapshot, i);
+
+        const uint64_t frameCount = std::min<uint64_t>(m_FrameIndex, m_Frames.size());
+        for (uint64_t frameIndex = m_FrameIndex - frameCount; frameIndex < m_FrameIndex; frameIndex++)
+        {
+            const std::vector<char>& frame = m_Frames[frameIndex % m_Frames.size()];
+            m_Snapshot.insert(m_Snapshot.end(), frame.begin(), frame.end());
+        }
+
+        snprintf(m_SnapshotPath, sizeof(m_SnapshotPath), "%s", Path);
+        m_bWriting.store(true, std::memory_order_release);
+        Jobs.Run(
+            [this]()
+            {
+                FILE* file = fopen(m_SnapshotPath, "wb");
+                if (!file || fwrite(m_Snapshot.data(), 1, m_Snapshot.size(), file) != m_Snapshot.size())
+                    std::cout << "Failed to write profiler snapshot " << m_SnapshotPath << std::endl;
+                if (file)
+                    fclose(file);
+                m_bWriting.store(false, std::memory_order_release);
+            });
+        return true;
+    }
+
+    [[nodiscard]] bool IsWriting() const { return m_bWriting.load(std::memory_order_acquire); }
+
+private:
+    std::vector<std::vector<char>> m_Frames;
+    uint64_t m_FrameIndex{0};
+
+    std::vector<char> m_Snapshot;
+    char m_SnapshotPath[256]{};
+    std::atomic<bool> m_bWriting{false};
+};
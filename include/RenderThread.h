@@ -0,0 +1,524 @@
+#pragma once
+
+#include "Allocators.h"
+#include "CpuProfiler.h"
+#include "DrawDataSnapshot.h"
+
+#include "GLFW/glfw3.h"
+
+#include "glm/glm.hpp"
+
+#include "imgui.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \brief A single scene draw: the mesh is implied by the renderer, only the per-object state is recorded
+ */
+struct DrawPacket
+{
+    glm::mat4 Model;
+    // 0 is the scene texture, 1..N the textures from SceneRenderer::CreateGeneratedTextures()
+    uint32_t TextureIndex{0};
+};
+
+/**
+ * \brief ImGui output for a secondary platform window (multi-viewport)
+ */
+struct ViewportPacket
+{
+    GLFWwindow* Window{nullptr};
+    bool bClear{true};
+    DrawDataSnapshot DrawData;
+};
+
+/**
+ * \brief Font atlas texels changed on the main thread, re-uploaded before the frame's UI is rendered
+ */
+struct TextureRegionUpdate
+{
+    int X{0};
+    int Y{0};
+    int Width{0};
+    int Height{0};
+    // Width * Height RGBA32 texels in the frame arena
+    const void* Pixels{nullptr};
+};
+
+/**
+ * \brief Everything the render thread needs to submit one frame. Built on the main thread, consumed on the render thread.
+ * Arena holds transient data of this frame only; it is rewound when the slot is reused, once the render thread is done
+ * with it, so each in-flight frame has its own arena.
+ */
+struct FrameCommandList
+{
+    uint64_t FrameIndex{0};
+    int FramebufferWidth{0};
+    int FramebufferHeight{0};
+    glm::vec4 ClearColor{0.2f, 0.3f, 0.3f, 1.0f};
+    glm::mat4 View{1.0f};
+    glm::mat4 Projection{1.0f};
+    LinearArena Arena;
+    std::pmr::vector<DrawPacket> Packets{&Arena};
+    std::pmr::vector<TextureRegionUpdate> FontAtlasUpdates{&Arena};
+    DrawDataSnapshot MainDrawData;
+    std::vector<ViewportPacket> Viewports;
+    uint32_t ViewportCount{0};
+
+    void Reset()
+    {
+        // drop the old packet storage before rewinding the arena, then size it for a frame like the last one
+        const size_t lastPacketCount = Packets.size();
+        Packets = std::pmr::vector<DrawPacket>(&Arena);
+        FontAtlasUpdates = std::pmr::vector<TextureRegionUpdate>(&Arena);
+        Arena.Reset();
+        Packets.reserve(lastPacketCount);
+        ViewportCount = 0;
+    }
+
+    ViewportPacket& AddViewport()
+    {
+        if (ViewportCount == Viewports.size())
+            Viewports.emplace_back();
+        return Viewports[ViewportCount++];
+    }
+};
+
+/**
+ * \brief Main/render thread activity of one frame, in seconds on the steady clock
+ */
+struct FrameTiming
+{
+    uint64_t FrameIndex{0};
+    double BuildBegin{0.0};
+    double BuildEnd{0.0};
+    double SubmitBegin{0.0};
+    double SubmitEnd{0.0};
+};
+
+/**
+ * \brief Owns the GL context of a window and submits frames on a dedicated thread.
+ *
+ * The main thread fills a FrameCommandList between BeginFrame() and SubmitFrame() while the render thread is still
+ * executing earlier frames. MaxFramesInFlight bounds how many submitted frames may be pending when the main thread starts
+ * building the next one: 0 serializes both threads, 1 is classic double buffering, 2 triple buffering.
+ */
+class RenderThread
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using InitFunction = std::function<void()>;
+    using ExecuteFunction = std::function<void(FrameCommandList&)>;
+    using ShutdownFunction = std::function<void()>;
+
+    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 2;
+    static constexpr uint32_t SLOT_COUNT = MAX_FRAMES_IN_FLIGHT + 1;
+    static constexpr uint32_t TIMING_HISTORY = 240;
+
+    explicit RenderThread(GLFWwindow* ContextWindow, const uint32_t MaxFramesInFlight = 1)
+        : m_ContextWindow(ContextWindow)
+    {
+        SetMaxFramesInFlight(MaxFramesInFlight);
+    }
+
+    ~RenderThread()
+    {
+        Stop();
+    }
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+    RenderThread(RenderThread&&) = delete;
+    RenderThread& operator=(RenderThread&&) = delete;
+
+    /**
+     * \brief Hands the window's GL context to a new thread and runs Init there. Blocks until Init has returned.
+     */
+    void Start(InitFunction Init, ExecuteFunction Execute, ShutdownFunction Shutdown)
+    {
+        m_Execute = std::move(Execute);
+        m_Shutdown = std::move(Shutdown);
+        m_bStopRequested = false;
+
+        // a context can only be current on one thread at a time
+        glfwMakeContextCurrent(nullptr);
+
+        bool bInitialized = false;
+        m_Thread = std::thread([this, &Init, &bInitialized]()
+        {
+            glfwMakeContextCurrent(m_ContextWindow);
+            Init();
+            {
+                std::lock_guard lock(m_Mutex);
+                bInitialized = true;
+            }
+            m_Cond.notify_all();
+            ThreadMain();
+        });
+
+        std::unique_lock lock(m_Mutex);
+        m_Cond.wait(lock, [&bInitialized] { return bInitialized; });
+    }
+
+    /**
+     * \brief Finishes every submitted frame, runs Shutdown on the render thread and joins it
+     */
+    void Stop()
+    {
+        if (!m_Thread.joinable())
+            return;
+
+        {
+            std::lock_guard lock(m_Mutex);
+            m_bStopRequested = true;
+        }
+        m_Cond.notify_all();
+        m_Thread.join();
+    }
+
+    /**
+     * \brief Returns the next free command list, waiting for the render thread if the frames-in-flight limit is reached
+     */
+    FrameCommandList& BeginFrame()
+    {
+        PROFILE_SCOPE("Wait for render thread");
+        const double waitBegin = Now();
+        std::unique_lock lock(m_Mutex);
+        m_Cond.wait(lock, [this] { return m_SubmittedCount - m_CompletedCount <= m_MaxFramesInFlight.load(); });
+        m_LastBeginWait = Now() - waitBegin;
+
+        FrameCommandList& frame = m_Slots[m_SubmittedCount % SLOT_COUNT];
+        frame.Reset();
+        frame.FrameIndex = m_SubmittedCount;
+
+        FrameTiming& timing = m_Timings[m_SubmittedCount % TIMING_HISTORY];
+        timing = FrameTiming();
+        timing.FrameIndex = m_SubmittedCount;
+        timing.BuildBegin = Now();
+        return frame;
+    }
+
+    void SubmitFrame()
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_Timings[m_SubmittedCount % TIMING_HISTORY].BuildEnd = Now();
+            m_SubmittedCount++;
+        }
+        m_Cond.notify_all();
+    }
+
+    /**
+     * \brief Blocks until the render thread has executed every submitted frame
+     */
+    void WaitIdle()
+    {
+        std::unique_lock lock(m_Mutex);
+        m_Cond.wait(lock, [this] { return m_CompletedCount == m_SubmittedCount; });
+    }
+
+    /**
+     * \brief Runs Function on the calling thread while the render thread is idle and has released its context.
+     * Used for operations that must not overlap with rendering, e.g. creating or destroying platform windows.
+     */
+    void RunExclusive(const std::function<void()>& Function)
+    {
+        if (!m_Thread.joinable() || std::this_thread::get_id() == m_Thread.get_id())
+        {
+            Function();
+            return;
+        }
+
+        std::unique_lock lock(m_Mutex);
+        m_Cond.wait(lock, [this] { return m_CompletedCount == m_SubmittedCount; });
+        m_bExclusiveRequested = true;
+        m_Cond.notify_all();
+        m_Cond.wait(lock, [this] { return m_bContextReleased; });
+
+        lock.unlock();
+        Function();
+        lock.lock();
+
+        m_bExclusiveRequested = false;
+        m_Cond.notify_all();
+        m_Cond.wait(lock, [this] { return !m_bContextReleased; });
+    }
+
+    /**
+     * \brief Work the render thread runs between frames whenever NotifyBackgroundWork() is called, e.g. draining GL jobs
+     */
+    void SetBackgroundWork(std::function<void()> Work)
+    {
+        std::lock_guard lock(m_Mutex);
+        m_BackgroundWork = std::move(Work);
+    }
+
+    void NotifyBackgroundWork()
+    {
+        {
+            std::lock_guard lock(m_Mutex);
+            m_bBackgroundWorkPending = true;
+        }
+        m_Cond.notify_all();
+    }
+
+    void SetMaxFramesInFlight(const uint32_t MaxFramesInFlight)
+    {
+        m_MaxFramesInFlight = std::min(MaxFramesInFlight, MAX_FRAMES_IN_FLIGHT);
+        m_Cond.notify_all();
+    }
+
+    [[nodiscard]] uint32_t GetMaxFramesInFlight() const { return m_MaxFramesInFlight; }
+
+    /**
+     * \brief Time the main thread spent blocked in the last BeginFrame() call, in seconds
+     */
+    [[nodiscard]] double GetLastBeginWait() const { return m_LastBeginWait; }
+
+    /**
+     * \brief Copies the timings of completed frames, oldest first
+     */
+    void GetCompletedTimings(std::vector<FrameTiming>& OutTimings) const
+    {
+        std::lock_guard lock(m_Mutex);
+        OutTimings.clear();
+        const uint64_t first = m_CompletedCount > TIMING_HISTORY ? m_CompletedCount - TIMING_HISTORY : 0;
+        for (uint64_t frameIndex = first; frameIndex < m_CompletedCount; frameIndex++)
+        {
+            OutTimings.push_back(m_Timings[frameIndex % TIMING_HISTORY]);
+        }
+    }
+
+    static double Now()
+    {
+        return std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * \brief Draws the main/render thread timeline of the last completed frames
+     */
+    void RenderOverlay()
+    {
+        ImGui::Begin("Render Thread");
+
+        int framesInFlight = static_cast<int>(GetMaxFramesInFlight());
+        if (ImGui::SliderInt("Frames in flight", &framesInFlight, 0, MAX_FRAMES_IN_FLIGHT))
+        {
+            SetMaxFramesInFlight(static_cast<uint32_t>(framesInFlight));
+        }
+
+        GetCompletedTimings(m_OverlayTimings);
+        if (m_OverlayTimings.size() < 2)
+        {
+            ImGui::End();
+            return;
+        }
+
+        // overlap: time the main thread spent building frame N+1 while frame N was being submitted
+        double buildTime = 0.0, submitTime = 0.0, overlapTime = 0.0;
+        for (size_t i = 0; i < m_OverlayTimings.size(); i++)
+        {
+            const FrameTiming& timing = m_OverlayTimings[i];
+            buildTime += timing.BuildEnd - timing.BuildBegin;
+            submitTime += timing.SubmitEnd - timing.SubmitBegin;
+            for (size_t j = i + 1; j < m_OverlayTimings.size() && j <= i + MAX_FRAMES_IN_FLIGHT + 1; j++)
+            {
+                const FrameTiming& next = m_OverlayTimings[j];
+                overlapTime += std::max(0.0, std::min(timing.SubmitEnd, next.BuildEnd) - std::max(timing.SubmitBegin, next.BuildBegin));
+            }
+        }
+        const double frameCount = static_cast<double>(m_OverlayTimings.size());
+        ImGui::Text("Main build %.3f ms, render submit %.3f ms, overlap %.3f ms (%.0f%%)",
+                    buildTime / frameCount * 1000.0, submitTime / frameCount * 1000.0, overlapTime / frameCount * 1000.0,
+                    submitTime > 0.0 ? overlapTime / submitTime * 100.0 : 0.0);
+        ImGui::Text("Main thread blocked %.3f ms waiting for a free frame", GetLastBeginWait() * 1000.0);
+
+        // timeline of the most recent frames: main thread lane on top, render thread lane below
+        const double timeEnd = m_OverlayTimings.back().SubmitEnd;
+        const double timeSpan = 0.1;
+        const double timeBegin = timeEnd - timeSpan;
+        const float laneHeight = 18.0f;
+        const ImVec2 size(ImGui::GetContentRegionAvail().x, laneHeight * 2.0f + 4.0f);
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        drawList->AddRectFilled(origin, ImVec2(origin.x + size.x, origin.y + size.y), IM_COL32(20, 20, 24, 255));
+
+        const auto toX = [&](const double Time)
+        {
+            return origin.x + static_cast<float>((Time - timeBegin) / timeSpan) * size.x;
+        };
+        for (const FrameTiming& timing : m_OverlayTimings)
+        {
+            if (timing.SubmitEnd < timeBegin)
+                continue;
+            const ImU32 color = (timing.FrameIndex & 1) ? IM_COL32(52, 152, 219, 255) : IM_COL32(46, 204, 113, 255);
+            drawList->AddRectFilled(ImVec2(std::max(toX(timing.BuildBegin), origin.x), origin.y + 1.0f),
+                                    ImVec2(toX(timing.BuildEnd), origin.y + laneHeight), color);
+            drawList->AddRectFilled(ImVec2(std::max(toX(timing.SubmitBegin), origin.x), origin.y + laneHeight + 3.0f),
+                                    ImVec2(toX(timing.SubmitEnd), origin.y + laneHeight * 2.0f + 3.0f), color);
+        }
+        ImGui::Dummy(size);
+        ImGui::TextDisabled("top: main thread build, bottom: render thread submit (last %.0f ms)", timeSpan * 1000.0);
+
+        ImGui::End();
+    }
+
+private:
+    void ThreadMain()
+    {
+        uint64_t frameIndex = 0;
+        while (true)
+        {
+            {
+                std::unique_lock lock(m_Mutex);
+                m_Cond.wait(lock, [this, frameIndex]
+                {
+                    return frameIndex < m_SubmittedCount || m_bStopRequested || m_bExclusiveRequested || m_bBackgroundWorkPending;
+                });
+
+                if (m_bExclusiveRequested)
+                {
+                    glfwMakeContextCurrent(nullptr);
+                    m_bContextReleased = true;
+                    m_Cond.notify_all();
+                    m_Cond.wait(lock, [this] { return !m_bExclusiveRequested; });
+                    glfwMakeContextCurrent(m_ContextWindow);
+                    m_bContextReleased = false;
+                    m_Cond.notify_all();
+                    continue;
+                }
+
+                if (m_bBackgroundWorkPending)
+                {
+                    m_bBackgroundWorkPending = false;
+                    if (m_BackgroundWork)
+                    {
+                        lock.unlock();
+                        m_BackgroundWork();
+                    }
+                    continue;
+                }
+
+                if (frameIndex == m_SubmittedCount && m_bStopRequested)
+                    break;
+
+                m_Timings[frameIndex % TIMING_HISTORY].SubmitBegin = Now();
+            }
+
+            m_Execute(m_Slots[frameIndex % SLOT_COUNT]);
+
+            {
+                std::lock_guard lock(m_Mutex);
+                m_Timings[frameIndex % TIMING_HISTORY].SubmitEnd = Now();
+                m_CompletedCount = ++frameIndex;
+            }
+            m_Cond.notify_all();
+        }
+
+        if (m_BackgroundWork)
+            m_BackgroundWork();
+        if (m_Shutdown)
+            m_Shutdown();
+        glfwMakeContextCurrent(nullptr);
+    }
+
+    GLFWwindow* m_ContextWindow;
+    std::thread m_Thread;
+    mutable std::mutex m_Mutex;
+    std::condition_variable m_Cond;
+
+    ExecuteFunction m_Execute;
+    ShutdownFunction m_Shutdown;
+    std::function<void()> m_BackgroundWork;
+
+    std::array<FrameCommandList, SLOT_COUNT> m_Slots;
+    std::array<FrameTiming, TIMING_HISTORY> m_Timings;
+    std::vector<FrameTiming> m_OverlayTimings;
+
+    uint64_t m_SubmittedCount{0};
+    uint64_t m_CompletedCount{0};
+    std::atomic<uint32_t> m_MaxFramesInFlight{1};
+    double m_LastBeginWait{0.0};
+    bool m_bStopRequested{false};
+    bool m_bExclusiveRequested{false};
+    bool m_bContextReleased{false};
+    bool m_bBackgroundWorkPending{false};
+};
+
+/**
+ * \brief Routes ImGui platform window creation/destruction through RenderThread::RunExclusive, so that secondary
+ * viewport windows are never created or destroyed while the render thread may be drawing to them
+ */
+class RenderThreadViewportHooks
+{
+public:
+    static void Install(RenderThread& Thread)
+    {
+        ImGuiPlatformIO& platformIO = ImGui::GetPlatformIO();
+        s_Thread = &Thread;
+        s_CreateWindow = platformIO.Platform_CreateWindow;
+        s_DestroyWindow = platformIO.Platform_DestroyWindow;
+        platformIO.Platform_CreateWindow = OnCreateWindow;
+        platformIO.Platform_DestroyWindow = OnDestroyWindow;
+    }
+
+    static void Remove()
+    {
+        if (!s_Thread)
+            return;
+
+        ImGuiPlatformIO& platformIO = ImGui::GetPlatformIO();
+        platformIO.Platform_CreateWindow = s_CreateWindow;
+        platformIO.Platform_DestroyWindow = s_DestroyWindow;
+        s_Thread = nullptr;
+    }
+
+    /**
+     * \brief Snapshots the draw data of every visible secondary viewport into the frame (call after UpdatePlatformWindows)
+     */
+    static void CaptureViewports(FrameCommandList& Frame)
+    {
+        ImGuiPlatformIO& platformIO = ImGui::GetPlatformIO();
+        for (int i = 1; i < platformIO.Viewports.Size; i++) // skip the main viewport
+        {
+            ImGuiViewport* viewport = platformIO.Viewports[i];
+            if ((viewport->Flags & ImGuiViewportFlags_IsMinimized) || !viewport->PlatformHandle)
+                continue;
+
+            ViewportPacket& packet = Frame.AddViewport();
+            packet.Window = static_cast<GLFWwindow*>(viewport->PlatformHandle);
+            packet.bClear = !(viewport->Flags & ImGuiViewportFlags_NoRendererClear);
+            packet.DrawData.Capture(viewport->DrawData);
+        }
+    }
+
+private:
+    static void OnCreateWindow(ImGuiViewport* Viewport)
+    {
+        s_Thread->RunExclusive([Viewport]()
+        {
+            s_CreateWindow(Viewport);
+            // the GLFW backend makes the new context current; it must stay free for the render thread
+            glfwMakeContextCurrent(nullptr);
+        });
+    }
+
+    static void OnDestroyWindow(ImGuiViewport* Viewport)
+    {
+        s_Thread->RunExclusive([Viewport]() { s_DestroyWindow(Viewport); });
+    }
+
+    inline static RenderThread* s_Thread{nullptr};
+    inline static void (*s_CreateWindow)(ImGuiViewport*){nullptr};
+    inline static void (*s_DestroyWindow)(ImGuiViewport*){nullptr};
+};
@@ -0,0 +1,450 @@
+#pragma once
+
+#include "CpuProfiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#define SAMPLING_PROFILER_SUPPORTED 1
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <ucontext.h>
+#include <unistd.h>
+// glibc before 2.41 only names the thread of SIGEV_THREAD_ID through the union member
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#else
+#define SAMPLING_PROFILER_SUPPORTED 0
+#endif
+
+/**
+ * \brief Statistical CPU profiler: every registered thread owns a CPU-time timer that raises SIGPROF on that very thread
+ * at 1-10 kHz, and the handler walks its frame pointers into a lock-free ring. (A single process CPU-time timer would not
+ * do: before Linux 6.4 its signal goes to the main thread whenever that thread does not block it, whichever thread spent
+ * the time.) The main thread drains the ring once per frame into a
+ * call tree; functions are resolved (dladdr) once per distinct return address and named only when displayed.
+ *
+ * Only threads that called RegisterThread() are sampled, and only within their own stack, so code built without frame
+ * pointers yields short stacks rather than faults. Linux on x86-64 and AArch64 only.
+ */
+class SamplingProfiler
+{
+public:
+    static constexpr uint32_t MAX_DEPTH = 64;
+    static constexpr uint32_t RING_CAPACITY = 4096;
+    static constexpr uint32_t MIN_RATE = 1000;
+    static constexpr uint32_t MAX_RATE = 10000;
+    // node 0 is the root; its children are the sampled threads
+    static constexpr uint32_t ROOT = 0;
+    static constexpr uint32_t INVALID_NODE = UINT32_MAX;
+
+    /**
+     * \brief Call tree node. Function is the resolved function start address (or the raw address if unresolved);
+     * for the children of the root it is the profiler thread index instead.
+     */
+    struct Node
+    {
+        uintptr_t Function{0};
+        uint32_t Parent{INVALID_NODE};
+        uint32_t FirstChild{INVALID_NODE};
+        uint32_t NextSibling{INVALID_NODE};
+        uint32_t Depth{0};
+        uint64_t Samples{0};
+        uint64_t SelfSamples{0};
+    };
+
+    [[nodiscard]] static constexpr bool IsSupported() { return SAMPLING_PROFILER_SUPPORTED != 0; }
+
+    /**
+     * \brief Makes the calling thread's stack walkable and gives it a sampling timer, armed right away if sampling is
+     * enabled. Call once at the start of every thread worth sampling; the timer is deleted when the thread exits.
+     */
+    static void RegisterThread()
+    {
+#if SAMPLING_PROFILER_SUPPORTED
+        pthread_attr_t attributes;
+        if (pthread_getattr_np(pthread_self(), &attributes) != 0)
+            return;
+        void* stackAddress = nullptr;
+        size_t stackSize = 0;
+        if (pthread_attr_getstack(&attributes, &stackAddress, &stackSize) == 0)
+        {
+            s_StackHigh = reinterpret_cast<uintptr_t>(stackAddress) + stackSize;
+            s_ThreadIndex = static_cast<uint16_t>(CpuProfiler::GetCurrentThreadIndex());
+        }
+        pthread_attr_destroy(&attributes);
+
+        ThreadTimer& timer = s_ThreadTimer;
+        if (timer.bCreated)
+            return;
+        sigevent event;
+        memset(&event, 0, sizeof(event));
+        event.sigev_notify = SIGEV_THREAD_ID;
+        event.sigev_signo = SIGPROF;
+        event.sigev_notify_thread_id = gettid();
+        if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &timer.Timer) != 0)
+        {
+            s_TimerFailures.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        timer.bCreated = true;
+
+        std::lock_guard lock(s_TimersMutex);
+        s_Timers.push_back(&timer);
+        if (s_bEnabled)
+            timer_settime(timer.Timer, 0, &s_Interval, nullptr);
+#endif
+    }
+
+    /**
+     * \brief Starts or stops sampling at Rate samples per second of each registered thread's CPU time (clamped to
+     * MIN_RATE..MAX_RATE)
+     */
+    static bool SetEnabled(const bool bEnabled, const uint32_t Rate = 1000)
+    {
+#if SAMPLING_PROFILER_SUPPORTED
+        if (bEnabled && !s_bHandlerInstalled)
+        {
+            struct sigaction action;
+            memset(&action, 0, sizeof(action));
+            action.sa_sigaction = &SignalHandler;
+            action.sa_flags = SA_SIGINFO | SA_RESTART;
+            sigemptyset(&action.sa_mask);
+            if (sigaction(SIGPROF, &action, nullptr) != 0)
+            {
+                snprintf(s_Status, sizeof(s_Status), "Could not install the sampling signal handler: %s", strerror(errno));
+                return false;
+            }
+            s_bHandlerInstalled = true;
+        }
+
+        std::lock_guard lock(s_TimersMutex);
+        if (bEnabled && s_Timers.empty())
+        {
+            snprintf(s_Status, sizeof(s_Status), "No sampling timer: no thread called RegisterThread() (%u failed)",
+                     s_TimerFailures.load(std::memory_order_relaxed));
+            return false;
+        }
+
+        s_Rate = std::clamp(Rate, MIN_RATE, MAX_RATE);
+        memset(&s_Interval, 0, sizeof(s_Interval));
+        if (bEnabled)
+        {
+            s_Interval.it_interval.tv_nsec = static_cast<long>(1000000000u / s_Rate);
+            s_Interval.it_value = s_Interval.it_interval;
+        }
+        for (const ThreadTimer* timer : s_Timers)
+        {
+            if (timer_settime(timer->Timer, 0, &s_Interval, nullptr) != 0)
+            {
+                snprintf(s_Status, sizeof(s_Status), "Could not arm the sampling timer: %s", strerror(errno));
+                return false;
+            }
+        }
+        s_bEnabled = bEnabled;
+        if (const uint32_t failures = s_TimerFailures.load(std::memory_order_relaxed))
+            snprintf(s_Status, sizeof(s_Status), "%u thread(s) could not create a sampling timer and are not sampled", failures);
+        else
+            s_Status[0] = '\0';
+        return true;
+#else
+        (void)Rate;
+        snprintf(s_Status, sizeof(s_Status), "The sampling profiler needs Linux on x86-64 or AArch64");
+        return !bEnabled;
+#endif
+    }
+
+    [[nodiscard]] static bool IsEnabled() { return s_bEnabled; }
+    [[nodiscard]] static uint32_t GetRate() { return s_Rate; }
+    [[nodiscard]] static const char* GetStatus() { return s_Status; }
+
+    /**
+     * \brief Moves the samples taken since the last call into the call tree. Main thread only; call once per frame.
+     */
+    static void Update()
+    {
+        if (s_Nodes.empty())
+            s_Nodes.emplace_back();
+
+        Sample sample;
+        while (Dequeue(sample))
+        {
+            uint32_t node = FindOrAddChild(ROOT, sample.ThreadIndex);
+            s_Nodes[ROOT].Samples++;
+            s_Nodes[node].Samples++;
+            // outermost caller first; return addresses point after the call, so resolve the byte before them
+            for (uint32_t i = sample.Depth; i-- > 0;)
+            {
+                node = FindOrAddChild(node, ResolveFunction(i == 0 ? sample.Frames[i] : sample.Frames[i] - 1));
+                s_Nodes[node].Samples++;
+            }
+            s_Nodes[node].SelfSamples++;
+        }
+    }
+
+    static void Clear()
+    {
+        s_Nodes.clear();
+        s_Nodes.emplace_back();
+        s_Children.clear();
+    }
+
+    [[nodiscard]] static const std::vector<Node>& GetNodes() { return s_Nodes; }
+    [[nodiscard]] static uint64_t GetSampleCount() { return s_Nodes.empty() ? 0 : s_Nodes[ROOT].Samples; }
+    [[nodiscard]] static uint64_t GetDroppedSampleCount() { return s_DroppedSamples.load(std::memory_order_relaxed); }
+
+    /**
+     * \brief Display name of a node: the thread name for children of the root, otherwise the demangled symbol, or
+     * module+offset when the function is not exported
+     */
+    static const char* GetNodeName(const uint32_t NodeIndex)
+    {
+        const Node& node = s_Nodes[NodeIndex];
+        if (NodeIndex == ROOT)
+            return "All threads";
+        if (node.Parent == ROOT)
+            return node.Function < CpuProfiler::GetThreadCount() ? CpuProfiler::GetThreadName(static_cast<uint32_t>(node.Function))
+                                                                  : "Unregistered threads";
+
+        auto it = s_Symbols.find(node.Function);
+        if (it == s_Symbols.end())
+            it = s_Symbols.emplace(node.Function, Symbolize(node.Function)).first;
+        return it->second.c_str();
+    }
+
+private:
+    struct Sample
+    {
+        uint16_t ThreadIndex;
+        uint16_t Depth;
+        uintptr_t Frames[MAX_DEPTH];
+    };
+
+    /**
+     * \brief Ring slot. Its sequence number starts at the slot index (as in Vyukov's queue); it is stored minus the
+     * index so that the zero-initialized (static) ring is already valid.
+     */
+    struct Slot
+    {
+        std::atomic<uint64_t> StoredSequence;
+        Sample Data;
+    };
+
+#if SAMPLING_PROFILER_SUPPORTED
+    /**
+     * \brief Sampling timer of one registered thread, deleted with the thread. Only used thread_local, so it is
+     * zero-initialized (no member initializers: they would be needed before the end of SamplingProfiler).
+     */
+    struct ThreadTimer
+    {
+        timer_t Timer;
+        bool bCreated;
+
+        ~ThreadTimer()
+        {
+            if (!bCreated)
+                return;
+            std::lock_guard lock(s_TimersMutex);
+            s_Timers.erase(std::find(s_Timers.begin(), s_Timers.end(), this));
+            timer_delete(Timer);
+        }
+    };
+
+    static void SignalHandler(int, siginfo_t*, void* Context)
+    {
+        const int savedErrno = errno;
+        const ucontext_t* context = static_cast<const ucontext_t*>(Context);
+#if defined(__x86_64__)
+        const uintptr_t pc = static_cast<uintptr_t>(context->uc_mcontext.gregs[REG_RIP]);
+        uintptr_t fp = static_cast<uintptr_t>(context->uc_mcontext.gregs[REG_RBP]);
+        const uintptr_t sp = static_cast<uintptr_t>(context->uc_mcontext.gregs[REG_RSP]);
+#else
+        const uintptr_t pc = static_cast<uintptr_t>(context->uc_mcontext.pc);
+        uintptr_t fp = static_cast<uintptr_t>(context->uc_mcontext.regs[29]);
+        const uintptr_t sp = static_cast<uintptr_t>(context->uc_mcontext.sp);
+#endif
+        // a frame record is {previous frame pointer, return address} on both architectures
+        uintptr_t frames[MAX_DEPTH];
+        uint32_t depth = 0;
+        frames[depth++] = pc;
+        const uintptr_t stackHigh = s_StackHigh;
+        while (depth < MAX_DEPTH && fp >= sp && fp + 2 * sizeof(uintptr_t) <= stackHigh && fp % sizeof(uintptr_t) == 0)
+        {
+            const uintptr_t* record = reinterpret_cast<const uintptr_t*>(fp);
+            const uintptr_t next = record[0];
+            const uintptr_t returnAddress = record[1];
+            if (returnAddress == 0)
+                break;
+            frames[depth++] = returnAddress;
+            if (next <= fp)
+                break;
+            fp = next;
+        }
+        Enqueue(s_ThreadIndex, frames, depth);
+        errno = savedErrno;
+    }
+#endif
+
+    /**
+     * \brief Bounded multi-producer queue (Vyukov): producers claim a slot by CAS on the enqueue position and publish
+     * it through the slot's sequence number. Lock-free, so it is safe in signal handlers on any thread.
+     */
+    static void Enqueue(const uint16_t ThreadIndex, const uintptr_t* Frames, const uint32_t Depth)
+    {
+        uint64_t position = s_EnqueuePosition.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            const uint64_t index = position % RING_CAPACITY;
+            Slot& slot = s_Slots[index];
+            const uint64_t sequence = slot.StoredSequence.load(std::memory_order_acquire) + index;
+            const int64_t difference = static_cast<int64_t>(sequence) - static_cast<int64_t>(position);
+            if (difference == 0)
+            {
+                if (s_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    slot.Data.ThreadIndex = ThreadIndex;
+                    slot.Data.Depth = static_cast<uint16_t>(Depth);
+                    memcpy(slot.Data.Frames, Frames, Depth * sizeof(uintptr_t));
+                    slot.StoredSequence.store(position + 1 - index, std::memory_order_release);
+                    return;
+                }
+            }
+            else if (difference < 0)
+            {
+                // full: the main thread has not drained for a while
+                s_DroppedSamples.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else
+            {
+                position = s_EnqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    static bool Dequeue(Sample& Out)
+    {
+        const uint64_t index = s_DequeuePosition % RING_CAPACITY;
+        Slot& slot = s_Slots[index];
+        if (slot.StoredSequence.load(std::memory_order_acquire) + index != s_DequeuePosition + 1)
+            return false;
+        Out.ThreadIndex = slot.Data.ThreadIndex;
+        Out.Depth = slot.Data.Depth;
+        memcpy(Out.Frames, slot.Data.Frames, Out.Depth * sizeof(uintptr_t));
+        slot.StoredSequence.store(s_DequeuePosition + RING_CAPACITY - index, std::memory_order_release);
+        s_DequeuePosition++;
+        return true;
+    }
+
+    static uint32_t FindOrAddChild(const uint32_t Parent, const uintptr_t Function)
+    {
+        // keyed by parent and function; parents are indices below 2^32 and addresses fit 48 bits in user space
+        const uint64_t key = static_cast<uint64_t>(Parent) * 0x9E3779B97F4A7C15ull ^ static_cast<uint64_t>(Function);
+        auto [it, bInserted] = s_Children.try_emplace(key, static_cast<uint32_t>(s_Nodes.size()));
+        if (!bInserted && s_Nodes[it->second].Parent == Parent && s_Nodes[it->second].Function == Function)
+            return it->second;
+        if (!bInserted)
+        {
+            // hash collision between two (parent, function) pairs: fall back to scanning the children
+            for (uint32_t child = s_Nodes[Parent].FirstChild; child != INVALID_NODE; child = s_Nodes[child].NextSibling)
+            {
+                if (s_Nodes[child].Function == Function)
+                    return child;
+            }
+        }
+
+        const uint32_t index = static_cast<uint32_t>(s_Nodes.size());
+        Node& node = s_Nodes.emplace_back();
+        node.Function = Function;
+        node.Parent = Parent;
+        node.Depth = s_Nodes[Parent].Depth + 1;
+        node.NextSibling = s_Nodes[Parent].FirstChild;
+        s_Nodes[Parent].FirstChild = index;
+        return index;
+    }
+
+    static uintptr_t ResolveFunction(const uintptr_t Address)
+    {
+        auto it = s_Functions.find(Address);
+        if (it != s_Functions.end())
+            return it->second;
+        uintptr_t function = Address;
+#if SAMPLING_PROFILER_SUPPORTED
+        Dl_info info;
+        if (dladdr(reinterpret_cast<void*>(Address), &info) && info.dli_saddr)
+            function = reinterpret_cast<uintptr_t>(info.dli_saddr);
+#endif
+        s_Functions.emplace(Address, function);
+        return function;
+    }
+
+    static std::string Symbolize(const uintptr_t Function)
+    {
+        char buffer[64];
+#if SAMPLING_PROFILER_SUPPORTED
+        Dl_info info;
+        if (dladdr(reinterpret_cast<void*>(Function), &info))
+        {
+            if (info.dli_sname)
+            {
+                int status = 0;
+                char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+                std::string name = status == 0 && demangled ? demangled : info.dli_sname;
+                free(demangled);
+                return name;
+            }
+            if (info.dli_fname)
+            {
+                const char* module = strrchr(info.dli_fname, '/');
+                snprintf(buffer, sizeof(buffer), "+0x%llx",
+                         static_cast<unsigned long long>(Function - reinterpret_cast<uintptr_t>(info.dli_fbase)));
+                return std::string(module ? module + 1 : info.dli_fname) + buffer;
+            }
+        }
+#endif
+        snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(Function));
+        return buffer;
+    }
+
+    // written by signal handlers
+    static inline std::array<Slot, RING_CAPACITY> s_Slots;
+    static inline std::atomic<uint64_t> s_EnqueuePosition{0};
+    static inline std::atomic<uint64_t> s_DroppedSamples{0};
+    static inline thread_local uintptr_t s_StackHigh{0};
+    static inline thread_local uint16_t s_ThreadIndex{static_cast<uint16_t>(CpuProfiler::MAX_THREADS)};
+
+    // main thread only
+    static inline uint64_t s_DequeuePosition{0};
+    static inline bool s_bHandlerInstalled{false};
+    static inline uint32_t s_Rate{1000};
+    static inline char s_Status[128]{};
+
+    // s_bEnabled, s_Interval and s_Timers are written under s_TimersMutex, since threads register at any time
+    static inline bool s_bEnabled{false};
+#if SAMPLING_PROFILER_SUPPORTED
+    static inline std::mutex s_TimersMutex;
+    static inline std::vector<ThreadTimer*> s_Timers;
+    static inline itimerspec s_Interval{};
+    static inline std::atomic<uint32_t> s_TimerFailures{0};
+    static inline thread_local ThreadTimer s_ThreadTimer;
+#endif
+    static inline std::vector<Node> s_Nodes;
+    static inline std::unordered_map<uint64_t, uint32_t> s_Children;
+    static inline std::unordered_map<uintptr_t, uintptr_t> s_Functions;
+    static inline std::unordered_map<uintptr_t, std::string> s_Symbols;
+};
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "SamplingProfiler.h"
+
+#include "imgui.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+/**
+ * \brief ImGui window for SamplingProfiler: sampling controls and the call tree as a flame graph (root at the bottom)
+ * or icicle graph (root at the top). Hover a frame for its sample counts, click to zoom into it.
+ */
+class SamplingProfilerPanel
+{
+public:
+    void Render()
+    {
+        ImGui::Begin("Sampling Profiler");
+
+        bool bEnabled = SamplingProfiler::IsEnabled();
+        if (ImGui::Checkbox("Sample", &bEnabled))
+            SamplingProfiler::SetEnabled(bEnabled, static_cast<uint32_t>(m_Rate));
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(200.0f);
+        if (ImGui::SliderInt("Rate (Hz)", &m_Rate, static_cast<int>(SamplingProfiler::MIN_RATE), static_cast<int>(SamplingProfiler::MAX_RATE))
+            && SamplingProfiler::IsEnabled())
+            SamplingProfiler::SetEnabled(true, static_cast<uint32_t>(m_Rate));
+        ImGui::SameLine();
+        ImGui::Checkbox("Icicle", &m_bIcicle);
+        ImGui::SameLine();
+        if (ImGui::Button("Clear"))
+        {
+            SamplingProfiler::Clear();
+            m_ZoomNode = SamplingProfiler::ROOT;
+        }
+        if (m_ZoomNode != SamplingProfiler::ROOT)
+        {
+            ImGui::SameLine();
+            if (ImGui::Button("Reset zoom"))
+                m_ZoomNode = SamplingProfiler::ROOT;
+        }
+
+        if (SamplingProfiler::GetStatus()[0])
+            ImGui::TextWrapped("%s", SamplingProfiler::GetStatus());
+        ImGui::Text("%llu samples (%llu dropped)", static_cast<unsigned long long>(SamplingProfiler::GetSampleCount()),
+                    static_cast<unsigned long long>(SamplingProfiler::GetDroppedSampleCount()));
+
+        const std::vector<SamplingProfiler::Node>& nodes = SamplingProfiler::GetNodes();
+        if (nodes.empty() || nodes[SamplingProfiler::ROOT].Samples == 0)
+        {
+            ImGui::End();
+            return;
+        }
+        if (m_ZoomNode >= nodes.size())
+            m_ZoomNode = SamplingProfiler::ROOT;
+
+        ImGui::BeginChild("Graph", ImVec2(0.0f, 0.0f), true, ImGuiWindowFlags_HorizontalScrollbar);
+        const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+        const ImVec2 origin = ImGui::GetCursorScreenPos();
+        const float width = ImGui::GetContentRegionAvail().x;
+        const uint32_t maxDepth = MeasureDepth(nodes, m_ZoomNode, 0);
+        const float height = std::max(ImGui::GetContentRegionAvail().y, rowHeight * static_cast<float>(maxDepth + 1));
+        ImGui::InvisibleButton("Canvas", ImVec2(width, height));
+
+        m_HoveredNode = SamplingProfiler::INVALID_NODE;
+        m_Layout = Layout{origin, width, height, rowHeight, nodes[m_ZoomNode].Samples, nodes[m_ZoomNode].Depth};
+        DrawNode(ImGui::GetWindowDrawList(), nodes, m_ZoomNode, origin.x);
+
+        if (m_HoveredNode != SamplingProfiler::INVALID_NODE)
+        {
+            const SamplingProfiler::Node& node = nodes[m_HoveredNode];
+            const double total = static_cast<double>(nodes[SamplingProfiler::ROOT].Samples);
+            ImGui::BeginTooltip();
+            ImGui::TextUnformatted(SamplingProfiler::GetNodeName(m_HoveredNode));
+            ImGui::Text("%llu samples (%.2f%%), %llu self (%.2f%%)", static_cast<unsigned long long>(node.Samples),
+                        100.0 * node.Samples / total, static_cast<unsigned long long>(node.SelfSamples), 100.0 * node.SelfSamples / total);
+            ImGui::EndTooltip();
+            if (ImGui::IsItemClicked(ImGuiMouseButton_Left))
+                m_ZoomNode = m_HoveredNode;
+        }
+        if (ImGui::IsItemClicked(ImGuiMouseButton_Right) && m_ZoomNode != SamplingProfiler::ROOT)
+            m_ZoomNode = nodes[m_ZoomNode].Parent;
+
+        ImGui::EndChild();
+        ImGui::End();
+    }
+
+private:
+    struct Layout
+    {
+        ImVec2 Origin;
+        float Width;
+        float Height;
+        float RowHeight;
+        uint64_t Samples;
+        uint32_t BaseDepth;
+    };
+
+    static uint32_t MeasureDepth(const std::vector<SamplingProfiler::Node>& Nodes, const uint32_t Node, const uint32_t Depth)
+    {
+        uint32_t deepest = Depth;
+        for (uint32_t child = Nodes[Node].FirstChild; child != SamplingProfiler::INVALID_NODE; child = Nodes[child].NextSibling)
+            deepest = std::max(deepest, MeasureDepth(Nodes, child, Depth + 1));
+        return deepest;
+    }
+
+    void DrawNode(ImDrawList* DrawList, const std::vector<SamplingProfiler::Node>& Nodes, const uint32_t Index, const float X)
+    {
+        const SamplingProfiler::Node& node = Nodes[Index];
+        const float nodeWidth = m_Layout.Width * static_cast<float>(node.Samples) / static_cast<float>(m_Layout.Samples);
+        // frames below a pixel would be invisible; their samples still count towards the parent's width
+        if (nodeWidth < 1.0f)
+            return;
+
+        const float row = static_cast<float>(node.Depth - m_Layout.BaseDepth);
+        const float y = m_bIcicle ? m_Layout.Origin.y + row * m_Layout.RowHeight
+                                  : m_Layout.Origin.y + m_Layout.Height - (row + 1.0f) * m_Layout.RowHeight;
+        const ImVec2 min(X, y);
+        const ImVec2 max(X + nodeWidth - 1.0f, y + m_Layout.RowHeight - 1.0f);
+
+        const char* name = SamplingProfiler::GetNodeName(Index);
+        DrawList->AddRectFilled(min, max, GetColor(Index, node));
+        if (nodeWidth > 30.0f)
+        {
+            const ImVec4 clip(min.x + 2.0f, min.y, max.x - 2.0f, max.y);
+            DrawList->AddText(nullptr, 0.0f, ImVec2(min.x + 3.0f, min.y + 2.0f), IM_COL32(20, 20, 20, 255), name, nullptr, 0.0f, &clip);
+        }
+        if (ImGui::IsMouseHoveringRect(min, max))
+            m_HoveredNode = Index;
+
+        float childX = X;
+        for (uint32_t child = node.FirstChild; child != SamplingProfiler::INVALID_NODE; child = Nodes[child].NextSibling)
+        {
+            DrawNode(DrawList, Nodes, child, childX);
+            childX += m_Layout.Width * static_cast<float>(Nodes[child].Samples) / static_cast<float>(m_Layout.Samples);
+        }
+    }
+
+    static ImU32 GetColor(const uint32_t Index, const SamplingProfiler::Node& Node)
+    {
+        if (Index == SamplingProfiler::ROOT || Node.Parent == SamplingProfiler::ROOT)
+            return IM_COL32(160, 160, 170, 255);
+        // warm palette seeded by the function, so a function keeps its color wherever it appears
+        const uint64_t hash = static_cast<uint64_t>(Node.Function) * 0x9E3779B97F4A7C15ull;
+        return IM_COL32(205 + (hash >> 59), 90 + ((hash >> 40) & 0x7F), 40 + ((hash >> 20) & 0x3F), 255);
+    }
+
+    int m_Rate{1000};
+    bool m_bIcicle{false};
+    uint32_t m_ZoomNode{SamplingProfiler::ROOT};
+    uint32_t m_HoveredNode{SamplingProfiler::INVALID_NODE};
+    Layout m_Layout{};
+};
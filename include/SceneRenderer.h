@@ -0,0 +1,115 @@
+#pragma once
+
+#include "AssetLoader.h"
+#include "AsyncTask.h"
+#include "JobSystem.h"
+#include "Mesh.h"
+#include "RenderThread.h"
+#include "Shader.h"
+#include "Texture.h"
+
+#include "glad/glad.h"
+
+#include <memory>
+#include <vector>
+
+/**
+ * \brief GL resources of the default scene. Created, used and destroyed on the render thread.
+ * Assets are streamed in by LoadAsync(); until they arrive frames only clear the screen.
+ */
+class SceneRenderer
+{
+public:
+    SceneRenderer()
+    {
+        glEnable(GL_DEPTH_TEST);
+    }
+
+    SceneRenderer(const SceneRenderer&) = delete;
+    SceneRenderer& operator=(const SceneRenderer&) = delete;
+    SceneRenderer(SceneRenderer&&) = delete;
+    SceneRenderer& operator=(SceneRenderer&&) = delete;
+
+    /**
+     * \brief Reads and decodes the scene assets on worker threads and creates the GL objects on the render thread
+     */
+    Task<void> LoadAsync(JobSystem& System, const CancellationToken* Token)
+    {
+        Task<std::unique_ptr<Shader>> shader = LoadShaderAsync(System, "data/shaders/default.vert", "data/shaders/default.frag", Token);
+        Task<std::unique_ptr<Texture>> texture = LoadTextureAsync(System, "data/textures/container.jpg", Token);
+        co_await WhenAll(shader, texture);
+
+        std::unique_ptr<Shader> loadedShader = shader.GetResult();
+        std::unique_ptr<Texture> loadedTexture = texture.GetResult();
+
+        co_await ResumeOnRenderThread(System, Token);
+        m_Mesh = std::make_unique<Mesh>();
+        m_Shader = std::move(loadedShader);
+        m_Texture = std::move(loadedTexture);
+
+        // tell opengl for each sampler to which texture unit it belongs to (only has to be done once)
+        m_Shader->Bind();
+        m_Shader->SetInt("texture1", 0);
+    }
+
+    /**
+     * \brief Creates Count procedural checkerboard textures, addressed by DrawPacket::TextureIndex 1..Count.
+     * Deterministic, so benchmark runs upload and sample identical data. Call on the render thread.
+     */
+    void CreateGeneratedTextures(const uint32_t Count, const int Size)
+    {
+        std::vector<unsigned char> pixels(static_cast<size_t>(Size) * Size * 3);
+        for (uint32_t texture = 0; texture < Count; texture++)
+        {
+            const int cell = 4 << (texture % 4);
+            for (int y = 0; y < Size; y++)
+            {
+                for (int x = 0; x < Size; x++)
+                {
+                    const bool bLight = ((x / cell) + (y / cell)) % 2 == 0;
+                    unsigned char* pixel = &pixels[(static_cast<size_t>(y) * Size + x) * 3];
+                    pixel[0] = static_cast<unsigned char>(bLight ? 255 : (texture * 53) % 256);
+                    pixel[1] = static_cast<unsigned char>(bLight ? 255 : (texture * 97) % 256);
+                    pixel[2] = static_cast<unsigned char>(bLight ? 255 : (texture * 151) % 256);
+                }
+            }
+            m_GeneratedTextures.push_back(std::make_unique<Texture>(pixels.data(), Size, Size, 3));
+        }
+    }
+
+    [[nodiscard]] bool IsLoaded() const { return m_Mesh && m_Shader && m_Texture; }
+
+    void Render(const FrameCommandList& Frame) const
+    {
+        glViewport(0, 0, Frame.FramebufferWidth, Frame.FramebufferHeight);
+        glClearColor(Frame.ClearColor.r, Frame.ClearColor.g, Frame.ClearColor.b, Frame.ClearColor.a);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        if (!IsLoaded())
+            return;
+
+        m_Shader->Bind();
+        m_Shader->SetMat4("projection", Frame.Projection);
+        m_Shader->SetMat4("view", Frame.View);
+
+        m_Mesh->Bind();
+        uint32_t boundTexture = UINT32_MAX;
+        for (const DrawPacket& packet : Frame.Packets)
+        {
+            // consecutive packets with the same texture share one bind
+            const uint32_t textureIndex = packet.TextureIndex <= m_GeneratedTextures.size() ? packet.TextureIndex : 0;
+            if (textureIndex != boundTexture)
+            {
+                (textureIndex == 0 ? *m_Texture : *m_GeneratedTextures[textureIndex - 1]).Bind(0);
+                boundTexture = textureIndex;
+            }
+            m_Mesh->Draw(*m_Shader, packet.Model);
+        }
+    }
+
+private:
+    std::unique_ptr<Shader> m_Shader;
+    std::unique_ptr<Mesh> m_Mesh;
+    std::unique_ptr<Texture> m_Texture;
+    std::vector<std::unique_ptr<Texture>> m_GeneratedTextures;
+};
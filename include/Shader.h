@@ -8,6 +8,15 @@
 #include <sstream>
 #include <iostream>
 
+/**
+ * \brief Vertex and fragment shader source code, e.g. read by an async loader before the program is compiled
+ */
+struct ShaderSource
+{
+    std::string Vertex;
+    std::string Fragment;
+};
+
 class Shader
 {
 public:
@@ -50,29 +59,15 @@ public:
             std::cout << "Failed to open or read fragment shader: " << e.what() << std::endl;
         }
 
-        const char* vShaderCode = vertexCode.c_str();
-        const char* fShaderCode = fragmentCode.c_str();
-
-        // Compile shaders
-        unsigned int vertex = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vertex, 1, &vShaderCode, NULL);
-        glCompileShader(vertex);
-        CheckCompileErrors(vertex, "VERTEX");
-
-        unsigned int fragment = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragment, 1, &fShaderCode, NULL);
-        glCompileShader(fragment);
-        CheckCompileErrors(fragment, "FRAGMENT");
-
-        // Create shader program
-        m_ID = glCreateProgram();
-        glAttachShader(m_ID, vertex);
-        glAttachShader(m_ID, fragment);
-        glLinkProgram(m_ID);
-        CheckCompileErrors(m_ID, "PROGRAM");
+        Compile(vertexCode.c_str(), fragmentCode.c_str());
+    }
 
-        glDeleteShader(vertex);
-        glDeleteShader(fragment);
+    /**
+     * \brief Creates a shader object from source code already in memory
+     */
+    explicit Shader(const ShaderSource& Source)
+    {
+        Compile(Source.Vertex.c_str(), Source.Fragment.c_str());
     }
 
     /**
@@ -83,69 +78,93 @@ public:
         glUseProgram(m_ID);
     }
 
-    void SetBool(const std::string& Name, const bool value) const
+    void SetBool(const char* Name, const bool value) const
     {
-        glUniform1i(glGetUniformLocation(m_ID, Name.c_str()), (int)value);
+        glUniform1i(glGetUniformLocation(m_ID, Name), (int)value);
     }
 
-    void SetInt(const std::string& Name, const int Value) const
+    void SetInt(const char* Name, const int Value) const
     {
-        glUniform1i(glGetUniformLocation(m_ID, Name.c_str()), Value);
+        glUniform1i(glGetUniformLocation(m_ID, Name), Value);
     }
 
-    void SetFloat(const std::string& Name, const float Value) const
+    void SetFloat(const char* Name, const float Value) const
     {
-        glUniform1f(glGetUniformLocation(m_ID, Name.c_str()), Value);
+        glUniform1f(glGetUniformLocation(m_ID, Name), Value);
     }
 
-    void SetVec2(const std::string& Name, const glm::vec2& Value) const
+    void SetVec2(const char* Name, const glm::vec2& Value) const
     {
-        glUniform2fv(glGetUniformLocation(m_ID, Name.c_str()), 1, &Value[0]);
+        glUniform2fv(glGetUniformLocation(m_ID, Name), 1, &Value[0]);
     }
 
-    void SetVec2(const std::string& Name, const float X, const float Y) const
+    void SetVec2(const char* Name, const float X, const float Y) const
     {
-        glUniform2f(glGetUniformLocation(m_ID, Name.c_str()), X, Y);
+        glUniform2f(glGetUniformLocation(m_ID, Name), X, Y);
     }
 
     // ------------------------------------------------------------------------
-    void SetVec3(const std::string& Name, const glm::vec3& Value) const
+    void SetVec3(const char* Name, const glm::vec3& Value) const
     {
-        glUniform3fv(glGetUniformLocation(m_ID, Name.c_str()), 1, &Value[0]);
+        glUniform3fv(glGetUniformLocation(m_ID, Name), 1, &Value[0]);
     }
 
-    void SetVec3(const std::string& Name, const float X, const float Y, const float Z) const
+    void SetVec3(const char* Name, const float X, const float Y, const float Z) const
     {
-        glUniform3f(glGetUniformLocation(m_ID, Name.c_str()), X, Y, Z);
+        glUniform3f(glGetUniformLocation(m_ID, Name), X, Y, Z);
     }
 
     // ------------------------------------------------------------------------
-    void SetVec4(const std::string& Name, const glm::vec4& Value) const
+    void SetVec4(const char* Name, const glm::vec4& Value) const
     {
-        glUniform4fv(glGetUniformLocation(m_ID, Name.c_str()), 1, &Value[0]);
+        glUniform4fv(glGetUniformLocation(m_ID, Name), 1, &Value[0]);
     }
 
-    void SetVec4(const std::string& Name, const float X, const float Y, const float Z, const float W) const
+    void SetVec4(const char* Name, const float X, const float Y, const float Z, const float W) const
     {
-        glUniform4f(glGetUniformLocation(m_ID, Name.c_str()), X, Y, Z, W);
+        glUniform4f(glGetUniformLocation(m_ID, Name), X, Y, Z, W);
     }
 
-    void SetMat2(const std::string& Name, const glm::mat2& Mat) const
+    void SetMat2(const char* Name, const glm::mat2& Mat) const
     {
-        glUniformMatrix2fv(glGetUniformLocation(m_ID, Name.c_str()), 1, GL_FALSE, &Mat[0][0]);
+        glUniformMatrix2fv(glGetUniformLocation(m_ID, Name), 1, GL_FALSE, &Mat[0][0]);
     }
 
-    void SetMat3(const std::string& Name, const glm::mat3& Mat) const
+    void SetMat3(const char* Name, const glm::mat3& Mat) const
     {
-        glUniformMatrix3fv(glGetUniformLocation(m_ID, Name.c_str()), 1, GL_FALSE, &Mat[0][0]);
+        glUniformMatrix3fv(glGetUniformLocation(m_ID, Name), 1, GL_FALSE, &Mat[0][0]);
     }
 
-    void SetMat4(const std::string& Name, const glm::mat4& Mat) const
+    void SetMat4(const char* Name, const glm::mat4& Mat) const
     {
-        glUniformMatrix4fv(glGetUniformLocation(m_ID, Name.c_str()), 1, GL_FALSE, &Mat[0][0]);
+        glUniformMatrix4fv(glGetUniformLocation(m_ID, Name), 1, GL_FALSE, &Mat[0][0]);
     }
 
 private:
+    void Compile(const char* VertexCode, const char* FragmentCode)
+    {
+        // Compile shaders
+        unsigned int vertex = glCreateShader(GL_VERTEX_SHADER);
+        glShaderSource(vertex, 1, &VertexCode, NULL);
+        glCompileShader(vertex);
+        CheckCompileErrors(vertex, "VERTEX");
+
+        unsigned int fragment = glCreateShader(GL_FRAGMENT_SHADER);
+        glShaderSource(fragment, 1, &FragmentCode, NULL);
+        glCompileShader(fragment);
+        CheckCompileErrors(fragment, "FRAGMENT");
+
+        // Create shader program
+        m_ID = glCreateProgram();
+        glAttachShader(m_ID, vertex);
+        glAttachShader(m_ID, fragment);
+        glLinkProgram(m_ID);
+        CheckCompileErrors(m_ID, "PROGRAM");
+
+        glDeleteShader(vertex);
+        glDeleteShader(fragment);
+    }
+
     void CheckCompileErrors(const GLuint Shader, const std::string& Type)
     {
         GLint success;
@@ -0,0 +1,184 @@
+#pragma once
+
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+enum class TextMatcherSyntax : uint8_t
+{
+    // ImGuiTextFilter: every term is a case-insensitive substring
+    SUBSTRING,
+    // terms containing '*' or '?' match the whole text as a case-insensitive glob; other terms are substrings
+    GLOB,
+};
+
+/**
+ * \brief ImGuiTextFilter syntax ("incl,-excl": the first term found decides, an include passes and an exclusion rejects;
+ * with only exclusions everything else passes) compiled once per edit into prepared needles for ImStristrPrepared(),
+ * which scans 16 bytes at a time.
+ *
+ * Unlike ImGuiTextFilter it owns its text and allocates nothing through ImGui, so it can be built and used on worker
+ * threads. IsNarrowingOf() tells when the rows that passed a previous filter are the only candidates for this one, which
+ * is the case while characters are typed onto the last include term.
+ */
+class TextMatcher
+{
+public:
+    explicit TextMatcher(const std::string_view Filter = std::string_view(), const TextMatcherSyntax Syntax = TextMatcherSyntax::SUBSTRING)
+        : m_Syntax(Syntax)
+        , m_Length(Filter.size())
+        , m_Text(new char[Filter.size() + 1])
+    {
+        memcpy(m_Text.get(), Filter.data(), Filter.size());
+        m_Text[Filter.size()] = '\0';
+        Compile();
+    }
+
+    // the needles point into m_Text, so copies compile their own
+    TextMatcher(const TextMatcher& Other) : TextMatcher(Other.GetText(), Other.m_Syntax) {}
+
+    TextMatcher& operator=(const TextMatcher& Other)
+    {
+        if (this != &Other)
+            *this = TextMatcher(Other.GetText(), Other.m_Syntax);
+        return *this;
+    }
+
+    TextMatcher(TextMatcher&&) noexcept = default;
+    TextMatcher& operator=(TextMatcher&&) noexcept = default;
+
+    [[nodiscard]] std::string_view GetText() const { return std::string_view(m_Text.get(), m_Length); }
+    [[nodiscard]] TextMatcherSyntax GetSyntax() const { return m_Syntax; }
+    [[nodiscard]] bool IsActive() const { return !m_Terms.empty(); }
+
+    [[nodiscard]] bool Pass(const std::string_view Text) const
+    {
+        if (m_Terms.empty())
+            return true;
+
+        const char* textEnd = Text.data() + Text.size();
+        for (const Term& term : m_Terms)
+        {
+            const bool bFound = term.bGlob ? MatchGlob(Text, term) : ImStristrPrepared(Text.data(), textEnd, term.Needle) != nullptr;
+            if (bFound)
+                return !term.Needle.Subtract;
+        }
+        return m_IncludeCount == 0;
+    }
+
+    /**
+     * \brief Whether every text this passes also passed Previous: the terms are the same except the last, an include in
+     * both, that became longer around what it was (e.g. "tex" -> "texture")
+     */
+    [[nodiscard]] bool IsNarrowingOf(const TextMatcher& Previous) const
+    {
+        if (!Previous.IsActive())
+            return true;
+        if (m_Syntax != Previous.m_Syntax || m_Terms.size() != Previous.m_Terms.size())
+            return false;
+
+        for (size_t i = 0; i < m_Terms.size(); i++)
+        {
+            const Term& term = m_Terms[i];
+            const Term& previous = Previous.m_Terms[i];
+            const std::string_view text(term.Needle.b, term.Needle.e - term.Needle.b);
+            const std::string_view previousText(previous.Needle.b, previous.Needle.e - previous.Needle.b);
+            if (text == previousText && term.Needle.Subtract == previous.Needle.Subtract && term.bGlob == previous.bGlob)
+                continue;
+
+            const bool bLast = i + 1 == m_Terms.size();
+            const bool bSubstringIncludes = !term.Needle.Subtract && !previous.Needle.Subtract && !term.bGlob && !previous.bGlob;
+            if (!bLast || !bSubstringIncludes || previousText.empty() ||
+                !ImStristrPrepared(text.data(), text.data() + text.size(), previous.Needle))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    struct Term
+    {
+        ImStristrNeedle Needle;
+        bool bGlob{false};
+    };
+
+    void Compile()
+    {
+        const char* text = m_Text.get();
+        const char* textEnd = text + m_Length;
+        for (const char* begin = text; begin <= textEnd;)
+        {
+            const char* end = begin;
+            while (end < textEnd && *end != ',')
+                end++;
+
+            const char* termBegin = begin;
+            const char* termEnd = end;
+            while (termBegin < termEnd && ImCharIsBlankA(*termBegin))
+                termBegin++;
+            while (termEnd > termBegin && ImCharIsBlankA(termEnd[-1]))
+                termEnd--;
+            if (termBegin < termEnd)
+            {
+                Term term;
+                term.Needle.Subtract = *termBegin == '-';
+                if (term.Needle.Subtract)
+                    termBegin++;
+                ImStristrPrepare(&term.Needle, termBegin, termEnd);
+                term.bGlob = m_Syntax == TextMatcherSyntax::GLOB && std::string_view(termBegin, termEnd - termBegin).find_first_of("*?") != std::string_view::npos;
+                m_IncludeCount += term.Needle.Subtract ? 0 : 1;
+                m_Terms.push_back(term);
+            }
+            begin = end + 1;
+        }
+    }
+
+    /**
+     * \brief Case-insensitive glob over the whole text; '*' backtracks to the last star only, so this is linear in practice
+     */
+    static bool MatchGlob(const std::string_view Text, const Term& Pattern)
+    {
+        const char* pattern = Pattern.Needle.b;
+        const char* patternEnd = Pattern.Needle.e;
+        const char* text = Text.data();
+        const char* textEnd = text + Text.size();
+        const char* starPattern = nullptr;
+        const char* starText = nullptr;
+        while (text < textEnd)
+        {
+            if (pattern < patternEnd && *pattern == '*')
+            {
+                starPattern = ++pattern;
+                starText = text;
+            }
+            else if (pattern < patternEnd && (*pattern == '?' || ImToUpper(*pattern) == ImToUpper(*text)))
+            {
+                pattern++;
+                text++;
+            }
+            else if (starPattern)
+            {
+                pattern = starPattern;
+                text = ++starText;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        while (pattern < patternEnd && *pattern == '*')
+            pattern++;
+        return pattern == patternEnd;
+    }
+
+    TextMatcherSyntax m_Syntax;
+    size_t m_Length;
+    std::unique_ptr<char[]> m_Text;
+    std::vector<Term> m_Terms;
+    uint32_t m_IncludeCount{0};
+};
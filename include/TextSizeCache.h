@@ -0,0 +1,352 @@
+#pragma once
+
+#include "imgui.h"
+#include "imgui_internal.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TEXT_SIZE_CACHE_SSE2 1
+#endif
+
+/**
+ * \brief Frame-coherent cache of ImFont::CalcTextSizeA() results.
+ *
+ * Results are keyed by a 64-bit hash of (font, size, max width, wrap width, text) and kept in two generations of an
+ * open-addressing table: lookups hit the current generation or promote from the previous one, and every
+ * GENERATION_FRAMES frames (or when the current one fills up) the previous generation is dropped. Labels submitted every
+ * frame therefore stay resident while text that disappeared is gone after at most two generations, without any per-entry
+ * bookkeeping. Unwrapped text is measured with a fast path that finds printable ASCII runs 16 bytes at a time and sums
+ * their advances without decoding; the sums are done in the same order as ImGui's, so results are bit-identical. Short
+ * unwrapped labels skip the tables entirely, as measuring them is cheaper than looking them up.
+ *
+ * Glyph advances must not change under the cache: call Clear() after fonts are modified (e.g. new dynamic glyphs).
+ */
+class TextSizeCache
+{
+public:
+    static constexpr uint32_t GENERATION_FRAMES = 120;
+    /** \brief Unwrapped text shorter than this is measured directly: the fast path beats a hash and a table probe */
+    static constexpr size_t MIN_CACHED_LENGTH = 64;
+
+    struct Stats
+    {
+        uint64_t Hits{0};
+        uint64_t Misses{0};
+        uint32_t Entries{0};
+    };
+
+    /**
+     * \param Capacity Initial slots per generation, rounded up to a power of two. A generation that reaches half load
+     * before GENERATION_FRAMES holds more distinct strings than fit, so the tables double, up to MaxCapacity; at
+     * MaxCapacity the generation is retired early instead.
+     */
+    explicit TextSizeCache(const uint32_t Capacity = 1u << 14, const uint32_t MaxCapacity = 1u << 20)
+    {
+        uint32_t capacity = 64;
+        while (capacity < Capacity)
+            capacity <<= 1;
+        m_MaxCapacity = std::max(capacity, MaxCapacity);
+        m_Current.Slots.resize(capacity);
+        m_Previous.Slots.resize(capacity);
+    }
+
+    TextSizeCache(const TextSizeCache&) = delete;
+    TextSizeCache& operator=(const TextSizeCache&) = delete;
+
+    /**
+     * \brief Answers CalcTextSizeA() of every font in Atlas from this cache
+     */
+    void Attach(ImFontAtlas* Atlas)
+    {
+        for (ImFont* font : Atlas->Fonts)
+        {
+            font->CalcTextSizeHandler = &OnCalcTextSize;
+            font->CalcTextSizeUserData = this;
+        }
+    }
+
+    void Detach(ImFontAtlas* Atlas)
+    {
+        for (ImFont* font : Atlas->Fonts)
+        {
+            if (font->CalcTextSizeUserData == this)
+            {
+                font->CalcTextSizeHandler = nullptr;
+                font->CalcTextSizeUserData = nullptr;
+            }
+        }
+    }
+
+    /**
+     * \brief Call once per frame, before ImGui::NewFrame()
+     */
+    void NewFrame()
+    {
+        m_LastFrameStats = m_FrameStats;
+        m_LastFrameStats.Entries = m_Current.Count + m_Previous.Count;
+        m_FrameStats = Stats();
+        if (++m_GenerationFrames >= GENERATION_FRAMES)
+            Rotate();
+    }
+
+    void Clear()
+    {
+        m_Current.Clear();
+        m_Previous.Clear();
+        m_GenerationFrames = 0;
+    }
+
+    /**
+     * \brief Lookups of the last complete frame, and the entries resident at its end
+     */
+    [[nodiscard]] const Stats& GetLastFrameStats() const { return m_LastFrameStats; }
+
+    /**
+     * \brief CalcTextSizeUncachedA() without wrapping or width limit, through the ASCII run fast path
+     */
+    static ImVec2 Measure(const ImFont& Font, const float Size, const char* TextBegin, const char* TextEnd)
+    {
+        const float lineHeight = Size;
+        const float scale = Size / Font.FontSize;
+        const float* advances = Font.IndexAdvanceX.Data;
+        const bool bAsciiIndexed = Font.IndexAdvanceX.Size >= 128;
+
+        ImVec2 textSize(0.0f, 0.0f);
+        float lineWidth = 0.0f;
+        const char* s = TextBegin;
+        while (s < TextEnd)
+        {
+            if (bAsciiIndexed)
+            {
+                const char* runEnd = FindAsciiRunEnd(s, TextEnd);
+                for (; s < runEnd; s++)
+                {
+                    const float charWidth = advances[static_cast<unsigned char>(*s)] * scale;
+                    lineWidth += charWidth;
+                }
+                if (s >= TextEnd)
+                    break;
+            }
+
+            // anything else takes the per-character path of CalcTextSizeUncachedA()
+            unsigned int c = static_cast<unsigned char>(*s);
+            if (c < 0x80)
+                s += 1;
+            else
+                s += ImTextCharFromUtf8(&c, s, TextEnd);
+
+            if (c < 32)
+            {
+                if (c == '\n')
+                {
+                    textSize.x = ImMax(textSize.x, lineWidth);
+                    textSize.y += lineHeight;
+                    lineWidth = 0.0f;
+                    continue;
+                }
+                if (c == '\r')
+                    continue;
+            }
+
+            const float charWidth = (static_cast<int>(c) < Font.IndexAdvanceX.Size ? advances[c] : Font.FallbackAdvanceX) * scale;
+            lineWidth += charWidth;
+        }
+
+        if (textSize.x < lineWidth)
+            textSize.x = lineWidth;
+        if (lineWidth > 0 || textSize.y == 0.0f)
+            textSize.y += lineHeight;
+        return textSize;
+    }
+
+private:
+    struct Slot
+    {
+        uint64_t Key{0};
+        ImVec2 Size;
+    };
+
+    struct Table
+    {
+        std::vector<Slot> Slots;
+        uint32_t Count{0};
+
+        Slot* Find(const uint64_t Key)
+        {
+            const size_t mask = Slots.size() - 1;
+            for (size_t i = static_cast<size_t>(Key) & mask;; i = (i + 1) & mask)
+            {
+                if (Slots[i].Key == Key)
+                    return &Slots[i];
+                if (Slots[i].Key == 0)
+                    return nullptr;
+            }
+        }
+
+        void Insert(const uint64_t Key, const ImVec2& Size)
+        {
+            const size_t mask = Slots.size() - 1;
+            size_t i = static_cast<size_t>(Key) & mask;
+            while (Slots[i].Key != 0)
+                i = (i + 1) & mask;
+            Slots[i].Key = Key;
+            Slots[i].Size = Size;
+            Count++;
+        }
+
+        void Clear()
+        {
+            if (Count > 0)
+                std::fill(Slots.begin(), Slots.end(), Slot());
+            Count = 0;
+        }
+    };
+
+    static ImVec2 OnCalcTextSize(void* UserData, const ImFont* Font, const float Size, const float MaxWidth, const float WrapWidth,
+                                 const char* TextBegin, const char* TextEnd, const char** Remaining)
+    {
+        // where a measurement stopped depends on the pointer, so those calls are not cached
+        if (Remaining)
+            return Font->CalcTextSizeUncachedA(Size, MaxWidth, WrapWidth, TextBegin, TextEnd, Remaining);
+        if (!TextEnd)
+            TextEnd = TextBegin + strlen(TextBegin);
+        const bool bUnwrapped = WrapWidth <= 0.0f && MaxWidth >= FLT_MAX;
+        if (bUnwrapped && static_cast<size_t>(TextEnd - TextBegin) < MIN_CACHED_LENGTH)
+            return Measure(*Font, Size, TextBegin, TextEnd);
+        return static_cast<TextSizeCache*>(UserData)->Lookup(*Font, Size, MaxWidth, WrapWidth, TextBegin, TextEnd);
+    }
+
+    ImVec2 Lookup(const ImFont& Font, const float Size, const float MaxWidth, const float WrapWidth, const char* TextBegin, const char* TextEnd)
+    {
+        const uint64_t key = MakeKey(Font, Size, MaxWidth, WrapWidth, TextBegin, TextEnd);
+        if (const Slot* slot = m_Current.Find(key))
+        {
+            m_FrameStats.Hits++;
+            return slot->Size;
+        }
+
+        ImVec2 size;
+        if (const Slot* slot = m_Previous.Find(key))
+        {
+            m_FrameStats.Hits++;
+            size = slot->Size;
+        }
+        else
+        {
+            m_FrameStats.Misses++;
+            size = (WrapWidth <= 0.0f && MaxWidth >= FLT_MAX) ? Measure(Font, Size, TextBegin, TextEnd)
+                                                              : Font.CalcTextSizeUncachedA(Size, MaxWidth, WrapWidth, TextBegin, TextEnd);
+        }
+
+        if (m_Current.Count * 2 >= m_Current.Slots.size())
+        {
+            if (m_Current.Slots.size() < m_MaxCapacity)
+                Grow();
+            else
+                Rotate();
+        }
+        m_Current.Insert(key, size);
+        return size;
+    }
+
+    void Grow()
+    {
+        const size_t capacity = m_Current.Slots.size() * 2;
+        Table grown;
+        grown.Slots.resize(capacity);
+        for (const Slot& slot : m_Current.Slots)
+        {
+            if (slot.Key != 0)
+                grown.Insert(slot.Key, slot.Size);
+        }
+        m_Current = std::move(grown);
+        m_Previous.Clear();
+        m_Previous.Slots.resize(capacity);
+    }
+
+    void Rotate()
+    {
+        std::swap(m_Current, m_Previous);
+        m_Current.Clear();
+        m_GenerationFrames = 0;
+    }
+
+    /**
+     * \brief First byte at or after Begin that is not printable ASCII (0x20..0x7F), or End
+     */
+    static const char* FindAsciiRunEnd(const char* Begin, const char* End)
+    {
+        const char* s = Begin;
+#ifdef TEXT_SIZE_CACHE_SSE2
+        // as signed bytes, printable ASCII is exactly > 0x1F
+        const __m128i controlMax = _mm_set1_epi8(0x1F);
+        while (End - s >= 16)
+        {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+            const unsigned int printable = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpgt_epi8(bytes, controlMax)));
+            if (printable != 0xFFFF)
+            {
+#if defined(_MSC_VER) && !defined(__clang__)
+                unsigned long first;
+                _BitScanForward(&first, ~printable);
+                return s + first;
+#else
+                return s + __builtin_ctz(~printable);
+#endif
+            }
+            s += 16;
+        }
+#endif
+        while (s < End && static_cast<unsigned char>(*s) >= 0x20 && static_cast<unsigned char>(*s) < 0x80)
+            s++;
+        return s;
+    }
+
+    static uint64_t MakeKey(const ImFont& Font, const float Size, const float MaxWidth, const float WrapWidth, const char* TextBegin,
+                            const char* TextEnd)
+    {
+        constexpr uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ull;
+        const auto mix = [](uint64_t Hash, const uint64_t Value)
+        {
+            Hash = (Hash ^ Value) * MULTIPLIER;
+            return Hash ^ (Hash >> 29);
+        };
+
+        size_t length = static_cast<size_t>(TextEnd - TextBegin);
+        uint64_t hash = mix(reinterpret_cast<uintptr_t>(&Font), length);
+        uint32_t bits[3];
+        memcpy(&bits[0], &Size, sizeof(float));
+        memcpy(&bits[1], &MaxWidth, sizeof(float));
+        memcpy(&bits[2], &WrapWidth, sizeof(float));
+        hash = mix(hash, (static_cast<uint64_t>(bits[0]) << 32) | bits[1]);
+        hash = mix(hash, bits[2]);
+
+        const char* s = TextBegin;
+        for (; length >= 8; s += 8, length -= 8)
+        {
+            uint64_t word;
+            memcpy(&word, s, sizeof(word));
+            hash = mix(hash, word);
+        }
+        uint64_t tail = 0;
+        memcpy(&tail, s, length);
+        hash = mix(hash, tail);
+
+        // 0 marks an empty slot
+        return hash ? hash : 1;
+    }
+
+    Table m_Current;
+    Table m_Previous;
+    uint32_t m_MaxCapacity{0};
+    uint32_t m_GenerationFrames{0};
+    Stats m_FrameStats;
+    Stats m_LastFrameStats;
+};
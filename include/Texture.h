@@ -5,36 +5,38 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
+#include <iostream>
+
 class Texture
 {
 public:
     Texture(const char* TextureFilepath)
     {
-        glGenTextures(1, &m_ID);
-        glBindTexture(GL_TEXTURE_2D, m_ID);
-        
-        // set the texture parameters
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        
         // load image, create texture and generate mipmaps
         int width, height, nrChannels;
         stbi_set_flip_vertically_on_load(true); // tell stb_image.h to flip loaded texture's on the y-axis.
         unsigned char* data = stbi_load(TextureFilepath, &width, &height, &nrChannels, 0);
         if (data)
         {
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-            glGenerateMipmap(GL_TEXTURE_2D);
+            Upload(data, width, height, nrChannels);
         }
         else
         {
+            Upload(nullptr, 0, 0, 0);
             std::cout << "Failed to load texture " << TextureFilepath << std::endl;
         }
         stbi_image_free(data);
     }
 
+    /**
+     * \brief Creates a texture from pixels already decoded in memory (e.g. by an async loader)
+     * \param Channels Components per pixel, 1 to 4
+     */
+    Texture(const unsigned char* Pixels, const int Width, const int Height, const int Channels)
+    {
+        Upload(Pixels, Width, Height, Channels);
+    }
+
     Texture(const Texture&) = delete;
     Texture& operator=(const Texture&) = delete;
     Texture(Texture&&) = delete;
@@ -46,6 +48,31 @@ public:
         glBindTexture(GL_TEXTURE_2D, m_ID);
     }
 
+private:
+    void Upload(const unsigned char* Pixels, const int Width, const int Height, const int Channels)
+    {
+        glGenTextures(1, &m_ID);
+        glBindTexture(GL_TEXTURE_2D, m_ID);
+
+        // set the texture parameters
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        if (!Pixels)
+            return;
+
+        static constexpr GLenum FORMATS[] = {GL_RED, GL_RG, GL_RGB, GL_RGBA};
+        const GLenum format = FORMATS[Channels - 1];
+
+        // rows of tightly packed RGB/R images are not 4-byte aligned
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, format, Width, Height, 0, format, GL_UNSIGNED_BYTE, Pixels);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+
 private:
     uint32_t m_ID;
 };
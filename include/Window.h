@@ -1,13 +1,31 @@
 #pragma once
 
+#include "Camera.h"
+
 #include "GLFW/glfw3.h" // Will drag system OpenGL headers
 
-static void FramebufferSizeCallback([[maybe_unused]] GLFWwindow* pWindow, int Width, int Height)
+static void MouseCallback(GLFWwindow* pWindow, double xposIn, double yposIn);
+
+/**
+ * \brief Input accumulated between two calls to Window::ProcessInput. High-rate mice deliver several cursor events
+ * per frame; they are summed here and applied to the camera once.
+ */
+struct InputBatch
 {
-    glViewport(0, 0, Width, Height);
-}
+    float MouseDeltaX{0.0f};
+    float MouseDeltaY{0.0f};
+    uint32_t MouseEventCount{0};
+    Camera::Clock::time_point FirstEventTime;
 
-static void MouseCallback(GLFWwindow* pWindow, double xposIn, double yposIn);
+    void AddMouseDelta(const float DeltaX, const float DeltaY)
+    {
+        if (MouseEventCount == 0)
+            FirstEventTime = Camera::Clock::now();
+        MouseDeltaX += DeltaX;
+        MouseDeltaY += DeltaY;
+        MouseEventCount++;
+    }
+};
 
 class Window
 {
@@ -55,10 +73,15 @@ public:
         
         glfwMakeContextCurrent(m_Window);
         glfwSwapInterval(1); // Enable vsync
-        glfwSetFramebufferSizeCallback(m_Window, FramebufferSizeCallback);
         glfwSetCursorPosCallback(m_Window, MouseCallback);
         glfwSetWindowUserPointer(m_Window, this);
         //glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+
+        // unaccelerated motion, used by GLFW whenever the cursor is disabled
+        if (glfwRawMouseMotionSupported())
+        {
+            glfwSetInputMode(m_Window, GLFW_RAW_MOUSE_MOTION, GLFW_TRUE);
+        }
     }
 
     ~Window()
@@ -80,6 +103,14 @@ public:
 
     void ProcessInput(const float DeltaTime)
     {
+        // apply all mouse motion received since the last frame as a single camera update
+        m_LastMouseEventCount = m_InputBatch.MouseEventCount;
+        if (m_InputBatch.MouseEventCount > 0)
+        {
+            m_Camera.ProcessMouseMovement(m_InputBatch.MouseDeltaX, m_InputBatch.MouseDeltaY, m_InputBatch.FirstEventTime);
+            m_InputBatch = InputBatch();
+        }
+
         if (glfwGetKey(m_Window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
         {
             glfwSetWindowShouldClose(m_Window, true);
@@ -124,10 +155,19 @@ public:
     const Camera& GetCamera() const { return m_Camera; }
     Camera& GetCamera() { return m_Camera; }
 
+    InputBatch& GetInputBatch() { return m_InputBatch; }
+
+    /**
+     * \brief Number of cursor events that were coalesced into the last camera update
+     */
+    [[nodiscard]] uint32_t GetLastMouseEventCount() const { return m_LastMouseEventCount; }
+
 private:
     GLFWwindow* m_Window{nullptr};
     inline static bool s_bInitialized{false};
     Camera m_Camera;
+    InputBatch m_InputBatch;
+    uint32_t m_LastMouseEventCount{0};
 };
 
 static void MouseCallback(GLFWwindow* pWindow, double xposIn, double yposIn)
@@ -152,5 +192,5 @@ static void MouseCallback(GLFWwindow* pWindow, double xposIn, double yposIn)
     LastX = xpos;
     LastY = ypos;
 
-    window->GetCamera().ProcessMouseMovement(xoffset, yoffset);
+    window->GetInputBatch().AddMouseDelta(xoffset, yoffset);
 }
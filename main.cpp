@@ -1,7 +1,31 @@
+#define ALLOCATION_TRACKER_IMPLEMENTATION
+#include "AllocationTracker.h"
+#include "AllocationTrackerPanel.h"
+#include "Allocators.h"
+#include "AsyncTask.h"
+#include "Benchmark.h"
 #include "Camera.h"
+#include "CpuProfiler.h"
+#include "DataGrid.h"
+#include "DynamicGlyphCache.h"
+#include "FontAtlasBuilder.h"
+#include "FontAtlasCache.h"
+#include "FrameTimeAnalytics.h"
+#include "FrameTimePanel.h"
+#include "GLCallCounter.h"
+#include "GpuProfiler.h"
+#include "JobSystem.h"
+#include "JobSystemPanel.h"
+#include "LogViewer.h"
 #include "Mesh.h"
-#include "Shader.h"
-#include "Texture.h"
+#include "PerfCounters.h"
+#include "PerfCountersPanel.h"
+#include "ProfilerCapture.h"
+#include "RenderThread.h"
+#include "SamplingProfiler.h"
+#include "SamplingProfilerPanel.h"
+#include "SceneRenderer.h"
+#include "TextSizeCache.h"
 #include "Window.h"
 
 #include "glad/glad.h"
@@ -12,8 +36,13 @@
 #include "imgui.h"
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
+#include "implot/implot.h"
+#include "LegitProfiler/ImGuiProfilerRenderer.h"
 
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
 
 /* TODO:
  * Default lit shader
@@ -27,25 +56,157 @@
  * Test on linux
  */
 
-int main(int, char**)
+/**
+ * \brief --alloc-test: run the default scene offscreen and fail if a steady-state frame allocates more than
+ * --alloc-budget times (default 0) over --alloc-frames measured frames
+ */
+struct AllocationTestOptions
 {
-    Window::Init();
-    Window window(1920, 1080, "CrossPlatformGUI");
+    bool bEnabled{false};
+    uint64_t Budget{0};
+    uint32_t WarmupFrames{120};
+    uint32_t MeasuredFrames{240};
+};
 
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+static AllocationTestOptions ParseAllocationTestOptions(const int argc, char** argv)
+{
+    AllocationTestOptions options;
+    for (int i = 1; i < argc; i++)
     {
-        std::cout << "Failed to initialize GLAD" << std::endl;
-        return -1;
+        if (strcmp(argv[i], "--alloc-test") == 0)
+            options.bEnabled = true;
+        else if (strcmp(argv[i], "--alloc-budget") == 0 && i + 1 < argc)
+            options.Budget = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--alloc-frames") == 0 && i + 1 < argc)
+            options.MeasuredFrames = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+    }
+    return options;
+}
+
+/**
+ * \brief --capture <file>: stream profiler data to a capture file from the first frame.
+ * --export-trace <capture> <json>: convert a capture to Chrome trace JSON and exit.
+ * --perf-counters: start with perf_event counters enabled (they are exported with captures).
+ */
+struct ProfilerCaptureOptions
+{
+    bool bPerfCounters{false};
+    const char* CapturePath{nullptr};
+    const char* ExportCapturePath{nullptr};
+    const char* ExportTracePath{nullptr};
+};
+
+static ProfilerCaptureOptions ParseProfilerCaptureOptions(const int argc, char** argv)
+{
+    ProfilerCaptureOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc)
+            options.CapturePath = argv[++i];
+        else if (strcmp(argv[i], "--perf-counters") == 0)
+            options.bPerfCounters = true;
+        else if (strcmp(argv[i], "--export-trace") == 0 && i + 2 < argc)
+        {
+            options.ExportCapturePath = argv[++i];
+            options.ExportTracePath = argv[++i];
+        }
     }
+    return options;
+}
+
+/**
+ * \brief --benchmark: render a generated scene offscreen along a scripted camera path for a fixed number of frames and
+ * write a JSON report. --bench-cubes, --bench-textures, --bench-texture-size and --bench-windows set the load;
+ * --bench-frames and --bench-warmup the run length; --bench-report the output path.
+ */
+struct BenchmarkOptions
+{
+    bool bEnabled{false};
+    uint32_t WarmupFrames{60};
+    uint32_t MeasuredFrames{600};
+    uint32_t Cubes{1000};
+    uint32_t Textures{8};
+    int TextureSize{256};
+    uint32_t Windows{4};
+    uint32_t Width{1920};
+    uint32_t Height{1080};
+    const char* ReportPath{"benchmark.json"};
+};
+
+static BenchmarkOptions ParseBenchmarkOptions(const int argc, char** argv)
+{
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--benchmark") == 0)
+            options.bEnabled = true;
+        else if (strcmp(argv[i], "--bench-frames") == 0 && i + 1 < argc)
+            options.MeasuredFrames = std::max(1u, static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10)));
+        else if (strcmp(argv[i], "--bench-warmup") == 0 && i + 1 < argc)
+            options.WarmupFrames = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        else if (strcmp(argv[i], "--bench-cubes") == 0 && i + 1 < argc)
+            options.Cubes = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        else if (strcmp(argv[i], "--bench-textures") == 0 && i + 1 < argc)
+            options.Textures = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        else if (strcmp(argv[i], "--bench-texture-size") == 0 && i + 1 < argc)
+            options.TextureSize = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--bench-windows") == 0 && i + 1 < argc)
+            options.Windows = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        else if (strcmp(argv[i], "--bench-size") == 0 && i + 2 < argc)
+        {
+            options.Width = std::max(1u, static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10)));
+            options.Height = std::max(1u, static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10)));
+        }
+        else if (strcmp(argv[i], "--bench-report") == 0 && i + 1 < argc)
+            options.ReportPath = argv[++i];
+    }
+    return options;
+}
+
+int main(int argc, char** argv)
+{
+    const ProfilerCaptureOptions captureOptions = ParseProfilerCaptureOptions(argc, argv);
+    if (captureOptions.ExportCapturePath)
+        return ProfilerCapture::ExportChromeTrace(captureOptions.ExportCapturePath, captureOptions.ExportTracePath) ? 0 : 1;
+
+    const AllocationTestOptions allocationTest = ParseAllocationTestOptions(argc, argv);
+    const BenchmarkOptions benchmark = ParseBenchmarkOptions(argc, argv);
+    // registered first so the main thread is profiler thread 0
+    CpuProfiler::SetThreadName("Main");
+    SamplingProfiler::RegisterThread();
+
+    // the benchmark and the allocation test need no display: GLFW's null platform with an OSMesa or EGL context renders
+    // offscreen
+    const bool bHeadless = benchmark.bEnabled || allocationTest.bEnabled;
+    if (bHeadless)
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    Window::Init();
+    if (bHeadless && !SelectHeadlessContextApi())
+    {
+        Window::Terminate();
+        return 1;
+    }
+    Window window(benchmark.bEnabled ? benchmark.Width : 1920, benchmark.bEnabled ? benchmark.Height : 1080, "CrossPlatformGUI");
+
+    // ImGui (and ImPlot) allocate from size-classed pools instead of the global heap; must outlive the ImGui context
+    PoolAllocator uiAllocator;
+    uiAllocator.InstallImGuiAllocator();
 
     // Setup Dear ImGui context
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
+    ImPlot::CreateContext();
     ImGuiIO& io = ImGui::GetIO();
     (void)io;
     io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard; // Enable Keyboard Controls
     io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;     // Enable Docking
     io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;   // Enable Multi-Viewport / Platform Windows
+    if (benchmark.bEnabled)
+    {
+        // no saved layout and no platform windows, so every run builds the same UI into one framebuffer
+        io.IniFilename = nullptr;
+        io.ConfigFlags &= ~ImGuiConfigFlags_ViewportsEnable;
+    }
     io.Fonts->AddFontFromFileTTF("data/fonts/Ruda/Ruda-Bold.ttf", 16);
 
     // Setup Dear ImGui style
@@ -104,105 +265,556 @@ int main(int, char**)
     }
 
     // Setup Platform/Renderer backends
+    // The GL context belongs to the render thread; the main thread only runs input, UI building and simulation.
     ImGui_ImplGlfw_InitForOpenGL(window.GetHandle(), true);
-    ImGui_ImplOpenGL3_Init("#version 330");
 
-    // OpenGL Setup
-    glEnable(GL_DEPTH_TEST);
-    Shader ourShader("data/shaders/default.vert", "data/shaders/default.frag");
+    JobSystem jobSystem;
+    // fonts are loaded at fixed pixel sizes, not scaled by the monitor's content scale; a cache miss rasterizes the
+    // atlas on the job system. Only the default ranges are baked, other glyphs of the fonts are rasterized on first use.
+    FontAtlasBuilder::SetJobSystem(&jobSystem);
+    io.Fonts->FontBuilderIO = FontAtlasBuilder::GetBuilderIO();
+    DynamicGlyphCache glyphCache(jobSystem);
+    glyphCache.ReservePages(io.Fonts);
+    if (!FontAtlasCache::Load(io.Fonts, "font_atlas.cache", 1.0f))
+    {
+        io.Fonts->Build();
+        FontAtlasCache::Save(io.Fonts, "font_atlas.cache", 1.0f);
+    }
+    glyphCache.Attach(io.Fonts);
+
+    // one distance field atlas renders its font crisply at any size, in a texture of its own for the SDF shader path
+    ImFontAtlas sdfFontAtlas;
+    sdfFontAtlas.Flags |= ImFontAtlasFlags_NoMouseCursors;
+    sdfFontAtlas.FontBuilderIO = FontAtlasBuilder::GetBuilderIO();
+    ImFont* sdfFont = nullptr;
+    {
+        ImFontConfig sdfConfig;
+        sdfConfig.OversampleH = 1;
+        sdfConfig.FontBuilderFlags = FontAtlasBuilder::BUILD_SDF;
+        sdfFont = sdfFontAtlas.AddFontFromFileTTF("data/fonts/Ruda/Ruda-Bold.ttf", 32, &sdfConfig);
+        if (sdfFont && !FontAtlasCache::Load(&sdfFontAtlas, "font_atlas_sdf.cache", 1.0f))
+        {
+            sdfFontAtlas.Build();
+            FontAtlasCache::Save(&sdfFontAtlas, "font_atlas_sdf.cache", 1.0f);
+        }
+    }
+    float sdfTextSize = 32.0f;
+
+    // labels are measured every frame; the cache answers repeated ones
+    TextSizeCache textSizeCache;
+    textSizeCache.Attach(io.Fonts);
+    textSizeCache.Attach(&sdfFontAtlas);
+    JobSystemPanel jobSystemPanel(jobSystem);
+    AllocationTrackerPanel allocationTrackerPanel(&uiAllocator);
+    DataGrid dataGrid(jobSystem);
+    int dataGridRowsIndex = 1;
+    LogViewer logViewer(jobSystem);
+    char logViewerPath[512] = "";
+
+    ImGuiUtils::ProfilersWindow profilersWindow;
+    GpuProfiler gpuProfiler;
+    std::vector<legit::ProfilerTask> gpuTasks;
+    std::vector<legit::ProfilerTask> cpuTasks;
+    int profiledThread = 0;
+    ProfilerCapture profilerCapture;
+    bool bNewGpuTasks = false;
+    const uint32_t heapAllocationsCounter = legit::TaskNames::Intern("Heap allocations");
+    const uint32_t heapBytesCounter = legit::TaskNames::Intern("Heap bytes");
+    std::vector<ProfilerCapture::Counter> captureCounters;
+    PerfCountersPanel perfCountersPanel;
+    SamplingProfilerPanel samplingProfilerPanel;
+    if (captureOptions.bPerfCounters && !PerfCounters::SetEnabled(true))
+        std::cout << PerfCounters::GetStatus() << std::endl;
+
+    // hitches write the profiler frames that led up to them; one snapshot per history length at most
+    FrameTimeAnalytics frameTimeAnalytics;
+    FrameTimePanel frameTimePanel(frameTimeAnalytics);
+    ProfilerFrameHistory profilerHistory(300);
+    uint64_t nextSnapshotFrame = 0;
+
+    // snapshot writes would add disk I/O to the measured frames
+    frameTimePanel.bAutoCapture = !benchmark.bEnabled;
+    BenchmarkReport benchmarkReport;
+    const std::vector<BenchmarkCube> benchmarkCubes =
+        benchmark.bEnabled ? GenerateBenchmarkCubes(benchmark.Cubes, benchmark.Textures) : std::vector<BenchmarkCube>();
+    const float benchmarkSceneRadius = GetBenchmarkSceneRadius(benchmark.Cubes);
+    const uint32_t benchmarkFrameCount = benchmark.WarmupFrames + benchmark.MeasuredFrames;
+    uint32_t benchmarkFrame = 0;
+
+    RenderThread renderThread(window.GetHandle());
+    std::unique_ptr<SceneRenderer> sceneRenderer;
+    bool bGLInitialized = false;
+
+    // GL jobs (async asset uploads) wake the render thread instead of waiting for the next frame
+    renderThread.SetBackgroundWork([&]() { jobSystem.RunAffineJobs(JobAffinity::RENDER_THREAD); });
+    jobSystem.SetAffinityNotify(JobAffinity::RENDER_THREAD,
+                                [](void* UserData) { static_cast<RenderThread*>(UserData)->NotifyBackgroundWork(); },
+                                &renderThread);
+
+    renderThread.Start(
+        [&]()
+        {
+            if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+            {
+                std::cout << "Failed to initialize GLAD" << std::endl;
+                return;
+            }
 
-    Mesh mesh;
-    Texture texture("data/textures/container.jpg");
+            AllocationTracker::SetCurrentTag(MemoryTag::RENDER);
+            CpuProfiler::SetThreadName("Render");
+            SamplingProfiler::RegisterThread();
+            glfwSwapInterval(benchmark.bEnabled ? 0 : 1); // Enable vsync, except when measuring
+            if (benchmark.bEnabled)
+            {
+                GLCallCounter::Install();
+                benchmarkReport.SetEnvironment(reinterpret_cast<const char*>(glGetString(GL_RENDERER)),
+                                               reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+            }
+            ImGui_ImplOpenGL3_Init("#version 330");
+            ImGui_ImplOpenGL3_CreateDeviceObjects();
+            if (sdfFont)
+                ImGui_ImplOpenGL3_CreateSdfFontsTexture(&sdfFontAtlas);
+            gpuProfiler.Init();
+            sceneRenderer = std::make_unique<SceneRenderer>();
+            if (benchmark.bEnabled)
+                sceneRenderer->CreateGeneratedTextures(benchmark.Textures, benchmark.TextureSize);
+            bGLInitialized = true;
+        },
+        [&](FrameCommandList& frame)
+        {
+            // GL work queued by other threads (uploads, deletions) runs before the frame's own draws
+            jobSystem.RunAffineJobs(JobAffinity::RENDER_THREAD);
+
+            for (const TextureRegionUpdate& update : frame.FontAtlasUpdates)
+                ImGui_ImplOpenGL3_UpdateFontsTexture(update.X, update.Y, update.Width, update.Height, update.Pixels);
+
+            gpuProfiler.BeginFrame();
+            {
+                PROFILE_SCOPE_COUNTERS("Scene render");
+                GpuProfileScope scope(gpuProfiler, "Scene", legit::Colors::emerald);
+                sceneRenderer->Render(frame);
+            }
+            {
+                PROFILE_SCOPE_COUNTERS("UI render");
+                GpuProfileScope scope(gpuProfiler, "UI", legit::Colors::peterRiver);
+                ImGui_ImplOpenGL3_RenderDrawData(frame.MainDrawData.Get());
+            }
+
+            // query objects are not shared between contexts, so the viewport pass is bracketed in the main context
+            const uint32_t viewportScope = frame.ViewportCount > 0 ? gpuProfiler.BeginScope("Viewports", legit::Colors::amethyst)
+                                                                   : GpuProfiler::MAX_SCOPES;
+            for (uint32_t i = 0; i < frame.ViewportCount; i++)
+            {
+                PROFILE_SCOPE("Viewport render");
+                ViewportPacket& viewport = frame.Viewports[i];
+                glfwMakeContextCurrent(viewport.Window);
+                if (viewport.bClear)
+                {
+                    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+                    glClear(GL_COLOR_BUFFER_BIT);
+                }
+                ImGui_ImplOpenGL3_RenderDrawData(viewport.DrawData.Get());
+                glfwSwapBuffers(viewport.Window);
+            }
+            if (frame.ViewportCount > 0)
+            {
+                glfwMakeContextCurrent(window.GetHandle());
+            }
+            gpuProfiler.EndScope(viewportScope);
+            gpuProfiler.EndFrame();
+
+            PROFILE_SCOPE("Swap");
+            window.SwapBuffers();
+        },
+        [&]()
+        {
+            if (bGLInitialized)
+            {
+                sceneRenderer.reset();
+                gpuProfiler.Shutdown();
+                ImGui_ImplOpenGL3_Shutdown();
+            }
+        });
+
+    if (!bGLInitialized)
+    {
+        jobSystem.SetAffinityNotify(JobAffinity::RENDER_THREAD, nullptr, nullptr);
+        renderThread.Stop();
+        ImGui_ImplGlfw_Shutdown();
+        glyphCache.Detach();
+        ImPlot::DestroyContext();
+        ImGui::DestroyContext();
+        return -1;
+    }
+
+    RenderThreadViewportHooks::Install(renderThread);
+
+    // scene assets stream in while the UI is already running
+    AsyncScope sceneLoadScope(jobSystem);
+    sceneLoadScope.Spawn(sceneRenderer->LoadAsync(jobSystem, &sceneLoadScope.GetToken()));
+    AsyncScope dataGridScope(jobSystem);
+
+    if (captureOptions.CapturePath)
+        profilerCapture.Start(captureOptions.CapturePath);
 
-    // tell opengl for each sampler to which texture unit it belongs to (only has to be done once)
-    // -------------------------------------------------------------------------------------------
-    ourShader.Bind();
-    ourShader.SetInt("texture1", 0);
-    
     float currentTime = static_cast<float>(glfwGetTime());
     float lastTime = currentTime;
 
     bool bUIShouldFillWindow = false;
+    uint64_t lastFrameHeapAllocations = 0;
+    uint32_t allocationTestFrame = 0;
+    uint64_t allocationTestWorstFrame = 0;
     while (!window.ShouldClose())
     {
-        window.PollEvents();
+        const uint64_t heapAllocationsAtFrameStart = HeapCounter::GetAllocationCount();
+        AllocationTracker::BeginFrame();
+        CpuProfiler::BeginFrame();
+        PerfCounters::BeginFrame();
+        {
+            PROFILE_SCOPE_COUNTERS("Poll events");
+            window.PollEvents();
+        }
 
         int windowWidth, windowHeight, windowX, windowY;
         glfwGetFramebufferSize(window.GetHandle(), &windowWidth, &windowHeight);
         glfwGetWindowPos(window.GetHandle(), &windowX, &windowY);
 
-        // Start the Dear ImGui frame
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
+        {
+            PROFILE_SCOPE("Main thread jobs");
+            jobSystem.RunAffineJobs(JobAffinity::MAIN_THREAD);
+        }
 
-        // Demo window; useful for finding ImGui example code
-        ImGui::ShowDemoWindow();
+        // Waits here if the render thread is more than the allowed number of frames behind
+        FrameCommandList& frame = renderThread.BeginFrame();
 
-        // Main Window
+        // glyphs rasterized since the last frame enter the atlas before this frame looks them up; their texels travel
+        // with the frame, so the render thread never samples a cell that was reused after the frame was built
         {
-            if (bUIShouldFillWindow)
+            PROFILE_SCOPE("Font caches");
+            if (glyphCache.Update())
+                textSizeCache.Clear();
+            textSizeCache.NewFrame();
+            for (const DynamicGlyphCache::Region& region : glyphCache.GetDirtyRegions())
             {
-                ImGui::Begin("Main Window",
-                             nullptr,
-                             ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoDecoration & ~ImGuiWindowFlags_NoScrollbar);
-                ImGui::SetWindowSize(ImVec2(windowWidth, windowHeight));
-                ImGui::SetWindowPos(ImVec2(windowX, windowY));
+                void* pixels = frame.Arena.Allocate(static_cast<size_t>(region.Width) * region.Height * sizeof(ImU32));
+                glyphCache.CopyRegionRGBA32(region, pixels);
+                frame.FontAtlasUpdates.push_back({region.X, region.Y, region.Width, region.Height, pixels});
             }
-            else
+        }
+
+        // Build the Dear ImGui frame
+        {
+            PROFILE_SCOPE_COUNTERS("ImGui build");
+            AllocationTracker::SetCurrentTag(MemoryTag::UI);
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+            ImGui::NewFrame();
+
+            // Demo window; useful for finding ImGui example code
+            ImGui::ShowDemoWindow();
+
+            // Main Window
             {
-                ImGui::Begin("Main Window", nullptr);
+                if (bUIShouldFillWindow)
+                {
+                    ImGui::Begin("Main Window",
+                                 nullptr,
+                                 ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoDecoration & ~ImGuiWindowFlags_NoScrollbar);
+                    ImGui::SetWindowSize(ImVec2(windowWidth, windowHeight));
+                    ImGui::SetWindowPos(ImVec2(windowX, windowY));
+                }
+                else
+                {
+                    ImGui::Begin("Main Window", nullptr);
+                }
+                ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
+                ImGui::Text("Input to camera matrix latency %.3f ms (%u mouse events coalesced)",
+                            window.GetCamera().GetInputLatency() * 1000.0, window.GetLastMouseEventCount());
+                ImGui::Text("Allocator heap requests last frame: %llu (frame arena %.1f / %.1f KiB)",
+                            static_cast<unsigned long long>(lastFrameHeapAllocations), frame.Arena.GetHighWater() / 1024.0,
+                            frame.Arena.GetCapacity() / 1024.0);
+                const DynamicGlyphCache::Stats glyphStats = glyphCache.GetStats();
+                ImGui::Text("Dynamic glyphs: %u / %u cells, %u pending, %llu rasterized, %llu evicted", glyphStats.ResidentCount,
+                            glyphStats.CellCount, glyphStats.PendingCount, static_cast<unsigned long long>(glyphStats.RasterizedCount),
+                            static_cast<unsigned long long>(glyphStats.EvictedCount));
+                const TextSizeCache::Stats& textStats = textSizeCache.GetLastFrameStats();
+                ImGui::Text("Text size cache: %llu hits, %llu misses, %u entries", static_cast<unsigned long long>(textStats.Hits),
+                            static_cast<unsigned long long>(textStats.Misses), textStats.Entries);
+
+                if (sdfFont)
+                {
+                    static const char* SDF_SAMPLE = "Distance field text";
+                    ImGui::SetNextItemWidth(200.0f);
+                    ImGui::SliderFloat("SDF text size", &sdfTextSize, 6.0f, 256.0f, "%.0f px", ImGuiSliderFlags_Logarithmic);
+                    ImDrawList* drawList = ImGui::GetWindowDrawList();
+                    drawList->PushTextureID(sdfFontAtlas.TexID);
+                    drawList->AddText(sdfFont, sdfTextSize, ImGui::GetCursorScreenPos(), ImGui::GetColorU32(ImGuiCol_Text), SDF_SAMPLE);
+                    drawList->PopTextureID();
+                    ImGui::Dummy(sdfFont->CalcTextSizeA(sdfTextSize, FLT_MAX, 0.0f, SDF_SAMPLE));
+                }
+
+                // the CPU graph has a single lane, so it shows the top-level scopes of one thread at a time
+                ImGui::SetNextItemWidth(200.0f);
+                if (ImGui::BeginCombo("Profiled thread", CpuProfiler::GetThreadName(static_cast<uint32_t>(profiledThread))))
+                {
+                    for (uint32_t i = 0; i < CpuProfiler::GetThreadCount(); i++)
+                    {
+                        if (ImGui::Selectable(CpuProfiler::GetThreadName(i), profiledThread == static_cast<int>(i)))
+                            profiledThread = static_cast<int>(i);
+                    }
+                    ImGui::EndCombo();
+                }
+
+                if (profilerCapture.IsCapturing())
+                {
+                    if (ImGui::Button("Stop capture"))
+                        profilerCapture.Stop();
+                    ImGui::SameLine();
+                    ImGui::Text("%s: %llu frames (%llu dropped), %.1f MiB", profilerCapture.GetPath().c_str(),
+                                static_cast<unsigned long long>(profilerCapture.GetFrameCount()),
+                                static_cast<unsigned long long>(profilerCapture.GetDroppedFrameCount()),
+                                profilerCapture.GetWrittenBytes() / (1024.0 * 1024.0));
+                }
+                else if (ImGui::Button("Start capture"))
+                {
+                    profilerCapture.Start("profile.cpcap");
+                }
+                ImGui::End();
+            }
+
+            renderThread.RenderOverlay();
+            jobSystemPanel.Render();
+            allocationTrackerPanel.Render();
+            frameTimePanel.Render();
+
+            ImGui::Begin("Data Grid");
+            {
+                static constexpr uint32_t ROW_COUNTS[] = {100000, 1000000, 10000000};
+                static constexpr const char* ROW_COUNT_NAMES[] = {"100k rows", "1M rows", "10M rows"};
+                ImGui::SetNextItemWidth(120.0f);
+                ImGui::Combo("##Rows", &dataGridRowsIndex, ROW_COUNT_NAMES, IM_ARRAYSIZE(ROW_COUNT_NAMES));
+                ImGui::SameLine();
+                ImGui::BeginDisabled(!dataGridScope.IsIdle());
+                if (ImGui::Button("Generate"))
+                    dataGridScope.Spawn(LoadDemoDataGridTable(jobSystem, dataGrid, ROW_COUNTS[dataGridRowsIndex], &dataGridScope.GetToken()));
+                ImGui::EndDisabled();
+                dataGrid.Draw("Demo table");
             }
-            ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
             ImGui::End();
-        }
 
-        //profilersWindow.Render();
-        ImGui::Render();
+            ImGui::Begin("Log Viewer");
+            {
+                ImGui::SetNextItemWidth(ImGui::GetFontSize() * 24.0f);
+                const bool bOpen = ImGui::InputTextWithHint("##Path", "Log file path", logViewerPath, sizeof(logViewerPath),
+                                                            ImGuiInputTextFlags_EnterReturnsTrue);
+                ImGui::SameLine();
+                if ((ImGui::Button("Open") || bOpen) && logViewerPath[0] != '\0')
+                    logViewer.Open(logViewerPath);
+                logViewer.Draw("Log");
+            }
+            ImGui::End();
+            perfCountersPanel.Render();
+            samplingProfilerPanel.Render();
+            if (benchmark.bEnabled)
+                RenderBenchmarkWindows(benchmark.Windows, benchmarkFrame);
+
+            bNewGpuTasks = gpuProfiler.ConsumeResults(gpuTasks);
+            if (!profilersWindow.stopProfiling && bNewGpuTasks)
+            {
+                profilersWindow.gpuGraph.LoadFrameData(gpuTasks.data(), gpuTasks.size());
+            }
+            profilersWindow.Render();
+            ImGui::Render();
+            AllocationTracker::SetCurrentTag(MemoryTag::GENERAL);
+        }
 
-        // OpenGL Rendering
+        // Scene simulation; records draw packets for the render thread
         {
+            PROFILE_SCOPE_COUNTERS("Simulation");
             currentTime = glfwGetTime();
             float deltaTime = currentTime - lastTime;
             lastTime = currentTime;
 
-            window.ProcessInput(deltaTime);
+            Camera& camera = window.GetCamera();
+            if (benchmark.bEnabled)
+                ApplyBenchmarkCameraPath(camera, benchmarkFrame, benchmarkFrameCount, benchmarkSceneRadius);
+            else
+                window.ProcessInput(deltaTime);
+
+            camera.UpdatePerspectiveProjectionMatrix(windowWidth, windowHeight);
 
-            glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            frame.FramebufferWidth = windowWidth;
+            frame.FramebufferHeight = windowHeight;
+            frame.Projection = camera.GetPerspectiveProjectionMatrix();
+            frame.View = camera.GetViewMatrix();
 
-            texture.Bind(0);
-            ourShader.Bind();
-            ourShader.SetMat4("projection", window.GetCamera().GetPerspectiveProjectionMatrix());
-            ourShader.SetMat4("view", window.GetCamera().GetViewMatrix());
+            const Frustum& frustum = camera.GetFrustum();
+            if (benchmark.bEnabled)
+            {
+                for (const BenchmarkCube& cube : benchmarkCubes)
+                {
+                    if (frustum.IsSphereVisible(cube.Position, 0.87f))
+                    {
+                        frame.Packets.push_back({glm::translate(glm::mat4(1.0f), cube.Position), cube.TextureIndex});
+                    }
+                }
+            }
+            else
+            {
+                for (unsigned int i = 0; i < 10; i++)
+                {
+                    // 0.87 ~ radius of the sphere enclosing a unit cube
+                    if (frustum.IsSphereVisible(CUBE_POSITIONS[i], 0.87f))
+                    {
+                        frame.Packets.push_back({glm::translate(glm::mat4(1.0f), CUBE_POSITIONS[i])});
+                    }
+                }
+            }
+        }
+
+        {
+            PROFILE_SCOPE("Capture draw data");
+            frame.MainDrawData.Capture(ImGui::GetDrawData());
 
-            // render boxes
-            mesh.Bind();
-            for (unsigned int i = 0; i < 10; i++)
+            if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
             {
-                mesh.Draw(ourShader, i);
+                ImGui::UpdatePlatformWindows();
+                RenderThreadViewportHooks::CaptureViewports(frame);
             }
         }
 
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        renderThread.SubmitFrame();
 
-        if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+        // shown next frame, like the GPU timings
+        CpuProfiler::EndFrame();
+        PerfCounters::EndFrame();
+        perfCountersPanel.AddFrame();
+        SamplingProfiler::Update();
+        if (!profilersWindow.stopProfiling)
         {
-            GLFWwindow* backup_current_context = glfwGetCurrentContext();
-            ImGui::UpdatePlatformWindows();
-            ImGui::RenderPlatformWindowsDefault();
-            glfwMakeContextCurrent(backup_current_context);
+            CpuProfiler::BuildProfilerTasks(cpuTasks, static_cast<uint32_t>(profiledThread));
+            profilersWindow.cpuGraph.LoadFrameData(cpuTasks.data(), cpuTasks.size());
         }
 
-        window.SwapBuffers();
+        // 0 in steady state: ImGui and per-frame data are served from pools and arenas that already own their memory
+        lastFrameHeapAllocations = HeapCounter::GetAllocationCount() - heapAllocationsAtFrameStart;
+
+        const AllocationTracker::FrameSample& frameAllocations = AllocationTracker::EndFrame();
+        {
+            captureCounters.clear();
+            captureCounters.push_back({heapAllocationsCounter, static_cast<double>(frameAllocations.TotalAllocations)});
+            captureCounters.push_back({heapBytesCounter, static_cast<double>(frameAllocations.TotalBytes)});
+            PerfCounterValues perfFrame;
+            if (PerfCounters::GetFrameCounters(perfFrame))
+            {
+                for (uint32_t i = 0; i < PerfCounters::GetCounterCount(); i++)
+                    captureCounters.push_back({PerfCounters::GetFrameCounterNameIds()[i], static_cast<double>(perfFrame.Values[i])});
+                for (const PerfCounters::ScopeStats& scope : PerfCounters::GetFrameScopes())
+                {
+                    for (uint32_t i = 0; i < PerfCounters::GetCounterCount() && scope.Calls > 0; i++)
+                        captureCounters.push_back({scope.CounterNameIds[i], static_cast<double>(scope.Counters.Values[i])});
+                }
+            }
+            const size_t gpuTaskCount = bNewGpuTasks ? gpuTasks.size() : 0;
+            if (profilerCapture.IsCapturing())
+                profilerCapture.SubmitFrame(gpuTasks.data(), gpuTaskCount, captureCounters.data(), captureCounters.size());
+            profilerHistory.RecordFrame(gpuTasks.data(), gpuTaskCount, captureCounters.data(), captureCounters.size());
+
+            const double frameMilliseconds =
+                CpuProfiler::TicksToSeconds(static_cast<int64_t>(CpuProfiler::GetFrameEnd() - CpuProfiler::GetFrameBegin())) * 1000.0;
+            if (frameTimeAnalytics.AddFrame(frameMilliseconds) && frameTimePanel.bAutoCapture
+                && frameTimeAnalytics.GetFrameCount() >= nextSnapshotFrame)
+            {
+                char snapshotPath[64];
+                snprintf(snapshotPath, sizeof(snapshotPath), "hitch_%llu.cpcap",
+                         static_cast<unsigned long long>(frameTimeAnalytics.GetFrameCount()));
+                if (profilerHistory.WriteSnapshot(jobSystem, snapshotPath))
+                {
+                    frameTimePanel.SetLastSnapshot(snapshotPath);
+                    nextSnapshotFrame = frameTimeAnalytics.GetFrameCount() + 300;
+                }
+            }
+
+            // frames only count once the assets are in, so every run measures the same work
+            if (benchmark.bEnabled && sceneLoadScope.IsIdle())
+            {
+                if (benchmarkFrame == benchmark.WarmupFrames)
+                {
+                    // GL calls of warmup frames still in flight must not leak into the measurement
+                    renderThread.WaitIdle();
+                    benchmarkReport.BeginMeasurement(benchmark.MeasuredFrames);
+                }
+
+                uint32_t drawCommands = 0;
+                const ImDrawData* drawData = ImGui::GetDrawData();
+                for (int i = 0; drawData && i < drawData->CmdListsCount; i++)
+                    drawCommands += static_cast<uint32_t>(drawData->CmdLists[i]->CmdBuffer.Size);
+                benchmarkReport.AddFrame(frameMilliseconds, drawCommands);
+
+                if (++benchmarkFrame == benchmarkFrameCount)
+                    break;
+            }
+        }
+        if (allocationTest.bEnabled && sceneLoadScope.IsIdle())
+        {
+            if (++allocationTestFrame > allocationTest.WarmupFrames)
+                allocationTestWorstFrame = std::max(allocationTestWorstFrame, frameAllocations.TotalAllocations);
+            if (allocationTestFrame == allocationTest.WarmupFrames + allocationTest.MeasuredFrames)
+                break;
+        }
     }
 
+    SamplingProfiler::SetEnabled(false);
+
+    // Platform windows must be destroyed on the main thread, before the renderer shuts down
+    renderThread.WaitIdle();
+    if (benchmark.bEnabled)
+        benchmarkReport.EndMeasurement();
+    RenderThreadViewportHooks::Remove();
+    ImGui::DestroyPlatformWindows();
+
+    // pending loads may still need the render thread to observe the cancellation
+    sceneLoadScope.Cancel();
+    sceneLoadScope.Wait();
+    dataGridScope.Cancel();
+    dataGridScope.Wait();
+    jobSystem.SetAffinityNotify(JobAffinity::RENDER_THREAD, nullptr, nullptr);
+    renderThread.Stop();
+
+    profilerCapture.Stop();
+
     // Cleanup
-    ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
+    glyphCache.Detach();
+    ImPlot::DestroyContext();
     ImGui::DestroyContext();
 
     Window::Terminate();
 
+    if (allocationTest.bEnabled)
+    {
+        const bool bCompleted = allocationTestFrame == allocationTest.WarmupFrames + allocationTest.MeasuredFrames;
+        const bool bPassed = bCompleted && allocationTestWorstFrame <= allocationTest.Budget;
+        std::cout << "Allocation test " << (bPassed ? "passed" : "FAILED") << ": worst steady-state frame made "
+                  << allocationTestWorstFrame << " allocations (budget " << allocationTest.Budget << ", "
+                  << allocationTest.MeasuredFrames << " frames" << (bCompleted ? "" : ", interrupted") << ")" << std::endl;
+        return bPassed ? 0 : 1;
+    }
+
+    if (benchmark.bEnabled)
+    {
+        char config[512];
+        snprintf(config, sizeof(config),
+                 "{\"warmup_frames\": %u, \"measured_frames\": %u, \"cubes\": %u, \"textures\": %u, \"texture_size\": %d, "
+                 "\"windows\": %u, \"width\": %u, \"height\": %u}",
+                 benchmark.WarmupFrames, benchmark.MeasuredFrames, benchmark.Cubes, benchmark.Textures, benchmark.TextureSize,
+                 benchmark.Windows, benchmark.Width, benchmark.Height);
+        const bool bCompleted = benchmarkReport.GetFrameCount() == benchmark.MeasuredFrames;
+        const bool bWritten = benchmarkReport.WriteJson(benchmark.ReportPath, config);
+        std::cout << "Benchmark " << (bCompleted ? "completed" : "interrupted") << ": " << benchmarkReport.GetFrameCount()
+                  << " frames measured, report " << (bWritten ? "written to " : "not written to ") << benchmark.ReportPath << std::endl;
+        return bCompleted && bWritten ? 0 : 1;
+    }
+
     return 0;
 }
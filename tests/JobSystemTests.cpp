@@ -0,0 +1,167 @@
+#include "JobSystem.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+int g_Failures = 0;
+
+void Check(const bool bCondition, const char* Description)
+{
+    if (!bCondition)
+    {
+        std::cout << "FAILED: " << Description << std::endl;
+        g_Failures++;
+    }
+}
+
+/**
+ * \brief Executes everything still queued; a job enqueued twice has its second copy run by then
+ */
+void Drain(JobSystem& System)
+{
+    // the main thread only runs its affine jobs once nothing else is left to execute
+    Job* marker = System.CreateJob([]() {}, nullptr, JobAffinity::MAIN_THREAD);
+    System.Schedule(marker);
+    System.Wait(marker);
+}
+
+/**
+ * \brief Before completes before After is scheduled; After must still run, exactly once and only after Before
+ */
+void TestDependencyFinishedBeforeSchedule(JobSystem& System)
+{
+    constexpr int ITERATIONS = 1000;
+    std::vector<std::atomic<int>> beforeRuns(ITERATIONS);
+    std::vector<std::atomic<int>> afterRuns(ITERATIONS);
+    std::atomic<bool> bOrdered{true};
+    for (int i = 0; i < ITERATIONS; i++)
+    {
+        std::atomic<int>* beforeCount = &beforeRuns[i];
+        std::atomic<int>* afterCount = &afterRuns[i];
+        Job* before = System.CreateJob([beforeCount]() { beforeCount->fetch_add(1); });
+        Job* after = System.CreateJob([beforeCount, afterCount, &bOrdered]()
+        {
+            if (beforeCount->load() != 1)
+                bOrdered = false;
+            afterCount->fetch_add(1);
+        });
+        JobSystem::AddDependency(before, after);
+
+        System.Schedule(before);
+        System.Wait(before);
+        System.Schedule(after);
+        System.Wait(after);
+    }
+    Drain(System);
+
+    for (int i = 0; i < ITERATIONS; i++)
+        Check(afterRuns[i].load() == 1, "dependent scheduled after its dependency finished ran exactly once");
+    Check(bOrdered.load(), "dependent ran after its dependency");
+}
+
+/**
+ * \brief Several dependencies finishing concurrently with Schedule(After), in both scheduling orders
+ */
+void TestDependencyFanIn(JobSystem& System)
+{
+    constexpr int ITERATIONS = 2000;
+    constexpr int DEPENDENCIES = 4;
+    std::vector<std::atomic<int>> beforeRuns(ITERATIONS);
+    std::vector<std::atomic<int>> afterRuns(ITERATIONS);
+    std::atomic<bool> bOrdered{true};
+    for (int i = 0; i < ITERATIONS; i++)
+    {
+        std::atomic<int>* beforeCount = &beforeRuns[i];
+        std::atomic<int>* afterCount = &afterRuns[i];
+        Job* after = System.CreateJob([beforeCount, afterCount, &bOrdered]()
+        {
+            if (beforeCount->load() != DEPENDENCIES)
+                bOrdered = false;
+            afterCount->fetch_add(1);
+        });
+        Job* befores[DEPENDENCIES];
+        for (Job*& before : befores)
+        {
+            before = System.CreateJob([beforeCount]() { beforeCount->fetch_add(1); });
+            JobSystem::AddDependency(before, after);
+        }
+
+        const bool bAfterFirst = i % 2 == 0;
+        if (bAfterFirst)
+            System.Schedule(after);
+        for (Job* before : befores)
+            System.Schedule(before);
+        if (!bAfterFirst)
+            System.Schedule(after);
+        System.Wait(after);
+    }
+    Drain(System);
+
+    for (int i = 0; i < ITERATIONS; i++)
+        Check(afterRuns[i].load() == 1, "fan-in dependent ran exactly once");
+    Check(bOrdered.load(), "fan-in dependent ran after all of its dependencies");
+}
+
+/**
+ * \brief A job left unfinished while its thread allocates more than a pool's worth of jobs keeps its slot
+ */
+void TestPoolSkipsUnfinishedJobs(JobSystem& System)
+{
+    std::atomic<int> children{0};
+    Job* group = System.CreateGroup();
+    System.Run([&]() { children.fetch_add(1); }, group);
+
+    for (uint32_t i = 0; i < JobSystem::JOB_POOL_SIZE * 2; i++)
+    {
+        Job* job = System.Run([]() {});
+        System.Wait(job);
+    }
+
+    Check(!group->IsFinished(), "unscheduled group survives pool wrap-around");
+    System.Schedule(group);
+    System.Wait(group);
+    Check(children.load() == 1, "group completes after pool wrap-around");
+}
+
+/**
+ * \brief What a job's callable captured is released once the job has run
+ */
+void TestPayloadReleasedOnFinish(JobSystem& System)
+{
+    auto resource = std::make_shared<int>(42);
+    std::atomic<int> seen{0};
+    Job* job = System.Run([resource, &seen]() { seen = *resource; });
+    System.Wait(job);
+
+    Check(seen.load() == 42, "job saw its captured state");
+    Check(resource.use_count() == 1, "captured state released when the job finished");
+}
+} // namespace
+
+int main()
+{
+    for (const uint32_t threadCount : {1u, 4u})
+    {
+        JobSystemDesc desc;
+        desc.ThreadCount = threadCount;
+        JobSystem system(desc);
+
+        TestDependencyFinishedBeforeSchedule(system);
+        TestDependencyFanIn(system);
+        TestPoolSkipsUnfinishedJobs(system);
+        TestPayloadReleasedOnFinish(system);
+    }
+
+    if (g_Failures > 0)
+    {
+        std::cout << g_Failures << " JobSystem check(s) failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "JobSystem tests passed" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -7,7 +7,7 @@
 #include <algorithm>
 #include <array>
 #include <chrono>
-#include <map>
+#include <cstdio>
 #include <sstream>
 #include <vector>
 
@@ -26,56 +26,54 @@ public:
     bool useColoredLegendText;
     float maxFrameTime = 1.0f / 30.0f;
 
+    // Only this many tasks are ranked for the legend each frame; the legend never has room for more
+    static constexpr size_t maxLegendTasks = 64;
+
     ProfilerGraph(size_t framesCount)
     {
         frames.resize(framesCount);
         for (auto &frame : frames) { frame.tasks.reserve(100); }
+        statsSlots.assign(64, StatsSlot{ emptySlot, 0 });
         frameWidth           = 3;
         frameSpacing         = 1;
         useColoredLegendText = false;
     }
 
+    // Stats are a sliding window over the frame ring: the frame being overwritten is subtracted and the new one added,
+    // so the cost depends on the tasks of those two frames only. No allocations once the buffers have grown.
     void LoadFrameData(const legit::ProfilerTask *tasks, size_t count)
     {
         auto &currFrame = frames[currFrameIndex];
+        for (const auto &task : currFrame.tasks)
+        {
+            auto &stats = taskStats[task.statsIndex];
+            stats.windowCount--;
+            stats.windowTime = stats.windowCount > 0 ? std::max(0.0, stats.windowTime - task.GetLength()) : 0.0;
+        }
+
         currFrame.tasks.resize(0);
         for (size_t taskIndex = 0; taskIndex < count; taskIndex++)
         {
-            if (taskIndex == 0)
+            const auto &task = tasks[taskIndex];
+            if (taskIndex > 0 && tasks[taskIndex - 1].color == task.color && tasks[taskIndex - 1].nameId == task.nameId)
             {
-                currFrame.tasks.push_back(tasks[taskIndex]);
+                currFrame.tasks.back().endTime = task.endTime;
             }
             else
             {
-                if (tasks[taskIndex - 1].color != tasks[taskIndex].color
-                    || tasks[taskIndex - 1].name != tasks[taskIndex].name)
-                {
-                    currFrame.tasks.push_back(tasks[taskIndex]);
-                }
-                else
-                {
-                    currFrame.tasks.back().endTime = tasks[taskIndex].endTime;
-                }
+                currFrame.tasks.push_back({ task.startTime, task.endTime, task.nameId, task.color, FindOrAddStats(task.nameId) });
             }
         }
-        currFrame.taskStatsIndex.resize(currFrame.tasks.size());
 
-        for (size_t taskIndex = 0; taskIndex < currFrame.tasks.size(); taskIndex++)
+        for (const auto &task : currFrame.tasks)
         {
-            auto &task = currFrame.tasks[taskIndex];
-            auto it    = taskNameToStatsIndex.find(task.name);
-            if (it == taskNameToStatsIndex.end())
-            {
-                taskNameToStatsIndex[task.name] = taskStats.size();
-                TaskStats taskStat;
-                taskStat.maxTime = -1.0;
-                taskStats.push_back(taskStat);
-            }
-            currFrame.taskStatsIndex[taskIndex] = taskNameToStatsIndex[task.name];
+            auto &stats = taskStats[task.statsIndex];
+            stats.windowCount++;
+            stats.windowTime += task.GetLength();
         }
         currFrameIndex = (currFrameIndex + 1) % frames.size();
 
-        RebuildTaskStats(currFrameIndex, 300 /*frames.size()*/);
+        RankTaskStats();
     }
 
     void RenderTimings(int graphWidth, int legendWidth, int height, int frameIndexOffset)
@@ -88,41 +86,65 @@ public:
     }
 
 private:
-    void RebuildTaskStats(size_t endFrame, size_t framesCount)
+    // Ranks stats by time spent in the window; only the top maxLegendTasks get a priority, the rest stay unranked
+    void RankTaskStats()
     {
-        for (auto &taskStat : taskStats)
+        for (auto &taskStat : taskStats) { taskStat.priorityOrder = size_t(-1); }
+
+        size_t rankedCount = std::min(maxLegendTasks, statsOrder.size());
+        std::partial_sort(statsOrder.begin(),
+                          statsOrder.begin() + rankedCount,
+                          statsOrder.end(),
+                          [this](uint32_t left, uint32_t right)
+                          { return taskStats[left].windowTime > taskStats[right].windowTime; });
+        for (size_t statNumber = 0; statNumber < rankedCount; statNumber++)
         {
-            taskStat.maxTime       = -1.0f;
-            taskStat.priorityOrder = size_t(-1);
-            taskStat.onScreenIndex = size_t(-1);
+            taskStats[statsOrder[statNumber]].priorityOrder = statNumber;
         }
+    }
 
-        for (size_t frameNumber = 0; frameNumber < framesCount; frameNumber++)
+    // Open-addressed (linear probing) map from name ID to stats index, kept at most half full
+    uint32_t FindOrAddStats(uint32_t nameId)
+    {
+        size_t mask = statsSlots.size() - 1;
+        for (size_t slotIndex = HashNameId(nameId) & mask;; slotIndex = (slotIndex + 1) & mask)
         {
-            size_t frameIndex = (endFrame - 1 - frameNumber + frames.size()) % frames.size();
-            auto &frame       = frames[frameIndex];
-            for (size_t taskIndex = 0; taskIndex < frame.tasks.size(); taskIndex++)
-            {
-                auto &task    = frame.tasks[taskIndex];
-                auto &stats   = taskStats[frame.taskStatsIndex[taskIndex]];
-                stats.maxTime = std::max(stats.maxTime, task.endTime - task.startTime);
-            }
-        }
+            auto &slot = statsSlots[slotIndex];
+            if (slot.nameId == nameId)
+                return slot.statsIndex;
+            if (slot.nameId != emptySlot)
+                continue;
 
-        std::vector<size_t> statPriorities;
-        statPriorities.resize(taskStats.size());
-        for (size_t statIndex = 0; statIndex < taskStats.size(); statIndex++) { statPriorities[statIndex] = statIndex; }
+            uint32_t statsIndex = uint32_t(taskStats.size());
+            slot                = { nameId, statsIndex };
+            TaskStats taskStat;
+            taskStat.nameId = nameId;
+            taskStats.push_back(taskStat);
+            statsOrder.push_back(statsIndex);
+            if (taskStats.size() * 2 > statsSlots.size())
+                GrowStatsSlots();
+            return statsIndex;
+        }
+    }
 
-        std::sort(statPriorities.begin(),
-                  statPriorities.end(),
-                  [this](size_t left, size_t right) { return taskStats[left].maxTime > taskStats[right].maxTime; });
-        for (size_t statNumber = 0; statNumber < taskStats.size(); statNumber++)
+    void GrowStatsSlots()
+    {
+        statsSlots.assign(statsSlots.size() * 2, StatsSlot{ emptySlot, 0 });
+        size_t mask = statsSlots.size() - 1;
+        for (uint32_t statsIndex = 0; statsIndex < taskStats.size(); statsIndex++)
         {
-            size_t statIndex                   = statPriorities[statNumber];
-            taskStats[statIndex].priorityOrder = statNumber;
+            size_t slotIndex = HashNameId(taskStats[statsIndex].nameId) & mask;
+            while (statsSlots[slotIndex].nameId != emptySlot) { slotIndex = (slotIndex + 1) & mask; }
+            statsSlots[slotIndex] = { taskStats[statsIndex].nameId, statsIndex };
         }
     }
 
+    static size_t HashNameId(uint32_t nameId)
+    {
+        // IDs are dense small integers; spread them over the table
+        return size_t(nameId * 0x9E3779B1u);
+    }
+
     void RenderGraph(ImDrawList *drawList, ImVec2 graphPos, ImVec2 graphSize, size_t frameIndexOffset)
     {
         Rect(drawList, graphPos, graphPos + graphSize, 0xffffffff, false);
@@ -171,14 +193,14 @@ private:
         auto &currFrame      = frames[(currFrameIndex - frameIndexOffset - 1 + 2 * frames.size()) % frames.size()];
         size_t maxTasksCount = size_t(legendSize.y / (markerRightRectHeight + markerRightRectSpacing));
 
-        for (auto &taskStat : taskStats) { taskStat.onScreenIndex = size_t(-1); }
+        for (const auto &task : currFrame.tasks) { taskStats[task.statsIndex].onScreenIndex = size_t(-1); }
 
-        size_t tasksToShow     = std::min<size_t>(taskStats.size(), maxTasksCount);
+        size_t tasksToShow     = std::min<size_t>(taskStats.size(), std::min(maxTasksCount, maxLegendTasks));
         size_t tasksShownCount = 0;
         for (size_t taskIndex = 0; taskIndex < currFrame.tasks.size(); taskIndex++)
         {
             auto &task = currFrame.tasks[taskIndex];
-            auto &stat = taskStats[currFrame.taskStatsIndex[taskIndex]];
+            auto &stat = taskStats[task.statsIndex];
 
             if (stat.priorityOrder >= tasksToShow)
             {
@@ -218,15 +240,13 @@ private:
             uint32_t textColor = useColoredLegendText ? task.color : legit::Colors::imguiText;   // task.color;
 
             float taskTimeMs = float(task.endTime - task.startTime);
-            std::ostringstream timeText;
-            timeText.precision(2);
-            timeText << std::fixed << std::string("[") << (taskTimeMs * 1000.0f);
+            char timeText[32];
+            snprintf(timeText, sizeof(timeText), "[%.2f", taskTimeMs * 1000.0f);
+            char nameText[128];
+            snprintf(nameText, sizeof(nameText), "ms] %s", legit::TaskNames::Get(task.nameId));
 
-            Text(drawList, markerRightRectMax + textMargin, textColor, timeText.str().c_str());
-            Text(drawList,
-                 markerRightRectMax + textMargin + ImVec2(nameOffset, 0.0f),
-                 textColor,
-                 (std::string("ms] ") + task.name).c_str());
+            Text(drawList, markerRightRectMax + textMargin, textColor, timeText);
+            Text(drawList, markerRightRectMax + textMargin + ImVec2(nameOffset, 0.0f), textColor, nameText);
         }
 
         /*
@@ -332,6 +352,16 @@ private:
                                          ImVec2(rightMinPoint.x, rightMinPoint.y) };
         drawList->AddConvexPolyFilled(points.data(), int(points.size()), col);
     }
+    struct FrameTask
+    {
+        double startTime;
+        double endTime;
+        uint32_t nameId;
+        uint32_t color;
+        uint32_t statsIndex;
+        double GetLength() const { return endTime - startTime; }
+    };
+
     struct FrameData
     {
         /*void BuildPriorityTasks(size_t maxPriorityTasksCount)
@@ -358,19 +388,28 @@ private:
             usedTaskNames.insert(tasks[bestTaskIndex].name);
           }
         }*/
-        std::vector<legit::ProfilerTask> tasks;
-        std::vector<size_t> taskStatsIndex;
+        std::vector<FrameTask> tasks;
         // std::vector<size_t> priorityTaskIndices;
     };
 
     struct TaskStats
     {
-        double maxTime;
-        size_t priorityOrder;
-        size_t onScreenIndex;
+        uint32_t nameId      = 0;
+        uint32_t windowCount = 0;   // occurrences in the frames currently in the ring
+        double windowTime    = 0.0; // total time of those occurrences
+        size_t priorityOrder = size_t(-1);
+        size_t onScreenIndex = size_t(-1);
     };
     std::vector<TaskStats> taskStats;
-    std::map<std::string, size_t> taskNameToStatsIndex;
+    std::vector<uint32_t> statsOrder;
+
+    static constexpr uint32_t emptySlot = uint32_t(-1);
+    struct StatsSlot
+    {
+        uint32_t nameId;
+        uint32_t statsIndex;
+    };
+    std::vector<StatsSlot> statsSlots;
 
     /*struct PriorityTask
     {
@@ -410,12 +449,12 @@ public:
             }
         }
 
-        std::stringstream title;
-        title.precision(2);
-        title << std::fixed << "Legit profiler [" << 1.0f / avgFrameTime << "fps\t" << avgFrameTime * 1000.0f
-              << "ms]###ProfilerWindow";
+        // formatted on the stack: this runs every frame and must not touch the heap
+        char title[96];
+        snprintf(title, sizeof(title), "Legit profiler [%.2ffps\t%.2fms]###ProfilerWindow", 1.0f / avgFrameTime,
+                 avgFrameTime * 1000.0f);
         //###AnimatedTitle
-        ImGui::Begin(title.str().c_str(), 0, ImGuiWindowFlags_NoScrollbar);
+        ImGui::Begin(title, 0, ImGuiWindowFlags_NoScrollbar);
         ImVec2 canvasSize = ImGui::GetContentRegionAvail();
 
         int sizeMargin           = int(ImGui::GetStyle().ItemSpacing.y);
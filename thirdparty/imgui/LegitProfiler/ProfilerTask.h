@@ -1,7 +1,12 @@
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <deque>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 namespace legit
 {
@@ -34,11 +39,70 @@ namespace legit
     const static uint32_t silver = RGBA_LE(0xbdc3c7ffu);
     const static uint32_t imguiText = RGBA_LE(0xF2F5FAFFu);
   }
+
+  // Task names are interned once and referred to by ID afterwards, so per-frame task data carries no strings.
+  // Intern() may be called from any thread; Get() is lock-free. ID 0 is the empty name.
+  class TaskNames
+  {
+  public:
+    static constexpr uint32_t maxNames = 1 << 14;
+
+    static uint32_t Intern(std::string_view name)
+    {
+      Registry &registry = GetRegistry();
+      std::lock_guard<std::mutex> lock(registry.mutex);
+      auto it = registry.ids.find(name);
+      if (it != registry.ids.end())
+        return it->second;
+
+      uint32_t id = registry.count.load(std::memory_order_relaxed);
+      if (id == maxNames)
+        return 0;
+      const std::string &stored = registry.storage.emplace_back(name);
+      registry.names[id] = stored.c_str();
+      registry.ids.emplace(std::string_view(stored), id);
+      registry.count.store(id + 1, std::memory_order_release);
+      return id;
+    }
+
+    static uint32_t GetCount()
+    {
+      return GetRegistry().count.load(std::memory_order_acquire);
+    }
+
+    static const char *Get(uint32_t id)
+    {
+      const Registry &registry = GetRegistry();
+      return id < registry.count.load(std::memory_order_acquire) ? registry.names[id] : registry.names[0];
+    }
+
+  private:
+    struct Registry
+    {
+      Registry()
+      {
+        names[0] = "";
+        ids.emplace(std::string_view(), 0);
+      }
+      std::mutex mutex;
+      std::deque<std::string> storage;
+      std::unordered_map<std::string_view, uint32_t> ids;
+      const char *names[maxNames];
+      std::atomic<uint32_t> count{1};
+    };
+
+    static Registry &GetRegistry()
+    {
+      static Registry registry;
+      return registry;
+    }
+  };
+
   struct ProfilerTask
   {
     double startTime;
     double endTime;
-    std::string name;
+    uint32_t nameId; // from TaskNames::Intern()
     uint32_t color;
     double GetLength()
     {
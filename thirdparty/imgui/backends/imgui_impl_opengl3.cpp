@@ -207,9 +207,13 @@ struct ImGui_ImplOpenGL3_Data
     GLuint          GlVersion;               // Extracted at runtime using GL_MAJOR_VERSION, GL_MINOR_VERSION queries (e.g. 320 for GL 3.2)
     char            GlslVersionString[32];   // Specified by user or detected based on compile time GL settings.
     GLuint          FontTexture;
+    GLuint          SdfFontTexture;          // Texture whose alpha is a distance field (ImGui_ImplOpenGL3_CreateSdfFontsTexture)
+    ImFontAtlas*    SdfFontAtlas;
     GLuint          ShaderHandle;
     GLint           AttribLocationTex;       // Uniforms location
     GLint           AttribLocationProjMtx;
+    GLint           AttribLocationSdfMode;
+    bool            SdfModeEnabled;
     GLuint          AttribLocationVtxPos;    // Vertex attributes location
     GLuint          AttribLocationVtxUV;
     GLuint          AttribLocationVtxColor;
@@ -429,6 +433,8 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     glUseProgram(bd->ShaderHandle);
     glUniform1i(bd->AttribLocationTex, 0);
     glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+    glUniform1i(bd->AttribLocationSdfMode, 0);
+    bd->SdfModeEnabled = false;
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (bd->GlVersion >= 330)
@@ -576,7 +582,14 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 GL_CALL(glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y)));
 
                 // Bind texture, Draw
-                GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID()));
+                const GLuint texture = (GLuint)(intptr_t)pcmd->GetTexID();
+                const bool sdf_mode = texture != 0 && texture == bd->SdfFontTexture;
+                if (sdf_mode != bd->SdfModeEnabled)
+                {
+                    GL_CALL(glUniform1i(bd->AttribLocationSdfMode, sdf_mode ? 1 : 0));
+                    bd->SdfModeEnabled = sdf_mode;
+                }
+                GL_CALL(glBindTexture(GL_TEXTURE_2D, texture));
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                 if (bd->GlVersion >= 320)
                     GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset));
@@ -662,6 +675,60 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
     return true;
 }
 
+void ImGui_ImplOpenGL3_UpdateFontsTexture(int x, int y, int width, int height, const void* rgba32_pixels)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    if (bd == nullptr || bd->FontTexture == 0)
+        return;
+
+    GLint last_texture;
+    GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, bd->FontTexture));
+#ifdef GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
+    GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+#endif
+    GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, rgba32_pixels));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture));
+}
+
+bool ImGui_ImplOpenGL3_CreateSdfFontsTexture(ImFontAtlas* atlas)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    ImGui_ImplOpenGL3_DestroySdfFontsTexture();
+
+    // Same layout as the main font texture: white RGB, the distance in alpha
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    GLint last_texture;
+    GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
+    GL_CALL(glGenTextures(1, &bd->SdfFontTexture));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, bd->SdfFontTexture));
+    GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+    GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+#ifdef GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
+    GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+#endif
+    GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+    atlas->SetTexID((ImTextureID)(intptr_t)bd->SdfFontTexture);
+    bd->SdfFontAtlas = atlas;
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture));
+    return true;
+}
+
+void ImGui_ImplOpenGL3_DestroySdfFontsTexture()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    if (bd->SdfFontTexture)
+    {
+        glDeleteTextures(1, &bd->SdfFontTexture);
+        bd->SdfFontAtlas->SetTexID(0);
+        bd->SdfFontTexture = 0;
+        bd->SdfFontAtlas = nullptr;
+    }
+}
+
 void ImGui_ImplOpenGL3_DestroyFontsTexture()
 {
     ImGuiIO& io = ImGui::GetIO();
@@ -791,42 +858,72 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "    precision mediump float;\n"
         "#endif\n"
         "uniform sampler2D Texture;\n"
+        "uniform int SdfMode;\n"
         "varying vec2 Frag_UV;\n"
         "varying vec4 Frag_Color;\n"
         "void main()\n"
         "{\n"
-        "    gl_FragColor = Frag_Color * texture2D(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture2D(Texture, Frag_UV.st);\n"
+        "#ifndef GL_ES\n" // no fwidth() without OES_standard_derivatives: ES 2.0 draws the raw field
+        "    if (SdfMode != 0)\n"
+        "    {\n"
+        "        float w = max(0.7 * fwidth(tex.a), 1.0 / 255.0);\n"
+        "        tex = vec4(1.0, 1.0, 1.0, smoothstep(0.5 - w, 0.5 + w, tex.a));\n"
+        "    }\n"
+        "#endif\n"
+        "    gl_FragColor = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_130 =
         "uniform sampler2D Texture;\n"
+        "uniform int SdfMode;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    if (SdfMode != 0)\n"
+        "    {\n"
+        "        float w = max(0.7 * fwidth(tex.a), 1.0 / 255.0);\n"
+        "        tex = vec4(1.0, 1.0, 1.0, smoothstep(0.5 - w, 0.5 + w, tex.a));\n"
+        "    }\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_300_es =
         "precision mediump float;\n"
         "uniform sampler2D Texture;\n"
+        "uniform int SdfMode;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    if (SdfMode != 0)\n"
+        "    {\n"
+        "        float w = max(0.7 * fwidth(tex.a), 1.0 / 255.0);\n"
+        "        tex = vec4(1.0, 1.0, 1.0, smoothstep(0.5 - w, 0.5 + w, tex.a));\n"
+        "    }\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_410_core =
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "uniform sampler2D Texture;\n"
+        "uniform int SdfMode;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    if (SdfMode != 0)\n"
+        "    {\n"
+        "        float w = max(0.7 * fwidth(tex.a), 1.0 / 255.0);\n"
+        "        tex = vec4(1.0, 1.0, 1.0, smoothstep(0.5 - w, 0.5 + w, tex.a));\n"
+        "    }\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     // Select shaders matching our GLSL versions
@@ -880,6 +977,7 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
     bd->AttribLocationTex = glGetUniformLocation(bd->ShaderHandle, "Texture");
     bd->AttribLocationProjMtx = glGetUniformLocation(bd->ShaderHandle, "ProjMtx");
+    bd->AttribLocationSdfMode = glGetUniformLocation(bd->ShaderHandle, "SdfMode");
     bd->AttribLocationVtxPos = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Position");
     bd->AttribLocationVtxUV = (GLuint)glGetAttribLocation(bd->ShaderHandle, "UV");
     bd->AttribLocationVtxColor = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Color");
@@ -907,6 +1005,7 @@ void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
     if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
     if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
     ImGui_ImplOpenGL3_DestroyFontsTexture();
+    ImGui_ImplOpenGL3_DestroySdfFontsTexture();
 }
 
 //--------------------------------------------------------------------------------------------------------
@@ -30,6 +30,9 @@ IMGUI_IMPL_API void     ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data);
 // (Optional) Called by Init/NewFrame/Shutdown
 IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_CreateFontsTexture();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyFontsTexture();
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_CreateSdfFontsTexture(ImFontAtlas* atlas);   // Texture for an atlas of distance field glyphs (FontAtlasBuilder::BUILD_SDF), drawn with the SDF shader path
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroySdfFontsTexture();
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_UpdateFontsTexture(int x, int y, int width, int height, const void* rgba32_pixels); // Re-upload a region of the atlas (width * height tightly packed RGBA32 texels, as from GetTexDataAsRGBA32())
 IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_CreateDeviceObjects();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyDeviceObjects();
 
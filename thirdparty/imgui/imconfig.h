@@ -58,6 +58,15 @@
 //---- Use 32-bit for ImWchar (default is 16-bit) to support unicode planes 1-16. (e.g. point beyond 0xFFFF like emoticons, dingbats, symbols, shapes, ancient languages, etc...)
 //#define IMGUI_USE_WCHAR32
 
+//---- (CrossPlatformGUI addition) Back ImGuiStorage with an open-addressing hash index instead of a sorted array: O(1) insertion instead of O(N) memmoves.
+// Data stays iterable, but its pairs are in insertion order until BuildSortByKey() is called. Set by the CROSSPLATFORMGUI_IMGUI_HASH_STORAGE CMake option.
+//#define IMGUI_STORAGE_OPEN_ADDRESSING
+
+//---- (CrossPlatformGUI addition) Hash IDs with CRC-32C instead of CRC-32, so x86 CPUs with SSE4.2 hash them in hardware (ARMv8 does both).
+// This changes every ID: window, table and docking settings in .ini files saved without it (or by stock Dear ImGui) are not found again.
+// Set by the CROSSPLATFORMGUI_IMGUI_CRC32C_IDS CMake option.
+//#define IMGUI_HASH_CRC32C
+
 //---- Avoid multiple STB libraries implementations, or redefine path/filenames to prioritize another version
 // By default the embedded implementations are declared static and not available outside of Dear ImGui sources files.
 //#define IMGUI_STB_TRUETYPE_FILENAME   "my_folder/stb_truetype.h"
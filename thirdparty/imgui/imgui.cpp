@@ -1827,6 +1827,100 @@ const char* ImStristr(const char* haystack, const char* haystack_end, const char
     return NULL;
 }
 
+// (CrossPlatformGUI addition) Prepared variant of ImStristr(), used by ImGuiTextFilter::PassFilter().
+// Like the generic SIMD strstr, it tests 16 candidate positions at once by comparing the first byte of the needle against
+// haystack[i..i+15] and its last byte against haystack[i+n-1..i+n+14]; only positions where both match are compared fully.
+#if defined(IMGUI_ENABLE_SSE) && (defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define IMGUI_STRISTR_ENABLE_SSE2
+#endif
+
+void ImStristrPrepare(ImStristrNeedle* out_needle, const char* needle, const char* needle_end)
+{
+    if (!needle_end)
+        needle_end = needle + strlen(needle);
+    out_needle->b = needle;
+    out_needle->e = needle_end;
+    if (needle == needle_end)
+        return;
+    const char first = ImToUpper(needle[0]);
+    const char last = ImToUpper(needle_end[-1]);
+    out_needle->FirstFold = (first >= 'A' && first <= 'Z') ? 0x20 : 0;
+    out_needle->FirstLower = (unsigned char)first | out_needle->FirstFold;
+    out_needle->LastFold = (last >= 'A' && last <= 'Z') ? 0x20 : 0;
+    out_needle->LastLower = (unsigned char)last | out_needle->LastFold;
+}
+
+static inline bool ImStristrMatchesAt(const char* haystack, const ImStristrNeedle& needle)
+{
+    const char* b = needle.b + 1;
+    for (const char* a = haystack + 1; b < needle.e - 1; a++, b++)
+        if (ImToUpper(*a) != ImToUpper(*b))
+            return false;
+    return true;
+}
+
+#ifdef IMGUI_STRISTR_ENABLE_SSE2
+// Bit n is set when the needle's first byte matches block[n] and its last byte matches block[n + needle_len - 1]
+static inline unsigned int ImStristrCandidates(const char* block, size_t needle_len, const ImStristrNeedle& needle)
+{
+    const __m128i first_bytes = _mm_or_si128(_mm_loadu_si128((const __m128i*)(const void*)block), _mm_set1_epi8((char)needle.FirstFold));
+    const __m128i last_bytes = _mm_or_si128(_mm_loadu_si128((const __m128i*)(const void*)(block + needle_len - 1)), _mm_set1_epi8((char)needle.LastFold));
+    return (unsigned int)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first_bytes, _mm_set1_epi8((char)needle.FirstLower)), _mm_cmpeq_epi8(last_bytes, _mm_set1_epi8((char)needle.LastLower))));
+}
+
+static inline const char* ImStristrVerifyCandidates(const char* block, unsigned int mask, const ImStristrNeedle& needle)
+{
+    while (mask != 0)
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long n;
+        _BitScanForward(&n, mask);
+#else
+        const int n = __builtin_ctz(mask);
+#endif
+        if (ImStristrMatchesAt(block + n, needle))
+            return block + n;
+        mask &= mask - 1;
+    }
+    return NULL;
+}
+#endif
+
+const char* ImStristrPrepared(const char* haystack, const char* haystack_end, const ImStristrNeedle& needle)
+{
+    // An empty needle keeps ImStristr()'s behavior (it compares against the byte following the needle)
+    if (needle.b == needle.e)
+        return ImStristr(haystack, haystack_end, needle.b, needle.e);
+    if (!haystack_end)
+        haystack_end = haystack + strlen(haystack);
+
+    const size_t needle_len = (size_t)(needle.e - needle.b);
+    if ((size_t)(haystack_end - haystack) < needle_len)
+        return NULL;
+    const char* last_candidate = haystack_end - needle_len;
+    const char* h = haystack;
+
+#ifdef IMGUI_STRISTR_ENABLE_SSE2
+    if (last_candidate - haystack >= 15)
+    {
+        for (; last_candidate - h >= 15; h += 16)
+            if (const char* found = ImStristrVerifyCandidates(h, ImStristrCandidates(h, needle_len, needle), needle))
+                return found;
+
+        // The remaining candidates, as a block overlapping the last one
+        if (h > last_candidate)
+            return NULL;
+        const char* block = last_candidate - 15;
+        return ImStristrVerifyCandidates(block, ImStristrCandidates(block, needle_len, needle) & (0xFFFFu << (h - block)), needle);
+    }
+#endif
+
+    for (; h <= last_candidate; h++)
+        if (((unsigned char)h[0] | needle.FirstFold) == needle.FirstLower && ((unsigned char)h[needle_len - 1] | needle.LastFold) == needle.LastLower && ImStristrMatchesAt(h, needle))
+            return h;
+    return NULL;
+}
+
 // Trim str by offsetting contents when there's leading data + writing a \0 at the trailing position. We use this in situation where the cost is negligible.
 void ImStrTrimBlanks(char* buf)
 {
@@ -1943,74 +2037,194 @@ void ImFormatStringToTempBufferV(const char** out_buf, const char** out_buf_end,
     }
 }
 
-// CRC32 needs a 1KB lookup table (not cache friendly)
-// Although the code to generate the table is simple and shorter than the table itself, using a const table allows us to easily:
-// - avoid an unnecessary branch/memory tap, - keep the ImHashXXX functions usable by static constructors, - make it thread-safe.
-static const ImU32 GCrc32LookupTable[256] =
-{
-    0x00000000,0x77073096,0xEE0E612C,0x990951BA,0x076DC419,0x706AF48F,0xE963A535,0x9E6495A3,0x0EDB8832,0x79DCB8A4,0xE0D5E91E,0x97D2D988,0x09B64C2B,0x7EB17CBD,0xE7B82D07,0x90BF1D91,
-    0x1DB71064,0x6AB020F2,0xF3B97148,0x84BE41DE,0x1ADAD47D,0x6DDDE4EB,0xF4D4B551,0x83D385C7,0x136C9856,0x646BA8C0,0xFD62F97A,0x8A65C9EC,0x14015C4F,0x63066CD9,0xFA0F3D63,0x8D080DF5,
-    0x3B6E20C8,0x4C69105E,0xD56041E4,0xA2677172,0x3C03E4D1,0x4B04D447,0xD20D85FD,0xA50AB56B,0x35B5A8FA,0x42B2986C,0xDBBBC9D6,0xACBCF940,0x32D86CE3,0x45DF5C75,0xDCD60DCF,0xABD13D59,
-    0x26D930AC,0x51DE003A,0xC8D75180,0xBFD06116,0x21B4F4B5,0x56B3C423,0xCFBA9599,0xB8BDA50F,0x2802B89E,0x5F058808,0xC60CD9B2,0xB10BE924,0x2F6F7C87,0x58684C11,0xC1611DAB,0xB6662D3D,
-    0x76DC4190,0x01DB7106,0x98D220BC,0xEFD5102A,0x71B18589,0x06B6B51F,0x9FBFE4A5,0xE8B8D433,0x7807C9A2,0x0F00F934,0x9609A88E,0xE10E9818,0x7F6A0DBB,0x086D3D2D,0x91646C97,0xE6635C01,
-    0x6B6B51F4,0x1C6C6162,0x856530D8,0xF262004E,0x6C0695ED,0x1B01A57B,0x8208F4C1,0xF50FC457,0x65B0D9C6,0x12B7E950,0x8BBEB8EA,0xFCB9887C,0x62DD1DDF,0x15DA2D49,0x8CD37CF3,0xFBD44C65,
-    0x4DB26158,0x3AB551CE,0xA3BC0074,0xD4BB30E2,0x4ADFA541,0x3DD895D7,0xA4D1C46D,0xD3D6F4FB,0x4369E96A,0x346ED9FC,0xAD678846,0xDA60B8D0,0x44042D73,0x33031DE5,0xAA0A4C5F,0xDD0D7CC9,
-    0x5005713C,0x270241AA,0xBE0B1010,0xC90C2086,0x5768B525,0x206F85B3,0xB966D409,0xCE61E49F,0x5EDEF90E,0x29D9C998,0xB0D09822,0xC7D7A8B4,0x59B33D17,0x2EB40D81,0xB7BD5C3B,0xC0BA6CAD,
-    0xEDB88320,0x9ABFB3B6,0x03B6E20C,0x74B1D29A,0xEAD54739,0x9DD277AF,0x04DB2615,0x73DC1683,0xE3630B12,0x94643B84,0x0D6D6A3E,0x7A6A5AA8,0xE40ECF0B,0x9309FF9D,0x0A00AE27,0x7D079EB1,
-    0xF00F9344,0x8708A3D2,0x1E01F268,0x6906C2FE,0xF762575D,0x806567CB,0x196C3671,0x6E6B06E7,0xFED41B76,0x89D32BE0,0x10DA7A5A,0x67DD4ACC,0xF9B9DF6F,0x8EBEEFF9,0x17B7BE43,0x60B08ED5,
-    0xD6D6A3E8,0xA1D1937E,0x38D8C2C4,0x4FDFF252,0xD1BB67F1,0xA6BC5767,0x3FB506DD,0x48B2364B,0xD80D2BDA,0xAF0A1B4C,0x36034AF6,0x41047A60,0xDF60EFC3,0xA867DF55,0x316E8EEF,0x4669BE79,
-    0xCB61B38C,0xBC66831A,0x256FD2A0,0x5268E236,0xCC0C7795,0xBB0B4703,0x220216B9,0x5505262F,0xC5BA3BBE,0xB2BD0B28,0x2BB45A92,0x5CB36A04,0xC2D7FFA7,0xB5D0CF31,0x2CD99E8B,0x5BDEAE1D,
-    0x9B64C2B0,0xEC63F226,0x756AA39C,0x026D930A,0x9C0906A9,0xEB0E363F,0x72076785,0x05005713,0x95BF4A82,0xE2B87A14,0x7BB12BAE,0x0CB61B38,0x92D28E9B,0xE5D5BE0D,0x7CDCEFB7,0x0BDBDF21,
-    0x86D3D2D4,0xF1D4E242,0x68DDB3F8,0x1FDA836E,0x81BE16CD,0xF6B9265B,0x6FB077E1,0x18B74777,0x88085AE6,0xFF0F6A70,0x66063BCA,0x11010B5C,0x8F659EFF,0xF862AE69,0x616BFFD3,0x166CCF45,
-    0xA00AE278,0xD70DD2EE,0x4E048354,0x3903B3C2,0xA7672661,0xD06016F7,0x4969474D,0x3E6E77DB,0xAED16A4A,0xD9D65ADC,0x40DF0B66,0x37D83BF0,0xA9BCAE53,0xDEBB9EC5,0x47B2CF7F,0x30B5FFE9,
-    0xBDBDF21C,0xCABAC28A,0x53B39330,0x24B4A3A6,0xBAD03605,0xCDD70693,0x54DE5729,0x23D967BF,0xB3667A2E,0xC4614AB8,0x5D681B02,0x2A6F2B94,0xB40BBE37,0xC30C8EA1,0x5A05DF1B,0x2D02EF8D,
+// (CrossPlatformGUI addition) CRC32 for ImHashData()/ImHashStr(), 8 bytes per step.
+// - By default the values are the CRC-32 (IEEE) of stock Dear ImGui, so IDs and .ini files are unchanged: ARMv8 computes it with its CRC32
+//   instructions, other CPUs with slicing-by-8 tables (eight 1KB tables, one lookup per input byte but no dependency between them).
+// - IMGUI_HASH_CRC32C hashes with CRC-32C (Castagnoli) instead, which x86 SSE4.2 and ARMv8 compute in hardware; CPUs without it use the
+//   same tables for that polynomial, so IDs stay identical on every machine. Every ID differs from stock, see imconfig.h.
+// The implementation is selected at first use (CPUID on x86; ARMv8 CRC32 is a compile-time feature). Tables are built in a function-local
+// static, so ImHashXXX functions remain thread-safe and usable by static constructors.
+#ifdef IMGUI_HASH_CRC32C
+static const ImU32 IM_CRC32_POLYNOMIAL = 0x82F63B78; // Castagnoli, reflected
+#else
+static const ImU32 IM_CRC32_POLYNOMIAL = 0xEDB88320; // IEEE 802.3, reflected
+#endif
+
+#if defined(IMGUI_HASH_CRC32C) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define IMGUI_CRC32_ENABLE_SSE42
+#include <nmmintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>     // __cpuid
+#else
+#include <cpuid.h>      // __get_cpuid
+#endif
+#elif defined(__ARM_FEATURE_CRC32) || (defined(_M_ARM64) && defined(_MSC_VER))
+#define IMGUI_CRC32_ENABLE_ARMV8
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <arm_acle.h>
+#endif
+#endif
+
+typedef ImU32 (*ImCrc32UpdateFunc)(ImU32 crc, const unsigned char* data, size_t data_size);
+
+struct ImCrc32Tables
+{
+    ImU32 Slices[8][256];
+
+    ImCrc32Tables()
+    {
+        for (ImU32 n = 0; n < 256; n++)
+        {
+            ImU32 crc = n;
+            for (int bit = 0; bit < 8; bit++)
+                crc = (crc >> 1) ^ (IM_CRC32_POLYNOMIAL & (0u - (crc & 1)));
+            Slices[0][n] = crc;
+        }
+        for (int slice = 1; slice < 8; slice++)
+            for (int n = 0; n < 256; n++)
+                Slices[slice][n] = (Slices[slice - 1][n] >> 8) ^ Slices[0][Slices[slice - 1][n] & 0xFF];
+    }
+};
+
+static ImU32 ImCrc32UpdateSoftware(ImU32 crc, const unsigned char* data, size_t data_size)
+{
+    static const ImCrc32Tables tables;
+    const ImU32 (*t)[256] = tables.Slices;
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        const ImU32 lo = crc ^ ((ImU32)data[0] | ((ImU32)data[1] << 8) | ((ImU32)data[2] << 16) | ((ImU32)data[3] << 24));
+        const ImU32 hi = (ImU32)data[4] | ((ImU32)data[5] << 8) | ((ImU32)data[6] << 16) | ((ImU32)data[7] << 24);
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+              t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+    }
+    while (data_size-- != 0)
+        crc = (crc >> 8) ^ t[0][(crc & 0xFF) ^ *data++];
+    return crc;
+}
+
+#ifdef IMGUI_CRC32_ENABLE_SSE42
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("sse4.2")))
+#endif
+static ImU32 ImCrc32UpdateSse42(ImU32 crc, const unsigned char* data, size_t data_size)
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        ImU64 word;
+        memcpy(&word, data, 8);
+        crc = (ImU32)_mm_crc32_u64(crc, word);
+    }
+#endif
+    for (; data_size >= 4; data += 4, data_size -= 4)
+    {
+        ImU32 word;
+        memcpy(&word, data, 4);
+        crc = _mm_crc32_u32(crc, word);
+    }
+    while (data_size-- != 0)
+        crc = _mm_crc32_u8(crc, *data++);
+    return crc;
+}
+
+static bool ImCrc32CpuHasSse42()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#else
+    unsigned int eax, ebx, ecx, edx;
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & (1u << 20)) != 0;
+#endif
+}
+#endif
+
+#ifdef IMGUI_CRC32_ENABLE_ARMV8
+static ImU32 ImCrc32UpdateArmv8(ImU32 crc, const unsigned char* data, size_t data_size)
+{
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        ImU64 word;
+        memcpy(&word, data, 8);
+#ifdef IMGUI_HASH_CRC32C
+        crc = __crc32cd(crc, word);
+#else
+        crc = __crc32d(crc, word);
+#endif
+    }
+    while (data_size-- != 0)
+#ifdef IMGUI_HASH_CRC32C
+        crc = __crc32cb(crc, *data++);
+#else
+        crc = __crc32b(crc, *data++);
+#endif
+    return crc;
+}
+#endif
+
+struct ImCrc32Implementation
+{
+    ImCrc32UpdateFunc   Update;
+    const char*         Name;
 };
 
+static ImCrc32Implementation ImCrc32SelectImplementation()
+{
+    ImCrc32Implementation impl;
+#if defined(IMGUI_CRC32_ENABLE_ARMV8)
+    impl.Update = ImCrc32UpdateArmv8;
+    impl.Name = IM_CRC32_POLYNOMIAL == 0xEDB88320 ? "crc32 (armv8)" : "crc32c (armv8)";
+    return impl;
+#else
+#ifdef IMGUI_CRC32_ENABLE_SSE42
+    if (ImCrc32CpuHasSse42())
+    {
+        impl.Update = ImCrc32UpdateSse42;
+        impl.Name = "crc32c (sse4.2)";
+        return impl;
+    }
+#endif
+    impl.Update = ImCrc32UpdateSoftware;
+    impl.Name = IM_CRC32_POLYNOMIAL == 0xEDB88320 ? "crc32 (slicing-by-8)" : "crc32c (slicing-by-8)";
+    return impl;
+#endif
+}
+
+static const ImCrc32Implementation& ImCrc32GetImplementation()
+{
+    static const ImCrc32Implementation impl = ImCrc32SelectImplementation();
+    return impl;
+}
+
+const char* ImHashGetImplementationName()
+{
+    return ImCrc32GetImplementation().Name;
+}
+
 // Known size hash
 // It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
 ImGuiID ImHashData(const void* data_p, size_t data_size, ImGuiID seed)
 {
-    ImU32 crc = ~seed;
-    const unsigned char* data = (const unsigned char*)data_p;
-    const ImU32* crc32_lut = GCrc32LookupTable;
-    while (data_size-- != 0)
-        crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
-    return ~crc;
+    return ~ImCrc32GetImplementation().Update(~seed, (const unsigned char*)data_p, data_size);
 }
 
 // Zero-terminated string hash, with support for ### to reset back to seed value
 // We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
-// Because this syntax is rarely used we are optimizing for the common case.
-// - If we reach ### in the string we discard the hash so far and reset to the seed.
-// - We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// - Reaching ### discards the hash so far and resets to the seed, so the result is the hash of the string from its last "###" on:
+//   that suffix is found first (memchr), then hashed in one call.
 ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
 {
-    seed = ~seed;
-    ImU32 crc = seed;
-    const unsigned char* data = (const unsigned char*)data_p;
-    const ImU32* crc32_lut = GCrc32LookupTable;
-    if (data_size != 0)
-    {
-        while (data_size-- != 0)
-        {
-            unsigned char c = *data++;
-            if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
-                crc = seed;
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-        }
-    }
-    else
-    {
-        while (unsigned char c = *data++)
-        {
-            if (c == '#' && data[0] == '#' && data[1] == '#')
-                crc = seed;
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-        }
-    }
-    return ~crc;
+    if (data_size == 0)
+        data_size = strlen(data_p);
+    const char* data_end = data_p + data_size;
+    const char* hash_begin = data_p;
+    for (const char* p = data_p; p < data_end && (p = (const char*)memchr(p, '#', (size_t)(data_end - p))) != NULL; p++)
+        if (data_end - p >= 3 && p[1] == '#' && p[2] == '#')
+            hash_begin = p;
+    return ~ImCrc32GetImplementation().Update(~seed, (const unsigned char*)hash_begin, (size_t)(data_end - hash_begin));
 }
 
 //-----------------------------------------------------------------------------
@@ -2355,6 +2569,8 @@ void ImGui::ColorConvertHSVtoRGB(float h, float s, float v, float& out_r, float&
 // Helper: Key->value storage
 //-----------------------------------------------------------------------------
 
+#ifndef IMGUI_STORAGE_OPEN_ADDRESSING
+
 // std::lower_bound but without the bullshit
 static ImGuiStorage::ImGuiStoragePair* LowerBound(ImVector<ImGuiStorage::ImGuiStoragePair>& data, ImGuiID key)
 {
@@ -2492,6 +2708,226 @@ void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
     it->val_p = val;
 }
 
+#else // #ifndef IMGUI_STORAGE_OPEN_ADDRESSING
+
+// (CrossPlatformGUI addition) Open-addressing backend, enabled by IMGUI_STORAGE_OPEN_ADDRESSING.
+// Pairs are appended to Data and found through a hash index (IndexCtrl/IndexSlots) whose slots are probed one 16-byte group of control
+// bytes at a time: a group is compared against the key's 7-bit tag in one SSE2 instruction, and a group with an empty slot ends the probe.
+// There is no removal, so there are no tombstones. Every modification keeps the index up to date, so the const Get***() functions only
+// read and may be called concurrently, as with the sorted backend.
+
+#if defined(IMGUI_ENABLE_SSE) && (defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define IMGUI_STORAGE_ENABLE_SSE2
+#endif
+
+static const int    STORAGE_GROUP_SIZE = 16;
+static const ImU8   STORAGE_CTRL_EMPTY = 0x80;
+
+// murmur3 finalizer: IDs are usually hashes already, but user keys may be small sequential integers
+static inline ImU32 StorageHash(ImGuiID key)
+{
+    key ^= key >> 16;
+    key *= 0x85EBCA6B;
+    key ^= key >> 13;
+    key *= 0xC2B2AE35;
+    key ^= key >> 16;
+    return key;
+}
+
+// Bit n is set when ctrl[n] == value
+static inline unsigned int StorageMatchGroup(const ImU8* ctrl, ImU8 value)
+{
+#ifdef IMGUI_STORAGE_ENABLE_SSE2
+    return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(const void*)ctrl), _mm_set1_epi8((char)value)));
+#else
+    unsigned int mask = 0;
+    for (int n = 0; n < STORAGE_GROUP_SIZE; n++)
+        mask |= (unsigned int)(ctrl[n] == value) << n;
+    return mask;
+#endif
+}
+
+static inline int StorageLowestBit(unsigned int mask)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long n;
+    _BitScanForward(&n, mask);
+    return (int)n;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// Smallest power of two number of slots keeping 'count' pairs at most 7/8 full
+static int StorageIndexCapacity(int count)
+{
+    int capacity = STORAGE_GROUP_SIZE;
+    while ((size_t)count * 8 > (size_t)capacity * 7)
+        capacity *= 2;
+    return capacity;
+}
+
+// First empty slot on the probe sequence of 'hash'
+static int StorageFindEmptySlot(const ImGuiStorage* storage, ImU32 hash)
+{
+    const int group_mask = storage->IndexCtrl.Size / STORAGE_GROUP_SIZE - 1;
+    for (int group = (int)(hash & (ImU32)group_mask);; group = (group + 1) & group_mask)
+        if (unsigned int empty = StorageMatchGroup(storage->IndexCtrl.Data + group * STORAGE_GROUP_SIZE, STORAGE_CTRL_EMPTY))
+            return group * STORAGE_GROUP_SIZE + StorageLowestBit(empty);
+}
+
+static void StorageRebuildIndex(ImGuiStorage* storage, int capacity)
+{
+    storage->IndexCtrl.resize(capacity);
+    storage->IndexSlots.resize(capacity);
+    memset(storage->IndexCtrl.Data, STORAGE_CTRL_EMPTY, (size_t)capacity);
+    for (int pos = 0; pos < storage->Data.Size; pos++)
+    {
+        const ImU32 hash = StorageHash(storage->Data.Data[pos].key);
+        const int slot = StorageFindEmptySlot(storage, hash);
+        storage->IndexCtrl.Data[slot] = (ImU8)(hash >> 25);
+        storage->IndexSlots.Data[slot] = pos;
+    }
+    storage->IndexedCount = storage->Data.Size;
+}
+
+// Position of 'key' in Data, or -1. Never modifies the storage.
+static int StorageFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    if (storage->Data.Size == 0)
+        return -1;
+    if (storage->IndexedCount != storage->Data.Size)
+    {
+        // Data was modified directly and BuildSortByKey() not called yet: the index is stale, scan the pairs instead
+        for (int pos = 0; pos < storage->Data.Size; pos++)
+            if (storage->Data.Data[pos].key == key)
+                return pos;
+        return -1;
+    }
+
+    const ImU32 hash = StorageHash(key);
+    const ImU8 tag = (ImU8)(hash >> 25);
+    const int group_mask = storage->IndexCtrl.Size / STORAGE_GROUP_SIZE - 1;
+    for (int group = (int)(hash & (ImU32)group_mask);; group = (group + 1) & group_mask)
+    {
+        const ImU8* ctrl = storage->IndexCtrl.Data + group * STORAGE_GROUP_SIZE;
+        for (unsigned int match = StorageMatchGroup(ctrl, tag); match != 0; match &= match - 1)
+        {
+            const int pos = storage->IndexSlots.Data[group * STORAGE_GROUP_SIZE + StorageLowestBit(match)];
+            if (storage->Data.Data[pos].key == key)
+                return pos;
+        }
+        if (StorageMatchGroup(ctrl, STORAGE_CTRL_EMPTY) != 0)
+            return -1;
+    }
+}
+
+static ImGuiStorage::ImGuiStoragePair* StorageFindOrInsert(ImGuiStorage* storage, const ImGuiStorage::ImGuiStoragePair& pair)
+{
+    if (storage->IndexedCount != storage->Data.Size)
+        StorageRebuildIndex(storage, StorageIndexCapacity(storage->Data.Size));
+    const int pos = StorageFind(storage, pair.key);
+    if (pos != -1)
+        return &storage->Data.Data[pos];
+
+    storage->Data.push_back(pair);
+    if ((size_t)storage->Data.Size * 8 > (size_t)storage->IndexCtrl.Size * 7)
+    {
+        StorageRebuildIndex(storage, StorageIndexCapacity(storage->Data.Size));
+    }
+    else
+    {
+        const ImU32 hash = StorageHash(pair.key);
+        const int slot = StorageFindEmptySlot(storage, hash);
+        storage->IndexCtrl.Data[slot] = (ImU8)(hash >> 25);
+        storage->IndexSlots.Data[slot] = storage->Data.Size - 1;
+        storage->IndexedCount = storage->Data.Size;
+    }
+    return &storage->Data.back();
+}
+
+// Sorting is not needed for lookups here, but keeps Data in the documented order for iteration
+void ImGuiStorage::BuildSortByKey()
+{
+    struct StaticFunc
+    {
+        static int IMGUI_CDECL PairComparerByID(const void* lhs, const void* rhs)
+        {
+            if (((const ImGuiStoragePair*)lhs)->key > ((const ImGuiStoragePair*)rhs)->key) return +1;
+            if (((const ImGuiStoragePair*)lhs)->key < ((const ImGuiStoragePair*)rhs)->key) return -1;
+            return 0;
+        }
+    };
+    ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), StaticFunc::PairComparerByID);
+    StorageRebuildIndex(this, StorageIndexCapacity(Data.Size));
+}
+
+int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
+{
+    const int pos = StorageFind(this, key);
+    return (pos != -1) ? Data.Data[pos].val_i : default_val;
+}
+
+bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
+{
+    return GetInt(key, default_val ? 1 : 0) != 0;
+}
+
+float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
+{
+    const int pos = StorageFind(this, key);
+    return (pos != -1) ? Data.Data[pos].val_f : default_val;
+}
+
+void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
+{
+    const int pos = StorageFind(this, key);
+    return (pos != -1) ? Data.Data[pos].val_p : NULL;
+}
+
+// References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
+int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
+{
+    return &StorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_i;
+}
+
+bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
+{
+    return (bool*)GetIntRef(key, default_val ? 1 : 0);
+}
+
+float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
+{
+    return &StorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_f;
+}
+
+void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
+{
+    return &StorageFindOrInsert(this, ImGuiStoragePair(key, default_val))->val_p;
+}
+
+void ImGuiStorage::SetInt(ImGuiID key, int val)
+{
+    StorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_i = val;
+}
+
+void ImGuiStorage::SetBool(ImGuiID key, bool val)
+{
+    SetInt(key, val ? 1 : 0);
+}
+
+void ImGuiStorage::SetFloat(ImGuiID key, float val)
+{
+    StorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_f = val;
+}
+
+void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
+{
+    StorageFindOrInsert(this, ImGuiStoragePair(key, val))->val_p = val;
+}
+
+#endif // #ifndef IMGUI_STORAGE_OPEN_ADDRESSING
+
 void ImGuiStorage::SetAllInt(int v)
 {
     for (int i = 0; i < Data.Size; i++)
@@ -2549,6 +2985,7 @@ void ImGuiTextFilter::Build()
     input_range.split(',', &Filters);
 
     CountGrep = 0;
+    Needles.resize(0);
     for (int i = 0; i != Filters.Size; i++)
     {
         ImGuiTextRange& f = Filters[i];
@@ -2560,6 +2997,12 @@ void ImGuiTextFilter::Build()
             continue;
         if (Filters[i].b[0] != '-')
             CountGrep += 1;
+
+        // (CrossPlatformGUI addition) Prepare the needles once here rather than per PassFilter() call
+        ImStristrNeedle needle;
+        needle.Subtract = f.b[0] == '-';
+        ImStristrPrepare(&needle, needle.Subtract ? f.b + 1 : f.b, f.e);
+        Needles.push_back(needle);
     }
 }
 
@@ -2570,22 +3013,23 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
 
     if (text == NULL)
         text = "";
+    if (text_end == NULL)
+        text_end = text + strlen(text);
 
-    for (int i = 0; i != Filters.Size; i++)
+    // (CrossPlatformGUI addition) Needles prepared by Build() are searched for with ImStristrPrepared()
+    for (int i = 0; i != Needles.Size; i++)
     {
-        const ImGuiTextRange& f = Filters[i];
-        if (f.empty())
-            continue;
-        if (f.b[0] == '-')
+        const ImStristrNeedle& needle = Needles[i];
+        if (needle.Subtract)
         {
             // Subtract
-            if (ImStristr(text, text_end, f.b + 1, f.e) != NULL)
+            if (ImStristrPrepared(text, text_end, needle) != NULL)
                 return false;
         }
         else
         {
             // Grep
-            if (ImStristr(text, text_end, f.b, f.e) != NULL)
+            if (ImStristrPrepared(text, text_end, needle) != NULL)
                 return true;
         }
     }
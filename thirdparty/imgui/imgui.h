@@ -163,6 +163,7 @@ struct ImGuiTableSortSpecs;         // Sorting specifications for a table (often
 struct ImGuiTableColumnSortSpecs;   // Sorting specification for one column of a table
 struct ImGuiTextBuffer;             // Helper to hold and append into a text buffer (~string builder)
 struct ImGuiTextFilter;             // Helper to parse and apply text filters (e.g. "aaaaa[,bbbbb][,ccccc]")
+struct ImStristrNeedle;             // (CrossPlatformGUI addition) Prepared case-insensitive substring search, used by ImGuiTextFilter
 struct ImGuiViewport;               // A Platform Window (always 1 unless multi-viewport are enabled. One per platform window to output to). In the future may represent Platform Monitor
 struct ImGuiWindowClass;            // Window class (rare/advanced uses: provide hints to the platform backend via altered viewport flags and parent/child info)
 
@@ -2315,6 +2316,22 @@ struct ImGuiOnceUponAFrame
     operator bool() const { int current_frame = ImGui::GetFrameCount(); if (RefFrame == current_frame) return false; RefFrame = current_frame; return true; }
 };
 
+// (CrossPlatformGUI addition) Needle of a case-insensitive substring search, prepared once by ImStristrPrepare() and searched
+// for with ImStristrPrepared() (imgui_internal.h). Haystack bytes are OR-ed with the fold bits before being compared with the
+// lowercase first/last bytes: 0x20 for ASCII letters, 0 otherwise, which matches ImToUpper()'s notion of case.
+struct ImStristrNeedle
+{
+    const char*     b;              // Needle text, not owned
+    const char*     e;
+    unsigned char   FirstFold;
+    unsigned char   FirstLower;
+    unsigned char   LastFold;
+    unsigned char   LastLower;
+    bool            Subtract;       // ImGuiTextFilter: "-xxx" term
+
+    ImStristrNeedle()               { b = e = NULL; FirstFold = FirstLower = LastFold = LastLower = 0; Subtract = false; }
+};
+
 // Helper: Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
 struct ImGuiTextFilter
 {
@@ -2339,6 +2356,7 @@ struct ImGuiTextFilter
     char                    InputBuf[256];
     ImVector<ImGuiTextRange>Filters;
     int                     CountGrep;
+    ImVector<ImStristrNeedle>Needles;   // (CrossPlatformGUI addition) Non-empty Filters[] prepared by Build(), in order
 };
 
 // Helper: Growable text buffer for logging/accumulating text
@@ -2384,10 +2402,30 @@ struct ImGuiStorage
 
     ImVector<ImGuiStoragePair>      Data;
 
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    // (CrossPlatformGUI addition) Open-addressing index over Data, see IMGUI_STORAGE_OPEN_ADDRESSING in imconfig.h.
+    // Data stays a dense array of pairs in insertion order (so iterating it still works); each index slot holds a position in Data
+    // and is tagged by a control byte (0x80 = empty, else 7 bits of the key hash) probed 16 at a time.
+    // Set***(), Get***Ref(), BuildSortByKey() and Clear() keep the index up to date, so the const Get***() functions never write and
+    // concurrent const reads of one storage stay safe. Data may still be modified directly as long as BuildSortByKey() is called
+    // afterwards (until then lookups scan Data linearly).
+    ImVector<ImU8>                  IndexCtrl;
+    ImVector<int>                   IndexSlots;
+    int                             IndexedCount;
+
+    ImGuiStorage()      { IndexedCount = 0; }
+#endif
+
+#ifdef IMGUI_STORAGE_OPEN_ADDRESSING
+    // - Get***() functions find pair, never add/allocate. Pairs are found through the hash index so a query is O(1) (CrossPlatformGUI addition)
+    // - Set***() functions find pair, insertion on demand if missing. Insertion appends to Data, which is in insertion order until BuildSortByKey().
+    void                Clear() { Data.clear(); IndexCtrl.clear(); IndexSlots.clear(); IndexedCount = 0; }
+#else
     // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
     void                Clear() { Data.clear(); }
+#endif
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -3039,6 +3077,17 @@ struct ImFont
     int                         MetricsTotalSurface;// 4     // out //            // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
     ImU8                        Used4kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/4096/8]; // 2 bytes if ImWchar=ImWchar16, 34 bytes if ImWchar==ImWchar32. Store 1-bit for each block of 4K codepoints that has one active glyph. This is mainly used to facilitate iterations across all used codepoints.
 
+    // Members: Dynamic glyphs (CrossPlatformGUI addition, driven by include/DynamicGlyphCache.h)
+    void                        (*GlyphMissHandler)(void* user_data, const ImFont* font, ImWchar c); // NULL = off // Called by FindGlyph() for code-points without a glyph, before returning FallbackGlyph.
+    void*                       GlyphMissUserData;  //       // in  //
+    int                         GlyphTrackedBegin;  // 4     // in  // = INT_MAX  // Glyphs[] at this index and above write GlyphTrackedFrame into GlyphTrackedLastUse[index - GlyphTrackedBegin] when FindGlyph() returns them.
+    int                         GlyphTrackedFrame;  // 4     // in  //
+    mutable ImVector<int>       GlyphTrackedLastUse;//       // in  //
+
+    // Members: Text size cache (CrossPlatformGUI addition, driven by include/TextSizeCache.h)
+    ImVec2                      (*CalcTextSizeHandler)(void* user_data, const ImFont* font, float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining); // NULL = off // Answers CalcTextSizeA(); CalcTextSizeUncachedA() is the measuring code.
+    void*                       CalcTextSizeUserData;
+
     // Methods
     IMGUI_API ImFont();
     IMGUI_API ~ImFont();
@@ -3051,6 +3100,7 @@ struct ImFont
     // 'max_width' stops rendering after a certain width (could be turned into a 2d size). FLT_MAX to disable.
     // 'wrap_width' enable automatic word-wrapping across multiple lines to fit into given width. 0.0f to disable.
     IMGUI_API ImVec2            CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end = NULL, const char** remaining = NULL) const; // utf8
+    IMGUI_API ImVec2            CalcTextSizeUncachedA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end = NULL, const char** remaining = NULL) const; // utf8
     IMGUI_API const char*       CalcWordWrapPositionA(float scale, const char* text, const char* text_end, float wrap_width) const;
     IMGUI_API void              RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, ImWchar c) const;
     IMGUI_API void              RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width = 0.0f, bool cpu_fine_clip = false) const;
@@ -3135,6 +3135,12 @@ ImFont::ImFont()
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
+    GlyphMissHandler = NULL;
+    GlyphMissUserData = NULL;
+    GlyphTrackedBegin = INT_MAX;
+    GlyphTrackedFrame = 0;
+    CalcTextSizeHandler = NULL;
+    CalcTextSizeUserData = NULL;
 }
 
 ImFont::~ImFont()
@@ -3340,11 +3346,15 @@ void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
 {
-    if (c >= (size_t)IndexLookup.Size)
-        return FallbackGlyph;
-    const ImWchar i = IndexLookup.Data[c];
+    const ImWchar i = (c < (size_t)IndexLookup.Size) ? IndexLookup.Data[c] : (ImWchar)-1;
     if (i == (ImWchar)-1)
+    {
+        if (GlyphMissHandler != NULL)
+            GlyphMissHandler(GlyphMissUserData, this, c);
         return FallbackGlyph;
+    }
+    if ((int)i >= GlyphTrackedBegin)
+        GlyphTrackedLastUse.Data[i - GlyphTrackedBegin] = GlyphTrackedFrame;
     return &Glyphs.Data[i];
 }
 
@@ -3470,6 +3480,13 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
 }
 
 ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining) const
+{
+    if (CalcTextSizeHandler != NULL)
+        return CalcTextSizeHandler(CalcTextSizeUserData, this, size, max_width, wrap_width, text_begin, text_end, remaining);
+    return CalcTextSizeUncachedA(size, max_width, wrap_width, text_begin, text_end, remaining);
+}
+
+ImVec2 ImFont::CalcTextSizeUncachedA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining) const
 {
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // FIXME-OPT: Need to avoid this.
@@ -339,6 +339,7 @@ namespace ImStb
 // Helpers: Hashing
 IMGUI_API ImGuiID       ImHashData(const void* data, size_t data_size, ImGuiID seed = 0);
 IMGUI_API ImGuiID       ImHashStr(const char* data, size_t data_size = 0, ImGuiID seed = 0);
+IMGUI_API const char*   ImHashGetImplementationName();  // (CrossPlatformGUI addition) CRC32 variant and instructions used by ImHashData()/ImHashStr()
 
 // Helpers: Sorting
 #ifndef ImQsort
@@ -364,6 +365,8 @@ IMGUI_API int           ImStrlenW(const ImWchar* str);
 IMGUI_API const char*   ImStreolRange(const char* str, const char* str_end);                // End end-of-line
 IMGUI_API const ImWchar*ImStrbolW(const ImWchar* buf_mid_line, const ImWchar* buf_begin);   // Find beginning-of-line
 IMGUI_API const char*   ImStristr(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end);
+IMGUI_API void          ImStristrPrepare(ImStristrNeedle* out_needle, const char* needle, const char* needle_end);          // (CrossPlatformGUI addition)
+IMGUI_API const char*   ImStristrPrepared(const char* haystack, const char* haystack_end, const ImStristrNeedle& needle); // (CrossPlatformGUI addition) ImStristr() scanning 16 bytes at a time, never reading past haystack_end
 IMGUI_API void          ImStrTrimBlanks(char* str);
 IMGUI_API const char*   ImStrSkipBlank(const char* str);
 IM_MSVC_RUNTIME_CHECKS_OFF